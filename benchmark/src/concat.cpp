@@ -78,3 +78,137 @@ void std_reserve_concat(benchmark::State &state)
 }
 
 BENCHMARK(std_reserve_concat);
+
+void rs_arena_concat(benchmark::State &state)
+{
+	rs_arena a;
+	rs_arena_init(&a, concat_size * count * RS_GROWTH_FACTOR * 2);
+
+	for (auto _ : state) {
+		rapidstring s;
+		rs_init_w_alloc(&s, rs_arena_alloc(&a));
+
+		/*
+		 * The string is always the last buffer handed out by the arena,
+		 * therefore it grows in place without any copies.
+		 */
+		for (size_t i = 0; i < count; i++)
+			rs_cat_n(&s, concat_str, concat_size);
+
+		benchmark::DoNotOptimize(s);
+		rs_arena_reset(&a);
+	}
+
+	rs_arena_free(&a);
+}
+
+BENCHMARK(rs_arena_concat);
+
+void rs_rope_concat(benchmark::State &state)
+{
+	for (auto _ : state) {
+		rs_rope r;
+		rs_rope_init(&r);
+
+		for (size_t i = 0; i < count; i++)
+			rs_rope_cat_n(&r, concat_str, concat_size);
+
+		benchmark::DoNotOptimize(r);
+		rs_rope_free(&r);
+	}
+}
+
+BENCHMARK(rs_rope_concat);
+
+void rs_gather_concat(benchmark::State &state)
+{
+	rs_view pieces[count];
+
+	for (size_t i = 0; i < count; i++)
+		pieces[i] = rs_view_n(concat_str, concat_size);
+
+	for (auto _ : state) {
+		rapidstring s;
+		rs_init_w_many(&s, pieces, count);
+
+		benchmark::DoNotOptimize(s);
+		rs_free(&s);
+	}
+}
+
+BENCHMARK(rs_gather_concat);
+
+void rs_join_path(benchmark::State &state)
+{
+	const rs_view pieces[]{ rs_view_n("var", 3), rs_view_n("lib", 3),
+				rs_view_n("rapidstring", 11),
+				rs_view_n("cache", 5),
+				rs_view_n("index.dat", 9) };
+
+	for (auto _ : state) {
+		rapidstring s;
+		rs_init(&s);
+
+		rs_join(&s, pieces, 5, "/");
+
+		benchmark::DoNotOptimize(s);
+		rs_free(&s);
+	}
+}
+
+BENCHMARK(rs_join_path);
+
+void rs_cat_path(benchmark::State &state)
+{
+	const rs_view pieces[]{ rs_view_n("var", 3), rs_view_n("lib", 3),
+				rs_view_n("rapidstring", 11),
+				rs_view_n("cache", 5),
+				rs_view_n("index.dat", 9) };
+
+	for (auto _ : state) {
+		rapidstring s;
+		rs_init(&s);
+
+		for (std::size_t i = 0; i < 5; i++) {
+			if (i != 0)
+				rs_cat_n(&s, "/", 1);
+
+			rs_cat_v(&s, pieces[i]);
+		}
+
+		benchmark::DoNotOptimize(s);
+		rs_free(&s);
+	}
+}
+
+BENCHMARK(rs_cat_path);
+
+void rs_insert_front(benchmark::State &state)
+{
+	for (auto _ : state) {
+		rapidstring s;
+		rs_init(&s);
+
+		for (size_t i = 0; i < count; i++)
+			rs_insert_n(&s, 0, concat_str, concat_size);
+
+		benchmark::DoNotOptimize(s);
+		rs_free(&s);
+	}
+}
+
+BENCHMARK(rs_insert_front);
+
+void std_insert_front(benchmark::State &state)
+{
+	for (auto _ : state) {
+		std::string s;
+
+		for (size_t i = 0; i < count; i++)
+			s.insert(0, concat_str, concat_size);
+
+		benchmark::DoNotOptimize(s);
+	}
+}
+
+BENCHMARK(std_insert_front);
@@ -0,0 +1,80 @@
+#include "rapidstring.h"
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <string>
+
+constexpr std::size_t doc_size{ 256 * 1024 };
+constexpr std::size_t edits{ 1000 };
+constexpr const char edit_str[]{ "typed" };
+constexpr std::size_t edit_size{ sizeof(edit_str) - 1 };
+
+/*
+ * Types and deletes around a cursor which slowly moves forward through a
+ * large document, as an editor would.
+ */
+
+void rs_edit_gap(benchmark::State &state)
+{
+	const std::string doc(doc_size, 'x');
+
+	for (auto _ : state) {
+		rs_gap g;
+		rs_gap_init_w_n(&g, doc.data(), doc.size());
+
+		for (std::size_t i = 0; i < edits; i++) {
+			rs_gap_move(&g, doc_size / 2 + i);
+			rs_gap_insert_n(&g, edit_str, edit_size);
+			rs_gap_erase_before(&g, edit_size - 1);
+		}
+
+		benchmark::DoNotOptimize(g);
+		rs_gap_free(&g);
+	}
+}
+
+BENCHMARK(rs_edit_gap);
+
+void rs_edit_string(benchmark::State &state)
+{
+	const std::string doc(doc_size, 'x');
+
+	for (auto _ : state) {
+		rapidstring s;
+		rs_init_w_n(&s, doc.data(), doc.size());
+
+		for (std::size_t i = 0; i < edits; i++) {
+			const std::size_t cursor = doc_size / 2 + i;
+
+			rs_insert_n(&s, cursor, edit_str, edit_size);
+			rs_erase(&s, cursor, edit_size - 1);
+		}
+
+		benchmark::DoNotOptimize(s);
+		rs_free(&s);
+	}
+}
+
+BENCHMARK(rs_edit_string);
+
+void rs_edit_rope(benchmark::State &state)
+{
+	const std::string doc(doc_size, 'x');
+
+	for (auto _ : state) {
+		rs_rope r;
+		rs_rope_init(&r);
+		rs_rope_cat_n(&r, doc.data(), doc.size());
+
+		for (std::size_t i = 0; i < edits; i++) {
+			const std::size_t cursor = doc_size / 2 + i;
+
+			rs_rope_insert_n(&r, cursor, edit_str, edit_size);
+			rs_rope_erase(&r, cursor, edit_size - 1);
+		}
+
+		benchmark::DoNotOptimize(r);
+		rs_rope_free(&r);
+	}
+}
+
+BENCHMARK(rs_edit_rope);
@@ -0,0 +1,88 @@
+#include "rapidstring.h"
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <string>
+
+static std::string binary(std::size_t n)
+{
+	std::string str;
+
+	for (std::size_t i = 0; i < n; i++)
+		str.push_back(static_cast<char>(i * 73 + 29));
+
+	return str;
+}
+
+static const std::string blob{ binary(1024) };
+
+void rs_base64_encode(benchmark::State &state)
+{
+	for (auto _ : state) {
+		rapidstring s;
+		rs_init(&s);
+
+		rs_cat_base64_n(&s, blob.data(), blob.size());
+
+		benchmark::DoNotOptimize(s);
+		rs_free(&s);
+	}
+}
+
+BENCHMARK(rs_base64_encode);
+
+void rs_base64_decode(benchmark::State &state)
+{
+	rapidstring encoded;
+	rs_init(&encoded);
+	rs_cat_base64_n(&encoded, blob.data(), blob.size());
+
+	for (auto _ : state) {
+		rapidstring s;
+		rs_init(&s);
+
+		rs_decode_base64_n(&s, rs_data_c(&encoded), rs_len(&encoded));
+
+		benchmark::DoNotOptimize(s);
+		rs_free(&s);
+	}
+
+	rs_free(&encoded);
+}
+
+BENCHMARK(rs_base64_decode);
+
+void rs_hex_encode(benchmark::State &state)
+{
+	for (auto _ : state) {
+		rapidstring s;
+		rs_init(&s);
+
+		rs_cat_hex_n(&s, blob.data(), blob.size());
+
+		benchmark::DoNotOptimize(s);
+		rs_free(&s);
+	}
+}
+
+BENCHMARK(rs_hex_encode);
+
+void rs_hex_decode(benchmark::State &state)
+{
+	rapidstring encoded;
+	rs_init(&encoded);
+	rs_cat_hex_n(&encoded, blob.data(), blob.size());
+
+	for (auto _ : state) {
+		rapidstring s;
+		rs_init(&s);
+
+		rs_decode_hex_n(&s, rs_data_c(&encoded), rs_len(&encoded));
+
+		benchmark::DoNotOptimize(s);
+		rs_free(&s);
+	}
+
+	rs_free(&encoded);
+}
+
+BENCHMARK(rs_hex_decode);
@@ -0,0 +1,103 @@
+#include "rapidstring.h"
+#include <benchmark/benchmark.h>
+#include <functional>
+#include <string>
+
+constexpr const char short_str[]{ "session_id" };
+constexpr const char long_str[]{
+	"Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do "
+	"eiusmod tempor incididunt ut labore et dolore magna aliqua."
+};
+
+void rs_hash_stack(benchmark::State &state)
+{
+	rapidstring s;
+	rs_init_w(&s, short_str);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(rs_hash(&s));
+
+	rs_free(&s);
+}
+
+BENCHMARK(rs_hash_stack);
+
+void std_hash_stack(benchmark::State &state)
+{
+	const std::string s{ short_str };
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(std::hash<std::string>{}(s));
+}
+
+BENCHMARK(std_hash_stack);
+
+void rs_hash_heap(benchmark::State &state)
+{
+	rapidstring s;
+	rs_init_w(&s, long_str);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(rs_hash(&s));
+
+	rs_free(&s);
+}
+
+BENCHMARK(rs_hash_heap);
+
+void std_hash_heap(benchmark::State &state)
+{
+	const std::string s{ long_str };
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(std::hash<std::string>{}(s));
+}
+
+BENCHMARK(std_hash_heap);
+
+constexpr const char header_str[]{ "Content-Type" };
+
+void rs_hash_icase(benchmark::State &state)
+{
+	rapidstring s;
+	rs_init_w(&s, header_str);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(rs_hash_icase(&s));
+
+	rs_free(&s);
+}
+
+BENCHMARK(rs_hash_icase);
+
+void rs_hash_lowered(benchmark::State &state)
+{
+	rapidstring s;
+	rs_init_w(&s, header_str);
+
+	for (auto _ : state) {
+		rapidstring lowered;
+		rs_init_w_rs(&lowered, &s);
+		rs_to_lower(&lowered);
+
+		benchmark::DoNotOptimize(rs_hash(&lowered));
+		rs_free(&lowered);
+	}
+
+	rs_free(&s);
+}
+
+BENCHMARK(rs_hash_lowered);
+
+void rs_hash_icase_heap(benchmark::State &state)
+{
+	rapidstring s;
+	rs_init_w(&s, long_str);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(rs_hash_icase(&s));
+
+	rs_free(&s);
+}
+
+BENCHMARK(rs_hash_icase_heap);
@@ -0,0 +1,146 @@
+#include "rapidstring.h"
+#include <benchmark/benchmark.h>
+#include <cinttypes>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+constexpr std::size_t count{ 100 };
+constexpr std::uint64_t integer{ 1510000000 };
+constexpr double real{ 0.1 + 0.2 };
+constexpr const char integer_str[]{ "1510000000" };
+constexpr const char real_str[]{ "-1234.5678" };
+
+void rs_cat_integer(benchmark::State &state)
+{
+	for (auto _ : state) {
+		rapidstring s;
+		rs_init(&s);
+
+		for (std::size_t i = 0; i < count; i++)
+			rs_cat_u64(&s, integer + i);
+
+		benchmark::DoNotOptimize(s);
+		rs_free(&s);
+	}
+}
+
+BENCHMARK(rs_cat_integer);
+
+void snprintf_integer(benchmark::State &state)
+{
+	for (auto _ : state) {
+		rapidstring s;
+		rs_init(&s);
+
+		for (std::size_t i = 0; i < count; i++) {
+			char buffer[32];
+			const int n = std::snprintf(buffer, sizeof(buffer),
+						    "%" PRIu64, integer + i);
+			rs_cat_n(&s, buffer, static_cast<std::size_t>(n));
+		}
+
+		benchmark::DoNotOptimize(s);
+		rs_free(&s);
+	}
+}
+
+BENCHMARK(snprintf_integer);
+
+void std_to_string_integer(benchmark::State &state)
+{
+	for (auto _ : state) {
+		std::string s;
+
+		for (std::size_t i = 0; i < count; i++)
+			s += std::to_string(integer + i);
+
+		benchmark::DoNotOptimize(s);
+	}
+}
+
+BENCHMARK(std_to_string_integer);
+
+void rs_cat_real(benchmark::State &state)
+{
+	for (auto _ : state) {
+		rapidstring s;
+		rs_init(&s);
+
+		for (std::size_t i = 0; i < count; i++)
+			rs_cat_double(&s, real * static_cast<double>(i));
+
+		benchmark::DoNotOptimize(s);
+		rs_free(&s);
+	}
+}
+
+BENCHMARK(rs_cat_real);
+
+void snprintf_real(benchmark::State &state)
+{
+	for (auto _ : state) {
+		rapidstring s;
+		rs_init(&s);
+
+		/* Seventeen digits are required to round trip with printf(). */
+		for (std::size_t i = 0; i < count; i++) {
+			char buffer[32];
+			const int n = std::snprintf(buffer, sizeof(buffer),
+						    "%.17g",
+						    real * static_cast<double>(i));
+			rs_cat_n(&s, buffer, static_cast<std::size_t>(n));
+		}
+
+		benchmark::DoNotOptimize(s);
+		rs_free(&s);
+	}
+}
+
+BENCHMARK(snprintf_real);
+
+void rs_to_integer(benchmark::State &state)
+{
+	for (auto _ : state) {
+		const char *input{ integer_str };
+		benchmark::DoNotOptimize(input);
+
+		std::uint64_t n{};
+		rs_to_u64_n(input, sizeof(integer_str) - 1, &n);
+		benchmark::DoNotOptimize(n);
+	}
+}
+
+BENCHMARK(rs_to_integer);
+
+void strtoull_integer(benchmark::State &state)
+{
+	for (auto _ : state)
+		benchmark::DoNotOptimize(std::strtoull(integer_str, nullptr, 10));
+}
+
+BENCHMARK(strtoull_integer);
+
+void rs_to_real(benchmark::State &state)
+{
+	for (auto _ : state) {
+		const char *input{ real_str };
+		benchmark::DoNotOptimize(input);
+
+		double n{};
+		rs_to_double_n(input, sizeof(real_str) - 1, &n);
+		benchmark::DoNotOptimize(n);
+	}
+}
+
+BENCHMARK(rs_to_real);
+
+void strtod_real(benchmark::State &state)
+{
+	for (auto _ : state)
+		benchmark::DoNotOptimize(std::strtod(real_str, nullptr));
+}
+
+BENCHMARK(strtod_real);
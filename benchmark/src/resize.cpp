@@ -28,3 +28,54 @@ void std_resize(benchmark::State &state)
 }
 
 BENCHMARK(std_resize);
+
+static std::string alternate(std::size_t n)
+{
+	std::string str;
+
+	for (std::size_t i = 0; i < n; i++)
+		str.push_back(i % 2 == 0 ? 'a' : 'b');
+
+	return str;
+}
+
+static const std::string alternate_str{ alternate(4096) };
+
+/* Consumes a string from its start, one character at a time. */
+void rs_ltrim_consume(benchmark::State &state)
+{
+	rapidstring s;
+	rs_init(&s);
+
+	for (auto _ : state) {
+		rs_cpy_n(&s, alternate_str.data(), alternate_str.size());
+
+		while (!rs_empty(&s))
+			rs_ltrim_n(&s, rs_data_c(&s), 1);
+
+		benchmark::DoNotOptimize(s);
+	}
+
+	rs_free(&s);
+}
+
+BENCHMARK(rs_ltrim_consume);
+
+void rs_erase_consume(benchmark::State &state)
+{
+	rapidstring s;
+	rs_init(&s);
+
+	for (auto _ : state) {
+		rs_cpy_n(&s, alternate_str.data(), alternate_str.size());
+
+		while (!rs_empty(&s))
+			rs_erase(&s, 0, 1);
+
+		benchmark::DoNotOptimize(s);
+	}
+
+	rs_free(&s);
+}
+
+BENCHMARK(rs_erase_consume);
@@ -0,0 +1,125 @@
+#include "rapidstring.h"
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <string>
+
+constexpr const char search_str[]{
+	"GET /index.html HTTP/1.1\r\nHost: example.com\r\nUser-Agent: "
+	"rapidstring\r\nAccept: text/html\r\nConnection: keep-alive\r\n\r\n"
+};
+constexpr const char short_str[]{ "Content-Type: text/plain" };
+
+void rs_find_heap(benchmark::State &state)
+{
+	rapidstring s;
+	rs_init_w(&s, search_str);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(rs_find_n(&s, "\r\n\r\n", 4));
+
+	rs_free(&s);
+}
+
+BENCHMARK(rs_find_heap);
+
+void std_find_heap(benchmark::State &state)
+{
+	const std::string s{ search_str };
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(s.find("\r\n\r\n", 0, 4));
+}
+
+BENCHMARK(std_find_heap);
+
+void rs_find_char_stack(benchmark::State &state)
+{
+	rapidstring s;
+	rs_init_w(&s, short_str);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(rs_find_char(&s, ':'));
+}
+
+BENCHMARK(rs_find_char_stack);
+
+void std_find_char_stack(benchmark::State &state)
+{
+	const std::string s{ short_str };
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(s.find(':'));
+}
+
+BENCHMARK(std_find_char_stack);
+
+void rs_split_fields(benchmark::State &state)
+{
+	rapidstring s;
+	rs_init(&s);
+
+	for (std::size_t i = 0; i < 1000; i++)
+		rs_cat(&s, "2018-04-01,GET,/index.html,200,1534;");
+
+	for (auto _ : state) {
+		rs_split_iter it;
+		rs_view field;
+		std::size_t n = 0;
+
+		rs_split_init_any(&it, &s, ",;");
+
+		while (rs_split_next(&it, &field))
+			n += field.size;
+
+		benchmark::DoNotOptimize(n);
+	}
+
+	rs_free(&s);
+}
+
+BENCHMARK(rs_split_fields);
+
+void rs_replace_template(benchmark::State &state)
+{
+	rapidstring tmpl;
+	rs_init(&tmpl);
+
+	for (std::size_t i = 0; i < 100; i++)
+		rs_cat(&tmpl, "<p>Hello {{name}}, welcome back.</p>\n");
+
+	for (auto _ : state) {
+		rapidstring s;
+		rs_init_w_rs(&s, &tmpl);
+
+		rs_replace_all(&s, "{{name}}", "Marty McFly");
+
+		benchmark::DoNotOptimize(s);
+		rs_free(&s);
+	}
+
+	rs_free(&tmpl);
+}
+
+BENCHMARK(rs_replace_template);
+
+void std_replace_template(benchmark::State &state)
+{
+	std::string tmpl;
+
+	for (std::size_t i = 0; i < 100; i++)
+		tmpl += "<p>Hello {{name}}, welcome back.</p>\n";
+
+	for (auto _ : state) {
+		std::string s{ tmpl };
+		std::size_t pos = 0;
+
+		while ((pos = s.find("{{name}}", pos)) != std::string::npos) {
+			s.replace(pos, 8, "Marty McFly");
+			pos += 11;
+		}
+
+		benchmark::DoNotOptimize(s);
+	}
+}
+
+BENCHMARK(std_replace_template);
@@ -0,0 +1,107 @@
+#define RS_PARALLEL
+#include "rapidstring.h"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+constexpr std::size_t keys{ 100000 };
+constexpr std::size_t key_size{ 12 };
+
+static std::vector<std::string> random_keys()
+{
+	std::vector<std::string> v(keys, std::string(key_size, 'a'));
+
+	std::srand(1);
+
+	for (auto &key : v)
+		for (auto &c : key)
+			c = static_cast<char>('a' + std::rand() % 26);
+
+	return v;
+}
+
+static const std::vector<std::string> sort_keys{ random_keys() };
+
+static std::vector<rapidstring> random_strings()
+{
+	std::vector<rapidstring> v(keys);
+
+	for (std::size_t i = 0; i < keys; i++)
+		rs_init_w_n(&v[i], sort_keys[i].data(), sort_keys[i].size());
+
+	return v;
+}
+
+/*
+ * Sorting only moves the strings, so shallow copies of the same strings are
+ * sorted on each iteration and never freed.
+ */
+static const std::vector<rapidstring> sort_strings{ random_strings() };
+
+static int cmp_rs(const void *a, const void *b)
+{
+	return rs_cmp_rs(static_cast<const rapidstring *>(a),
+			 static_cast<const rapidstring *>(b));
+}
+
+void rs_sort(benchmark::State &state)
+{
+	std::vector<rapidstring> v(keys);
+
+	for (auto _ : state) {
+		std::memcpy(v.data(), sort_strings.data(),
+			    keys * sizeof(rapidstring));
+		rs_sort(v.data(), v.size());
+
+		benchmark::DoNotOptimize(v.data());
+	}
+}
+
+BENCHMARK(rs_sort);
+
+void rs_qsort(benchmark::State &state)
+{
+	std::vector<rapidstring> v(keys);
+
+	for (auto _ : state) {
+		std::memcpy(v.data(), sort_strings.data(),
+			    keys * sizeof(rapidstring));
+		std::qsort(v.data(), v.size(), sizeof(rapidstring), cmp_rs);
+
+		benchmark::DoNotOptimize(v.data());
+	}
+}
+
+BENCHMARK(rs_qsort);
+
+void std_sort(benchmark::State &state)
+{
+	for (auto _ : state) {
+		std::vector<std::string> v{ sort_keys };
+		std::sort(v.begin(), v.end());
+
+		benchmark::DoNotOptimize(v.data());
+	}
+}
+
+BENCHMARK(std_sort);
+
+void rs_parallel_sort(benchmark::State &state)
+{
+	const auto threads = static_cast<unsigned int>(state.range(0));
+	std::vector<rapidstring> v(keys);
+
+	for (auto _ : state) {
+		std::memcpy(v.data(), sort_strings.data(),
+			    keys * sizeof(rapidstring));
+		rs_parallel_sort(v.data(), v.size(), threads);
+
+		benchmark::DoNotOptimize(v.data());
+	}
+}
+
+BENCHMARK(rs_parallel_sort)->RangeMultiplier(2)->Range(1, 32)->UseRealTime();
@@ -0,0 +1,89 @@
+#include "rapidstring.h"
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+constexpr std::size_t rows{ 100000 };
+constexpr const char row_str[]{ "customer-name-that-is-on-the-heap-0042" };
+constexpr std::size_t row_size{ sizeof(row_str) - 1 };
+
+void rs_table_build(benchmark::State &state)
+{
+	for (auto _ : state) {
+		rs_table t;
+		rs_table_init(&t);
+
+		for (std::size_t i = 0; i < rows; i++)
+			rs_table_push_n(&t, row_str, row_size);
+
+		benchmark::DoNotOptimize(t);
+		rs_table_free(&t);
+	}
+}
+
+BENCHMARK(rs_table_build);
+
+void rs_vector_build(benchmark::State &state)
+{
+	for (auto _ : state) {
+		std::vector<rapidstring> v;
+
+		for (std::size_t i = 0; i < rows; i++) {
+			rapidstring s;
+			rs_init_w_n(&s, row_str, row_size);
+			v.push_back(s);
+		}
+
+		benchmark::DoNotOptimize(v.data());
+
+		for (auto &s : v)
+			rs_free(&s);
+	}
+}
+
+BENCHMARK(rs_vector_build);
+
+void rs_table_scan(benchmark::State &state)
+{
+	rs_table t;
+	rs_table_init(&t);
+
+	for (std::size_t i = 0; i < rows; i++)
+		rs_table_push_n(&t, row_str, row_size);
+
+	for (auto _ : state) {
+		std::size_t count = 0;
+
+		for (std::size_t i = 0; i < rows; i++)
+			count += rs_table_at(&t, i).data[row_size - 1] == '2';
+
+		benchmark::DoNotOptimize(count);
+	}
+
+	rs_table_free(&t);
+}
+
+BENCHMARK(rs_table_scan);
+
+void rs_vector_scan(benchmark::State &state)
+{
+	std::vector<rapidstring> v(rows);
+
+	for (auto &s : v)
+		rs_init_w_n(&s, row_str, row_size);
+
+	for (auto _ : state) {
+		std::size_t count = 0;
+
+		for (const auto &s : v)
+			count += rs_data_c(&s)[row_size - 1] == '2';
+
+		benchmark::DoNotOptimize(count);
+	}
+
+	for (auto &s : v)
+		rs_free(&s);
+}
+
+BENCHMARK(rs_vector_scan);
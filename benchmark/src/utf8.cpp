@@ -0,0 +1,61 @@
+#include "rapidstring.h"
+#include <benchmark/benchmark.h>
+#include <string>
+
+static std::string repeat(const char *input, std::size_t count)
+{
+	std::string str;
+
+	for (std::size_t i = 0; i < count; i++)
+		str += input;
+
+	return str;
+}
+
+static const std::string ascii_str{ repeat(
+	"The quick brown fox jumps over the lazy dog. ", 100) };
+static const std::string mixed_str{ repeat(
+	"Le c\xC5\x93ur a ses raisons \xE2\x80\x94 \xE6\x97\xA5\xE6\x9C\xAC "
+	"\xF0\x9F\x98\x80 ",
+	100) };
+
+void rs_utf8_valid_ascii(benchmark::State &state)
+{
+	for (auto _ : state)
+		benchmark::DoNotOptimize(
+			rs_utf8_valid_n(ascii_str.data(), ascii_str.size()));
+}
+
+BENCHMARK(rs_utf8_valid_ascii);
+
+void rs_utf8_valid_mixed(benchmark::State &state)
+{
+	for (auto _ : state)
+		benchmark::DoNotOptimize(
+			rs_utf8_valid_n(mixed_str.data(), mixed_str.size()));
+}
+
+BENCHMARK(rs_utf8_valid_mixed);
+
+void rs_utf8_valid_cached(benchmark::State &state)
+{
+	rapidstring s;
+	rs_init_w_n(&s, mixed_str.data(), mixed_str.size());
+	rs_utf8_validate(&s);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(rs_utf8_valid(&s));
+
+	rs_free(&s);
+}
+
+BENCHMARK(rs_utf8_valid_cached);
+
+void rs_utf8_len_mixed(benchmark::State &state)
+{
+	for (auto _ : state)
+		benchmark::DoNotOptimize(
+			rs_utf8_len_n(mixed_str.data(), mixed_str.size()));
+}
+
+BENCHMARK(rs_utf8_len_mixed);
@@ -11,27 +11,103 @@
  *       TABLE OF CONTENTS
  *
  * 1. STRUCTURES & MACROS
- * - Declarations:	line 69
+ * - Declarations:	line 144
  *
  * 2. CONSTRUCTION & DESTRUCTION
- * - Declarations:	line 385
- * - Defintions:	line 1155
+ * - Declarations:	line 734
+ * - Defintions:	line 7028
  *
  * 3. COPYING
- * - Declarations:	line 493
- * - Defintions:	line 1202
+ * - Declarations:	line 923
+ * - Defintions:	line 7148
  *
  * 4. CAPACITY
- * - Declarations:	line 600
- * - Defintions:	line 1255
+ * - Declarations:	line 1067
+ * - Defintions:	line 7240
  *
  * 5. MODIFIERS
- * - Declarations:	line 739
- * - Defintions:	line 1320
+ * - Declarations:	line 1220
+ * - Defintions:	line 7319
  *
  * 6. HEAP OPERATIONS
- * - Declarations:	line 1048
- * - Defintions:	line 1495
+ * - Declarations:	line 1917
+ * - Defintions:	line 7873
+ *
+ * 7. ARENA
+ * - Declarations:	line 2100
+ * - Defintions:	line 8060
+ *
+ * 8. POOL
+ * - Declarations:	line 2280
+ * - Defintions:	line 8176
+ *
+ * 9. SEARCH
+ * - Declarations:	line 2454
+ * - Defintions:	line 8336
+ *
+ * 10. COMPARE
+ * - Declarations:	line 2824
+ * - Defintions:	line 8799
+ *
+ * 11. HASH
+ * - Declarations:	line 3145
+ * - Defintions:	line 9043
+ *
+ * 12. INTERN
+ * - Declarations:	line 3388
+ * - Defintions:	line 9283
+ *
+ * 13. VIEW
+ * - Declarations:	line 3707
+ * - Defintions:	line 9491
+ *
+ * 14. SHARED
+ * - Declarations:	line 3792
+ * - Defintions:	line 9541
+ *
+ * 15. ROPE
+ * - Declarations:	line 3903
+ * - Defintions:	line 9610
+ *
+ * 16. NUMBER
+ * - Declarations:	line 4359
+ * - Defintions:	line 10022
+ *
+ * 17. SPLIT
+ * - Declarations:	line 4870
+ * - Defintions:	line 10787
+ *
+ * 18. CASE
+ * - Declarations:	line 5113
+ * - Defintions:	line 10966
+ *
+ * 19. UTF-8
+ * - Declarations:	line 5380
+ * - Defintions:	line 11183
+ *
+ * 20. ENCODING
+ * - Declarations:	line 5515
+ * - Defintions:	line 11476
+ *
+ * 21. TRIM
+ * - Declarations:	line 5746
+ * - Defintions:	line 11778
+ *
+ * 22. GAP BUFFER
+ * - Declarations:	line 5915
+ * - Defintions:	line 11937
+ *
+ * 23. TABLE
+ * - Declarations:	line 6187
+ * - Defintions:	line 12088
+ *
+ * 24. SORT
+ * - Declarations:	line 6486
+ * - Defintions:	line 12277
+ *
+ * 25. PARALLEL SORT
+ * - Declarations:	line 6676
+ * - Defintions:	line 12516
  */
 
 /**
@@ -56,7 +132,10 @@
 #define RAPIDSTRING_H_962AB5F800398A34
 
 #include <assert.h> /* assert() */
+#include <locale.h> /* localeconv() */
 #include <string.h> /* memcpy() */
+#include <stdint.h> /* uint64_t */
+#include <stdlib.h> /* strtod() */
 
 /*
  * ===============================================================
@@ -122,6 +201,11 @@
 #if !defined(RS_MALLOC) && !defined(RS_REALLOC) && !defined(RS_FREE)
 #include <stdlib.h>
 
+#ifdef RS_POOL
+#define RS_MALLOC rs_pool_malloc
+#define RS_REALLOC rs_pool_realloc
+#define RS_FREE rs_pool_free
+#else
 /**
  * @brief Allocation macro.
  *
@@ -149,6 +233,7 @@
  */
 #define RS_FREE free
 #endif
+#endif
 
 #ifndef RS_HEAP_FLAG
 /**
@@ -185,12 +270,85 @@
 #define RS_LIKELY(expr) RS_EXPECT(expr, 1)
 #define RS_UNLIKELY(expr) RS_EXPECT(expr, 0)
 
+/*
+ * Asserts a precondition and hands it to the optimizer. GCC version 4.5
+ * required for unreachable code hints.
+ */
+#if RS_GCC_VERSION > 40500
+#define RS_ASSUME(expr)                          \
+	do {                                     \
+		assert(expr);                    \
+		if (!(expr))                     \
+			__builtin_unreachable(); \
+	} while (0)
+#elif defined(_MSC_VER)
+#define RS_ASSUME(expr)         \
+	do {                    \
+		assert(expr);   \
+		__assume(expr); \
+	} while (0)
+#else
+#define RS_ASSUME(expr) assert(expr)
+#endif
+
 #ifdef __STDC_VERSION__
 #define RS_C99 (__STDC_VERSION__ >= 199901L)
 #define RS_C11 (__STDC_VERSION__ >= 201112L)
 #else
 #define RS_C99 (0)
-#define RC_C11 (0)
+#define RS_C11 (0)
+#endif
+
+/* Only GCC compatible compilers report a big endian byte order. */
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define RS_BIG_ENDIAN
+#endif
+
+#if defined(__GNUC__)
+#define RS_THREAD_LOCAL __thread
+#elif defined(_MSC_VER)
+#define RS_THREAD_LOCAL __declspec(thread)
+#elif RS_C11 && !defined(__STDC_NO_THREADS__)
+#define RS_THREAD_LOCAL _Thread_local
+#endif
+
+/*
+ * Atomic operations are only used by the optional thread safe features, such
+ * as the pool allocator. Compare and swap and fetch and add are full barriers,
+ * while exchange is at least an acquire barrier.
+ */
+#if defined(__GNUC__)
+#define RS_ATOMIC_CAS_PTR(p, old, val) __sync_bool_compare_and_swap(p, old, val)
+#define RS_ATOMIC_ADD(p, val) __sync_add_and_fetch(p, val)
+#ifdef __ATOMIC_ACQ_REL
+#define RS_ATOMIC_XCHG_PTR(p, val) __atomic_exchange_n(p, val, __ATOMIC_ACQ_REL)
+#else
+#define RS_ATOMIC_XCHG_PTR(p, val) __sync_lock_test_and_set(p, val)
+#endif
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#define RS_ATOMIC_CAS_PTR(p, old, val)                                   \
+	(_InterlockedCompareExchangePointer((void *volatile *)(p), val, \
+					    old) == (old))
+#define RS_ATOMIC_ADD(p, val) (_InterlockedExchangeAdd(p, val) + (val))
+#define RS_ATOMIC_XCHG_PTR(p, val) \
+	_InterlockedExchangePointer((void *volatile *)(p), val)
+#else
+/* No atomic operations are known for this compiler. */
+#define RS_NO_ATOMICS
+#endif
+
+#ifdef RS_NO_ATOMICS
+#if RS_C11 && !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+/* Only the reference counts of shared strings need a portable fallback. */
+#define RS_SHARED_ADD(p, val) \
+	(atomic_fetch_add((volatile _Atomic long *)(p), val) + (val))
+#else
+#error "Shared strings require atomic operations."
+#endif
+#else
+#define RS_SHARED_ADD(p, val) RS_ATOMIC_ADD(p, val)
 #endif
 
 #ifdef RS_NOINLINE
@@ -212,6 +370,142 @@
 #define RS_API static
 #endif
 
+/*
+ * Vectorized kernels are used when the target supports SSE2 or AVX2. They may
+ * be disabled by defining RS_NO_SIMD, which falls back to portable code. The
+ * kernels that shuffle bytes within each 16 byte lane also require SSSE3,
+ * which RS_VEC_SHUFFLE is only defined with.
+ */
+#ifndef RS_NO_SIMD
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define RS_SIMD
+#define RS_VEC_SIZE (32)
+typedef __m256i rs_vec;
+#define RS_VEC_LOAD(p) _mm256_loadu_si256((const __m256i *)(const void *)(p))
+#define RS_VEC_STORE(p, v) _mm256_storeu_si256((__m256i *)(void *)(p), v)
+#define RS_VEC_SET1(c) _mm256_set1_epi8((char)(c))
+#define RS_VEC_EQ(a, b) _mm256_cmpeq_epi8(a, b)
+#define RS_VEC_GT(a, b) _mm256_cmpgt_epi8(a, b)
+#define RS_VEC_AND(a, b) _mm256_and_si256(a, b)
+#define RS_VEC_OR(a, b) _mm256_or_si256(a, b)
+#define RS_VEC_XOR(a, b) _mm256_xor_si256(a, b)
+#define RS_VEC_ADD(a, b) _mm256_add_epi8(a, b)
+#define RS_VEC_MASK(v) ((unsigned int)_mm256_movemask_epi8(v))
+#define RS_VEC_FULL (0xFFFFFFFFu)
+#define RS_VEC_INDEX                                                        \
+	_mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, \
+			 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, \
+			 28, 29, 30, 31)
+#define RS_VEC_ADD64(a, b) _mm256_add_epi64(a, b)
+#define RS_VEC_MUL32(a, b) _mm256_mul_epu32(a, b)
+#define RS_VEC_SRL64(v, n) _mm256_srli_epi64(v, n)
+#define RS_VEC_SLL64(v, n) _mm256_slli_epi64(v, n)
+#define RS_VEC_SWAP64(v) _mm256_shuffle_epi32(v, 0x4E)
+#define RS_VEC_ZIPLO(a, b)                                             \
+	_mm256_permute2x128_si256(_mm256_unpacklo_epi8(a, b),          \
+				  _mm256_unpackhi_epi8(a, b), 0x20)
+#define RS_VEC_ZIPHI(a, b)                                             \
+	_mm256_permute2x128_si256(_mm256_unpacklo_epi8(a, b),          \
+				  _mm256_unpackhi_epi8(a, b), 0x31)
+#define RS_VEC_PACK16(a, b)                                                  \
+	_mm256_permute4x64_epi64(                                            \
+		_mm256_packus_epi16(                                         \
+			_mm256_and_si256(a, _mm256_set1_epi16(0xFF)),        \
+			_mm256_and_si256(b, _mm256_set1_epi16(0xFF))),       \
+		0xD8)
+#define RS_VEC_SHUFFLE(v, i) _mm256_shuffle_epi8(v, i)
+#define RS_VEC_LANE16(a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p)      \
+	_mm256_setr_epi8(a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, a, \
+			 b, c, d, e, f, g, h, i, j, k, l, m, n, o, p)
+#define RS_VEC_LOAD_LANES(p, stride)                                       \
+	_mm256_inserti128_si256(                                           \
+		_mm256_castsi128_si256(                                    \
+			_mm_loadu_si128((const __m128i *)(const void *)(p))), \
+		_mm_loadu_si128((const __m128i *)(const void *)((p) +     \
+								 (stride))), \
+		1)
+#define RS_VEC_STORE_LANES(p, stride, v)                                     \
+	do {                                                                 \
+		_mm_storeu_si128((__m128i *)(void *)(p),                     \
+				 _mm256_castsi256_si128(v));                 \
+		_mm_storeu_si128((__m128i *)(void *)((p) + (stride)),        \
+				 _mm256_extracti128_si256(v, 1));            \
+	} while (0)
+#define RS_VEC_SET32(c) _mm256_set1_epi32(c)
+#define RS_VEC_SUBS(a, b) _mm256_subs_epu8(a, b)
+#define RS_VEC_MULHI16(a, b) _mm256_mulhi_epu16(a, b)
+#define RS_VEC_MULLO16(a, b) _mm256_mullo_epi16(a, b)
+#define RS_VEC_MADD8(a, b) _mm256_maddubs_epi16(a, b)
+#define RS_VEC_MADD16(a, b) _mm256_madd_epi16(a, b)
+#elif defined(__SSE2__) || defined(_M_X64) || \
+	(defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RS_SIMD
+#define RS_VEC_SIZE (16)
+typedef __m128i rs_vec;
+#define RS_VEC_LOAD(p) _mm_loadu_si128((const __m128i *)(const void *)(p))
+#define RS_VEC_STORE(p, v) _mm_storeu_si128((__m128i *)(void *)(p), v)
+#define RS_VEC_SET1(c) _mm_set1_epi8((char)(c))
+#define RS_VEC_EQ(a, b) _mm_cmpeq_epi8(a, b)
+#define RS_VEC_GT(a, b) _mm_cmpgt_epi8(a, b)
+#define RS_VEC_AND(a, b) _mm_and_si128(a, b)
+#define RS_VEC_OR(a, b) _mm_or_si128(a, b)
+#define RS_VEC_XOR(a, b) _mm_xor_si128(a, b)
+#define RS_VEC_ADD(a, b) _mm_add_epi8(a, b)
+#define RS_VEC_MASK(v) ((unsigned int)_mm_movemask_epi8(v))
+#define RS_VEC_FULL (0xFFFFu)
+#define RS_VEC_INDEX \
+	_mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15)
+#define RS_VEC_ADD64(a, b) _mm_add_epi64(a, b)
+#define RS_VEC_MUL32(a, b) _mm_mul_epu32(a, b)
+#define RS_VEC_SRL64(v, n) _mm_srli_epi64(v, n)
+#define RS_VEC_SLL64(v, n) _mm_slli_epi64(v, n)
+#define RS_VEC_SWAP64(v) _mm_shuffle_epi32(v, 0x4E)
+#define RS_VEC_ZIPLO(a, b) _mm_unpacklo_epi8(a, b)
+#define RS_VEC_ZIPHI(a, b) _mm_unpackhi_epi8(a, b)
+#define RS_VEC_PACK16(a, b)                                       \
+	_mm_packus_epi16(_mm_and_si128(a, _mm_set1_epi16(0xFF)), \
+			 _mm_and_si128(b, _mm_set1_epi16(0xFF)))
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#define RS_VEC_SHUFFLE(v, i) _mm_shuffle_epi8(v, i)
+#define RS_VEC_LANE16(a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p) \
+	_mm_setr_epi8(a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p)
+#define RS_VEC_LOAD_LANES(p, stride) RS_VEC_LOAD(p)
+#define RS_VEC_STORE_LANES(p, stride, v) RS_VEC_STORE(p, v)
+#define RS_VEC_SET32(c) _mm_set1_epi32(c)
+#define RS_VEC_SUBS(a, b) _mm_subs_epu8(a, b)
+#define RS_VEC_MULHI16(a, b) _mm_mulhi_epu16(a, b)
+#define RS_VEC_MULLO16(a, b) _mm_mullo_epi16(a, b)
+#define RS_VEC_MADD8(a, b) _mm_maddubs_epi16(a, b)
+#define RS_VEC_MADD16(a, b) _mm_madd_epi16(a, b)
+#endif
+#endif
+
+#ifdef RS_SIMD
+/* Toggles the case of the characters of a vector from first to last. */
+#define RS_VEC_CASE(v, first, last)                                      \
+	RS_VEC_XOR(v, RS_VEC_AND(RS_VEC_AND(RS_VEC_GT(v, RS_VEC_SET1(    \
+							    (first) - 1)), \
+					    RS_VEC_GT(RS_VEC_SET1((last) + 1), \
+						      v)),                 \
+				 RS_VEC_SET1(0x20)))
+/* Stores in mask the characters of a vector found in a set. */
+#define RS_VEC_IN_SET(v, set, n, mask)                                        \
+	do {                                                                  \
+		const rs_vec rs_v_ = (v);                                     \
+		rs_vec rs_eq_ = RS_VEC_EQ(rs_v_, RS_VEC_SET1((set)[0]));      \
+		size_t rs_j_;                                                 \
+		for (rs_j_ = 1; rs_j_ < (n); rs_j_++)                         \
+			rs_eq_ = RS_VEC_OR(                                   \
+				rs_eq_,                                       \
+				RS_VEC_EQ(rs_v_, RS_VEC_SET1((set)[rs_j_]))); \
+		mask = RS_VEC_MASK(rs_eq_);                                   \
+	} while (0)
+#endif
+#endif
+
 typedef struct {
 	void *pointer;
 	size_t size;
@@ -255,7 +549,8 @@ typedef struct {
 	 *
 	 * Allocated using RS_MALLOC() or RS_REALLOC(). This buffer may be
 	 * manually freed by directly calling `RS_FREE(s->heap.buffer)`. Doing
-	 * so will avoid the heap flag check.
+	 * so will avoid the heap flag check. Buffers owned by an #rs_allocator
+	 * or advanced by rs_ltrim() must be freed with rs_free() instead.
 	 */
 	char *buffer;
 	/**
@@ -275,7 +570,14 @@ typedef struct {
 	 *
 	 * Ensures @a flag and @a left are stored in the same location.
 	 */
-	unsigned char align[RS_ALIGNMENT - 1];
+	unsigned char align[RS_ALIGNMENT - 2];
+	/**
+	 * @brief Mode of a heap string.
+	 *
+	 * Bit flags describing how the heap buffer was allocated, such as
+	 * #RS_HEAP_MODE_ALLOC. Zero for buffers allocated with RS_MALLOC().
+	 */
+	unsigned char mode;
 	/**
 	 * @brief Flag of the rapidstring union.
 	 *
@@ -287,6 +589,46 @@ typedef struct {
 	unsigned char flag;
 } rs_heap;
 
+/**
+ * @brief Heap mode bit of a string allocated by an #rs_allocator.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+#define RS_HEAP_MODE_ALLOC (0x01)
+
+/**
+ * @brief Heap mode bit of a string frozen by rs_freeze().
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+#define RS_HEAP_MODE_SHARED (0x02)
+
+/**
+ * @brief Heap mode bit of a string known to be valid UTF-8.
+ *
+ * Set by rs_utf8_validate() and cleared by rs_utf8_forget() or whenever the
+ * string is resized.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+#define RS_HEAP_MODE_UTF8 (0x04)
+
+/**
+ * @brief Heap mode bit of a string whose buffer was advanced by
+ * rs_heap_skip().
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+#define RS_HEAP_MODE_OFFSET (0x08)
+
 #ifndef RS_STACK_CAPACITY
 /**
  * @brief Capacity of a stack string.
@@ -343,6 +685,102 @@ typedef union {
 	rs_heap heap;
 } rapidstring;
 
+/**
+ * @brief Non-owning view of characters.
+ *
+ * A view does not own its characters, which must outlive it, and is not
+ * null terminated. Functions suffixed with `_v` accept a view wherever the
+ * `_n` functions accept characters and their length.
+ *
+ * @since 1.1.0
+ */
+typedef struct {
+	/** @brief The characters of the view. */
+	const char *data;
+	/** @brief Number of characters of the view. */
+	size_t size;
+} rs_view;
+
+/**
+ * @brief Allocator of a #rapidstring.
+ *
+ * Heap buffers are allocated with RS_MALLOC() by default. An allocator may be
+ * assigned to a single string or shared by a group of strings to route all of
+ * their heap allocations elsewhere. The @a ctx member is passed back to every
+ * function, which allows several instances of the same allocator.
+ *
+ * All sizes provided to these functions include the null terminator and the
+ * #rs_heap_header. Allocated memory must be suitably aligned for a pointer.
+ *
+ * @since 1.1.0
+ */
+typedef struct {
+	/** @brief Allocates @a n bytes. */
+	void *(*allocate)(void *ctx, size_t n);
+	/**
+	 * @brief Resizes a block of @a old_n bytes to @a n bytes.
+	 *
+	 * May be `NULL`, in which case @a allocate and @a deallocate are used.
+	 */
+	void *(*reallocate)(void *ctx, void *p, size_t old_n, size_t n);
+	/** @brief Deallocates a block of @a n bytes. */
+	void (*deallocate)(void *ctx, void *p, size_t n);
+	/** @brief User context passed to every function. */
+	void *ctx;
+} rs_allocator;
+
+/**
+ * @brief Header preceding the buffer of a string owned by an #rs_allocator.
+ *
+ * The allocator is stored in front of the heap buffer rather than inside the
+ * #rapidstring, which keeps the size of the union identicle for all strings.
+ * Buffers allocated with RS_MALLOC() have no header.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+typedef struct {
+	/** @brief The allocator owning the buffer. */
+	const rs_allocator *allocator;
+} rs_heap_header;
+
+/**
+ * @brief Retrieves the header of a heap string owned by an #rs_allocator.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+#define RS_HEAP_HEADER(s) \
+	((rs_heap_header *)((s)->heap.buffer - rs_heap_offset(s)) - 1)
+
+/**
+ * @brief Header preceding the buffer of a string frozen by rs_freeze().
+ *
+ * The #rs_heap_header is stored last, therefore RS_HEAP_HEADER() remains
+ * valid for shared strings owned by an #rs_allocator.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+typedef struct {
+	/** @brief Number of strings sharing the buffer. */
+	volatile long refs;
+	/** @brief The allocator owning the buffer, or `NULL`. */
+	rs_heap_header header;
+} rs_shared_header;
+
+/**
+ * @brief Retrieves the header of a string frozen by rs_freeze().
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+#define RS_SHARED_HEADER(s) ((rs_shared_header *)((s)->heap.buffer) - 1)
+
 /* Based off the average string size, allow for more efficient branching. */
 enum { RS_HEAP_LIKELY_V = RS_AVERAGE_SIZE > RS_STACK_CAPACITY };
 
@@ -458,6 +896,88 @@ RS_API void rs_init_w_cap(rapidstring *s, size_t n);
  */
 RS_API void rs_init_w_rs(rapidstring *s, const rapidstring *input);
 
+/**
+ * @brief Initializes a string with a view.
+ *
+ * @param[out] s A string to initialize.
+ * @param[in] input The view used to initialize @a s.
+ *
+ * @allocation When the size of @a input is greater than #RS_STACK_CAPACITY.
+ *
+ * @complexity Linear in the size of @a input.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_init_w_v(rapidstring *s, rs_view input);
+
+/**
+ * @brief Initializes a string with the concatenation of several views.
+ *
+ * @param[out] s A string to initialize.
+ * @param[in] pieces The views to concatenate, none of which may view @a s.
+ * @param[in] n The number of views in @a pieces.
+ *
+ * @allocation At most once, when the total size of @a pieces is greater than
+ * #RS_STACK_CAPACITY.
+ *
+ * @complexity Linear in the total size of @a pieces.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_init_w_many(rapidstring *s, const rs_view *pieces, size_t n);
+
+/**
+ * @brief Initializes a string with the concatenation of several strings.
+ *
+ * @param[out] s A string to initialize.
+ * @param[in] pieces The strings to concatenate.
+ * @param[in] n The number of strings in @a pieces.
+ *
+ * @allocation At most once, when the total length of @a pieces is greater
+ * than #RS_STACK_CAPACITY.
+ *
+ * @complexity Linear in the total length of @a pieces.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_init_w_many_rs(rapidstring *s,
+			      const rapidstring *const *pieces, size_t n);
+
+/**
+ * @brief Initializes a string with an allocator.
+ *
+ * Identicle to rs_init_w_cap_alloc() with a capacity of #RS_STACK_CAPACITY.
+ *
+ * @param[out] s A string to initialize.
+ * @param[in] a The allocator of @a s.
+ *
+ * @allocation Always.
+ *
+ * @complexity Constant.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_init_w_alloc(rapidstring *s, const rs_allocator *a);
+
+/**
+ * @brief Initializes a string with an initial capacity and an allocator.
+ *
+ * A stack string has no room to store its allocator, therefore a string
+ * initialized with an allocator always remains on the heap. All of its future
+ * allocations and deallocations are done through @a a, which must outlive the
+ * string.
+ *
+ * @param[out] s A string to initialize.
+ * @param[in] n The initial capacity of @a s.
+ * @param[in] a The allocator of @a s.
+ *
+ * @allocation Always.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_init_w_cap_alloc(rapidstring *s, size_t n,
+				const rs_allocator *a);
+
 /**
  * @brief Frees a string.
  *
@@ -465,7 +985,8 @@ RS_API void rs_init_w_rs(rapidstring *s, const rapidstring *input);
  * you wish to reuse the same string.
  *
  * A jump may be avoided by directly calling `RS_FREE(s->heap.buffer)` if the
- * string is known to be on the heap.
+ * string is known to be on the heap, to have no allocator and to never have
+ * been left trimmed.
  *
  * Calling this fuction is unnecessary if the string size is always smaller or
  * equal to #RS_STACK_CAPACITY.
@@ -585,6 +1106,43 @@ RS_API void rs_cpy_n(rapidstring *s, const char *input, size_t n);
  */
 RS_API void rs_cpy_rs(rapidstring *s, const rapidstring *input);
 
+/**
+ * @brief Copies characters from a view to a string.
+ *
+ * Overwrites any existing data.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] input The view used to initialize @a s. It must not view @a s.
+ *
+ * @allocation When the size of @a input is greater than #RS_STACK_CAPACITY.
+ *
+ * @complexity Linear in the size of @a input.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_cpy_v(rapidstring *s, rs_view input);
+
+/**
+ * @brief Prepares a string to be overwritten.
+ *
+ * The capacity of @a s becomes exactly @a n if it was insufficient, and the
+ * string remains on the stack if @a n fits.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] n The amount of characters that will be written.
+ *
+ * @returns The buffer of @a s, with room for @a n characters.
+ *
+ * @warning Intended for internal use. The characters and the length of @a s
+ * are left unspecified until it is resized.
+ *
+ * @allocation When @a n is greater than the capacity of @a s, or when @a s
+ * is shared.
+ *
+ * @since 1.1.0
+ */
+RS_API char *rs_cpy_reserve(rapidstring *s, size_t n);
+
 /** @} */
 
 /*
@@ -724,6 +1282,20 @@ RS_API unsigned char rs_is_heap(const rapidstring *s);
  */
 RS_API unsigned char rs_is_stack(const rapidstring *s);
 
+/**
+ * @brief Returns the allocator.
+ *
+ * @param[in] s An initialized string.
+ * @returns The allocator of @a s, or `NULL` if it uses RS_MALLOC().
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant.
+ *
+ * @since 1.1.0
+ */
+RS_API const rs_allocator *rs_get_alloc(const rapidstring *s);
+
 /** @} */
 
 /*
@@ -746,6 +1318,10 @@ RS_API unsigned char rs_is_stack(const rapidstring *s);
  * @param[in] s An initialized string.
  * @returns The buffer.
  *
+ * @warning Writing through the buffer is not noticed by a remembered
+ * rs_utf8_validate() result. Call rs_utf8_forget() afterwards when the
+ * written characters are not known to be valid UTF-8.
+ *
  * @allocation Never.
  *
  * @complexity Constant.
@@ -852,84 +1428,488 @@ RS_API void rs_cat_n(rapidstring *s, const char *input, size_t n);
 RS_API void rs_cat_rs(rapidstring *s, const rapidstring *input);
 
 /**
- * @brief Steals a buffer allocated on the heap.
- *
- * The buffer must either be allocated with RS_MALLOC() or RS_REALLOC(), or it
- * must be manually freed.
- *
- * @param[out] s A string.
- * @param[in] buffer The buffer to steal.
- * @param[in] cap The capacity of @a buffer.
- * @param[in] size The size of @a buffer.
+ * @brief Concatenates a view to a string.
  *
- * @note A null terminator will be written to the last element of the buffer.
+ * @param[in,out] s An initialized string.
+ * @param[in] input The view to concatenate. It must not view @a s.
  *
- * @allocation Never.
+ * @allocation When the size of @a input is greater than the remaining
+ * capacity of @a s.
  *
- * @complexity Constant.
+ * @complexity Linear in the size of @a input.
  *
- * @since 1.0.0
+ * @since 1.1.0
  */
-RS_API void rs_steal(rapidstring *s, char *buffer, size_t cap, size_t size);
+RS_API void rs_cat_v(rapidstring *s, rs_view input);
 
 /**
- * @brief Removes the specified characters from a stack string.
+ * @brief Grows a string for appending characters.
  *
- * @param[in,out] s An initialized stack string.
- * @param[in] index The index of the first character to remove.
- * @param[in] n The number of characters to remove.
+ * @param[in,out] s An initialized string.
+ * @param[in] n The amount of characters that will be appended.
  *
- * @allocation Never.
+ * @returns A pointer past the last character of @a s, with room for @a n
+ * characters.
  *
- * @complexity Linear in the length of @a s minus @a index.
+ * @warning Intended for internal use. The length of @a s is not changed.
  *
- * @since 1.0.0
+ * @allocation When @a n is greater than the remaining capacity of @a s.
+ *
+ * @since 1.1.0
  */
-RS_API void rs_stack_erase(rapidstring *s, size_t index, size_t n);
+RS_API char *rs_cat_reserve(rapidstring *s, size_t n);
 
 /**
- * @brief Removes the specified characters from a heap string.
+ * @brief Concatenates several views to a string.
  *
- * @param[in,out] s An initialized heap string.
- * @param[in] index The index of the first character to remove.
- * @param[in] n The number of characters to remove.
+ * The total size is computed once, so at most one allocation is performed
+ * and the string is terminated once.
  *
- * @allocation Never.
+ * @param[in,out] s An initialized string.
+ * @param[in] pieces The views to concatenate, none of which may view @a s.
+ * @param[in] n The number of views in @a pieces.
  *
- * @complexity Linear in the length of @a s minus @a index.
+ * @allocation At most once, when the total size of @a pieces is greater than
+ * the remaining capacity of @a s.
  *
- * @since 1.0.0
+ * @complexity Linear in the total size of @a pieces.
+ *
+ * @since 1.1.0
  */
-RS_API void rs_heap_erase(rapidstring *s, size_t index, size_t n);
+RS_API void rs_cat_many(rapidstring *s, const rs_view *pieces, size_t n);
 
 /**
- * @brief Removes the specified characters from a string.
+ * @brief Concatenates several strings to a string.
  *
  * @param[in,out] s An initialized string.
- * @param[in] index The index of the first character to remove.
- * @param[in] n The number of characters to remove.
+ * @param[in] pieces The strings to concatenate, none of which may be @a s.
+ * @param[in] n The number of strings in @a pieces.
  *
- * @note If you wish to decrease the capacity of the string and keep the size
- * the same, use rs_shrink_to_fit().
+ * @note Identicle to rs_cat_many() with a view of each string.
  *
- * @allocation Never.
+ * @allocation At most once, when the total length of @a pieces is greater
+ * than the remaining capacity of @a s.
  *
- * @complexity Linear in the length of @a s minus @a index.
+ * @complexity Linear in the total length of @a pieces.
  *
- * @since 1.0.0
+ * @since 1.1.0
  */
-RS_API void rs_erase(rapidstring *s, size_t index, size_t n);
+RS_API void rs_cat_many_rs(rapidstring *s, const rapidstring *const *pieces,
+			   size_t n);
 
 /**
- * @brief Removes all characters from a stack string.
+ * @brief Joins views with a separator.
  *
- * @param[out] s An initialized stack string.
+ * @param[in,out] s An initialized string, replaced by the result.
+ * @param[in] pieces The views to join, none of which may view @a s.
+ * @param[in] n The number of views in @a pieces.
+ * @param[in] sep The separator placed between each view.
  *
- * @allocation Never.
+ * @note Identicle to rs_join_n() with `strlen()`.
  *
- * @complexity Constant.
+ * @allocation At most once, when the length of the result is greater than
+ * the capacity of @a s.
  *
- * @since 1.0.0
+ * @complexity Linear in the length of the result.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_join(rapidstring *s, const rs_view *pieces, size_t n,
+		    const char *sep);
+
+/**
+ * @brief Joins views with a separator.
+ *
+ * The length of the result is computed up front, so the string is sized
+ * exactly once and remains on the stack if the result fits.
+ *
+ * @param[in,out] s An initialized string, replaced by the result.
+ * @param[in] pieces The views to join, none of which may view @a s.
+ * @param[in] n The number of views in @a pieces.
+ * @param[in] sep The separator placed between each view.
+ * @param[in] sep_len The length of @a sep.
+ *
+ * @allocation At most once, when the length of the result is greater than
+ * the capacity of @a s.
+ *
+ * @complexity Linear in the length of the result.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_join_n(rapidstring *s, const rs_view *pieces, size_t n,
+		      const char *sep, size_t sep_len);
+
+/**
+ * @brief Joins strings with a separator.
+ *
+ * @param[in,out] s An initialized string, replaced by the result.
+ * @param[in] pieces The strings to join, none of which may be @a s.
+ * @param[in] n The number of strings in @a pieces.
+ * @param[in] sep The separator placed between each string.
+ *
+ * @note Identicle to rs_join_rs_n() with `strlen()`.
+ *
+ * @allocation At most once, when the length of the result is greater than
+ * the capacity of @a s.
+ *
+ * @complexity Linear in the length of the result.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_join_rs(rapidstring *s, const rapidstring *const *pieces,
+		       size_t n, const char *sep);
+
+/**
+ * @brief Joins strings with a separator.
+ *
+ * @param[in,out] s An initialized string, replaced by the result.
+ * @param[in] pieces The strings to join, none of which may be @a s.
+ * @param[in] n The number of strings in @a pieces.
+ * @param[in] sep The separator placed between each string.
+ * @param[in] sep_len The length of @a sep.
+ *
+ * @note Identicle to rs_join_n() with a view of each string.
+ *
+ * @allocation At most once, when the length of the result is greater than
+ * the capacity of @a s.
+ *
+ * @complexity Linear in the length of the result.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_join_rs_n(rapidstring *s, const rapidstring *const *pieces,
+			 size_t n, const char *sep, size_t sep_len);
+
+/**
+ * @brief Steals a buffer allocated on the heap.
+ *
+ * The buffer must either be allocated with RS_MALLOC() or RS_REALLOC(), or it
+ * must be manually freed.
+ *
+ * @param[out] s A string.
+ * @param[in] buffer The buffer to steal.
+ * @param[in] cap The capacity of @a buffer.
+ * @param[in] size The size of @a buffer.
+ *
+ * @note A null terminator will be written to the last element of the buffer.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant.
+ *
+ * @since 1.0.0
+ */
+RS_API void rs_steal(rapidstring *s, char *buffer, size_t cap, size_t size);
+
+/**
+ * @brief Removes the specified characters from a stack string.
+ *
+ * @param[in,out] s An initialized stack string.
+ * @param[in] index The index of the first character to remove.
+ * @param[in] n The number of characters to remove.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of @a s minus @a index.
+ *
+ * @since 1.0.0
+ */
+RS_API void rs_stack_erase(rapidstring *s, size_t index, size_t n);
+
+/**
+ * @brief Removes the specified characters from a heap string.
+ *
+ * @param[in,out] s An initialized heap string.
+ * @param[in] index The index of the first character to remove.
+ * @param[in] n The number of characters to remove.
+ *
+ * @allocation When @a s is frozen.
+ *
+ * @complexity Linear in the length of @a s minus @a index.
+ *
+ * @since 1.0.0
+ */
+RS_API void rs_heap_erase(rapidstring *s, size_t index, size_t n);
+
+/**
+ * @brief Removes the specified characters from a string.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] index The index of the first character to remove.
+ * @param[in] n The number of characters to remove.
+ *
+ * @note If you wish to decrease the capacity of the string and keep the size
+ * the same, use rs_shrink_to_fit().
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of @a s minus @a index.
+ *
+ * @since 1.0.0
+ */
+RS_API void rs_erase(rapidstring *s, size_t index, size_t n);
+
+/**
+ * @brief Inserts characters into a string.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] index The index before which @a input is inserted.
+ * @param[in] input The input to insert, which must not be within @a s.
+ *
+ * @note Identicle to rs_insert_n() with `strlen()`.
+ *
+ * @allocation When the result is greater than the capacity of @a s, or when
+ * @a s is shared.
+ *
+ * @complexity Linear in the length of @a s minus @a index plus the length of
+ * @a input.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_insert(rapidstring *s, size_t index, const char *input);
+
+/**
+ * @brief Inserts characters into a string.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] index The index before which @a input is inserted.
+ * @param[in] input The input to insert, which must not be within @a s.
+ * @param[in] n The length of @a input.
+ *
+ * @note Identicle to `rs_replace_range_n(s, index, 0, input, n)`.
+ *
+ * @allocation When the result is greater than the capacity of @a s, or when
+ * @a s is shared.
+ *
+ * @complexity Linear in the length of @a s minus @a index plus @a n.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_insert_n(rapidstring *s, size_t index, const char *input,
+			size_t n);
+
+/**
+ * @brief Inserts a string into another string.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] index The index before which @a input is inserted.
+ * @param[in] input The input to insert, which must not be @a s.
+ *
+ * @allocation When the result is greater than the capacity of @a s, or when
+ * @a s is shared.
+ *
+ * @complexity Linear in the length of @a s minus @a index plus the length of
+ * @a input.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_insert_rs(rapidstring *s, size_t index,
+			 const rapidstring *input);
+
+/**
+ * @brief Inserts a view into a string.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] index The index before which @a input is inserted.
+ * @param[in] input The view to insert, which must not be within @a s.
+ *
+ * @note Identicle to rs_insert_n() with the data and size of @a input.
+ *
+ * @allocation When the result is greater than the capacity of @a s, or when
+ * @a s is shared.
+ *
+ * @complexity Linear in the length of @a s minus @a index plus the size of
+ * @a input.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_insert_v(rapidstring *s, size_t index, rs_view input);
+
+/**
+ * @brief Replaces a range of characters.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] index The index of the first character to replace.
+ * @param[in] n The number of characters to replace.
+ * @param[in] input The characters replacing the range, which must not be
+ * within @a s.
+ *
+ * @note Identicle to rs_replace_range_n() with `strlen()`.
+ *
+ * @allocation When the result is greater than the capacity of @a s, or when
+ * @a s is shared.
+ *
+ * @complexity Linear in the length of @a s minus @a index plus the length of
+ * @a input.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_replace_range(rapidstring *s, size_t index, size_t n,
+			     const char *input);
+
+/**
+ * @brief Replaces a range of characters.
+ *
+ * The characters after the range are moved once, directly to their final
+ * position. A string which must grow does so at most once. When a stack
+ * string or a shared string must grow, the characters before the range, the
+ * input and the characters after the range are copied straight into the new
+ * buffer.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] index The index of the first character to replace.
+ * @param[in] n The number of characters to replace.
+ * @param[in] input The characters replacing the range, which must not be
+ * within @a s.
+ * @param[in] i_n The length of @a input.
+ *
+ * @allocation When the result is greater than the capacity of @a s, or when
+ * @a s is shared.
+ *
+ * @complexity Linear in the length of @a s minus @a index plus @a i_n.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_replace_range_n(rapidstring *s, size_t index, size_t n,
+			       const char *input, size_t i_n);
+
+/**
+ * @brief Replaces a range of characters with a view.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] index The index of the first character to replace.
+ * @param[in] n The number of characters to replace.
+ * @param[in] input The view replacing the range, which must not be within
+ * @a s.
+ *
+ * @note Identicle to rs_replace_range_n() with the data and size of
+ * @a input.
+ *
+ * @allocation When the result is greater than the capacity of @a s, or when
+ * @a s is shared.
+ *
+ * @complexity Linear in the length of @a s minus @a index plus the size of
+ * @a input.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_replace_range_v(rapidstring *s, size_t index, size_t n,
+			       rs_view input);
+
+/**
+ * @brief Replaces a range of characters into a new buffer.
+ *
+ * @param[in,out] s An initialized stack string or shared string.
+ * @param[in] index The index of the first character to replace.
+ * @param[in] n The number of characters to replace.
+ * @param[in] input The characters replacing the range.
+ * @param[in] i_n The length of @a input.
+ *
+ * @warning Intended for internal use.
+ *
+ * @allocation Always.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_replace_range_grow(rapidstring *s, size_t index, size_t n,
+				  const char *input, size_t i_n);
+
+/**
+ * @brief Replaces every occurrence of characters.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] needle The characters to replace, which must not be empty.
+ * @param[in] replacement The characters replacing each @a needle.
+ * @returns The number of replacements.
+ *
+ * @note Identicle to rs_replace_all_n() with `strlen()`.
+ *
+ * @allocation When @a replacement is longer than @a needle and the result
+ * does not fit on the stack, or when @a s is shared.
+ *
+ * @complexity Linear in the length of @a s on average.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_replace_all(rapidstring *s, const char *needle,
+			     const char *replacement);
+
+/**
+ * @brief Replaces every occurrence of characters.
+ *
+ * Occurrences are found from left to right without overlapping. A
+ * replacement which is not longer than the needle is performed in place in a
+ * single pass. Otherwise the length of the result is computed first and the
+ * result is written into a single new buffer, or onto the stack if it fits.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] needle The characters to replace.
+ * @param[in] n The length of @a needle, which must not be zero.
+ * @param[in] replacement The characters replacing each @a needle, which must
+ * not be within @a s.
+ * @param[in] r_n The length of @a replacement.
+ * @returns The number of replacements.
+ *
+ * @allocation When @a r_n is greater than @a n and the result does not fit
+ * on the stack, or when @a s is shared.
+ *
+ * @complexity Linear in the length of @a s on average.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_replace_all_n(rapidstring *s, const char *needle, size_t n,
+			       const char *replacement, size_t r_n);
+
+/**
+ * @brief Replaces every occurrence of a view.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] needle The view to replace, which must not be empty.
+ * @param[in] replacement The view replacing each @a needle.
+ * @returns The number of replacements.
+ *
+ * @note Identicle to rs_replace_all_n() with the data and size of both views.
+ *
+ * @allocation When @a replacement is longer than @a needle and the result
+ * does not fit on the stack, or when @a s is shared.
+ *
+ * @complexity Linear in the length of @a s on average.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_replace_all_v(rapidstring *s, rs_view needle,
+			       rs_view replacement);
+
+/**
+ * @brief Replaces every occurrence of characters with longer characters.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] needle The characters to replace.
+ * @param[in] n The length of @a needle.
+ * @param[in] replacement The characters replacing each @a needle.
+ * @param[in] r_n The length of @a replacement.
+ * @returns The number of replacements.
+ *
+ * @warning Intended for internal use.
+ *
+ * @allocation When the result does not fit on the stack.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_replace_all_grow(rapidstring *s, const char *needle,
+				  size_t n, const char *replacement,
+				  size_t r_n);
+
+/**
+ * @brief Removes all characters from a stack string.
+ *
+ * @param[out] s An initialized stack string.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant.
+ *
+ * @since 1.0.0
  */
 RS_API void rs_stack_clear(rapidstring *s);
 
@@ -991,7 +1971,7 @@ RS_API void rs_stack_resize(rapidstring *s, size_t n);
  * @warning The new size must be smaller or equal to the capacity of @a s. If
  * this is inconvenient for your usage, use rs_resize().
  *
- * @allocation Never.
+ * @allocation When @a s is frozen.
  *
  * @complexity Constant.
  *
@@ -1079,6 +2059,22 @@ RS_API void rs_heap_init(rapidstring *s, size_t n);
  */
 RS_API void rs_heap_init_g(rapidstring *s, size_t n);
 
+/**
+ * @brief Initializes the heap with an allocator.
+ *
+ * @param[out] s A string to initialize.
+ * @param[in] n The heap capacity.
+ * @param[in] a The allocator of @a s.
+ *
+ * @warning Intended for internal use.
+ *
+ * @allocation Always.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_heap_init_alloc(rapidstring *s, size_t n,
+			       const rs_allocator *a);
+
 /**
  * @brief Moves a stack string to the heap.
  *
@@ -1113,7 +2109,8 @@ RS_API void rs_stack_to_heap_g(rapidstring *s, size_t n);
  * @brief Reallocates the heap buffer.
  *
  * Grows or shrinks the heap capacity. The size will remain the same, even if
- * the new capacity is smaller than the current size.
+ * the new capacity is smaller than the current size. A frozen string receives
+ * a private buffer.
  *
  * @param[in,out] s An initialized heap string.
  * @param[in] n The new heap capacity.
@@ -1134,404 +2131,11308 @@ RS_API void rs_realloc(rapidstring *s, size_t n);
  *
  * @warning Intended for internal use.
  *
- * @allocation When @a n is greater than the capacity of @a s.
+ * @allocation When @a n is greater than the capacity of @a s, or @a s is
+ * frozen.
  *
  * @since 1.0.0
  */
 RS_API void rs_grow_heap(rapidstring *s, size_t n);
 
-/** @} */
+/**
+ * @brief Frees the heap buffer.
+ *
+ * @param[in] s An initialized heap string.
+ *
+ * @warning Intended for internal use.
+ *
+ * @allocation Never.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_heap_free(rapidstring *s);
 
-/*
- * ===============================================================
+/**
+ * @brief Drops the first characters of a heap string without moving the
+ * others.
  *
- *                   CONSTRUCTION & DESTRUCTION
+ * The buffer is advanced past the dropped characters. The total offset from
+ * the start of the allocation is stored in the dropped characters as seven
+ * bit groups read backwards, which always fit.
  *
- * ===============================================================
+ * @param[in,out] s An initialized heap string that is not shared.
+ * @param[in] n The number of characters to drop.
+ *
+ * @warning Intended for internal use.
+ *
+ * @allocation Never.
+ *
+ * @since 1.1.0
  */
+RS_API void rs_heap_skip(rapidstring *s, size_t n);
 
-RS_API void rs_init(rapidstring *s)
-{
-	assert(s != NULL);
+/**
+ * @brief Gets the offset of a heap buffer from the start of its allocation.
+ *
+ * @param[in] s An initialized heap string.
+ * @returns The number of characters dropped by rs_heap_skip().
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_heap_offset(const rapidstring *s);
 
+/**
+ * @brief Moves the characters of a heap string back to the start of its
+ * allocation.
+ *
+ * @param[in,out] s An initialized heap string dropping characters.
+ * @param[in] n The number of characters to move, zero if they are about to
+ * be overwritten.
+ *
+ * @warning Intended for internal use.
+ *
+ * @allocation Never.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_heap_rebase(rapidstring *s, size_t n);
+
+/** @} */
+
+/*
+ * ===============================================================
+ *
+ *                              ARENA
+ *
+ * ===============================================================
+ */
+
+/**
+ * @defgroup arena Arena
+ * Bump allocator for heap buffers that are all freed at once.
+ * @{
+ */
+
+/**
+ * @brief Block of memory owned by an #rs_arena.
+ *
+ * The data of the block immediately follows this struct.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+typedef struct rs_arena_block {
+	/** @brief The previously allocated block. */
+	struct rs_arena_block *next;
+	/** @brief Number of bytes of data in the block. */
+	size_t capacity;
+	/** @brief Number of bytes of data handed out. */
+	size_t used;
+} rs_arena_block;
+
+/**
+ * @brief Arena allocator.
+ *
+ * Hands out heap buffers by bumping a pointer within large blocks. The last
+ * buffer handed out is grown and shrunk in place, which makes a string being
+ * built in the arena grow without any copies as long as it fits in the block.
+ * Freeing a string owned by an arena is a no-op, unless it is the last buffer
+ * handed out. All memory is reclaimed at once with rs_arena_reset().
+ *
+ * Strings use an arena through its #rs_allocator:
+ * ```c
+ * rs_init_w_alloc(&s, rs_arena_alloc(&arena));
+ * ```
+ *
+ * @warning An arena may not be moved or copied once initialized, as its
+ * allocator refers to it.
+ *
+ * @since 1.1.0
+ */
+typedef struct {
+	/** @brief The allocator handing out buffers from this arena. */
+	rs_allocator allocator;
+	/** @brief The current block, or `NULL` if none were allocated. */
+	rs_arena_block *head;
+	/** @brief The last buffer handed out from the current block. */
+	char *last;
+	/** @brief The minimal size of a block. */
+	size_t block_size;
+} rs_arena;
+
+/**
+ * @brief Initializes an arena.
+ *
+ * @param[out] a The arena to initialize.
+ * @param[in] block_size The minimal size of the blocks allocated by @a a.
+ * Buffers larger than this size are given their own block.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_arena_init(rs_arena *a, size_t block_size);
+
+/**
+ * @brief Returns the allocator of an arena.
+ *
+ * @param[in] a An initialized arena.
+ * @returns The allocator handing out buffers from @a a.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant.
+ *
+ * @since 1.1.0
+ */
+RS_API const rs_allocator *rs_arena_alloc(rs_arena *a);
+
+/**
+ * @brief Reclaims all memory handed out by an arena.
+ *
+ * All strings owned by the arena are in an invalid state after resetting, and
+ * need not be freed. The current block is kept for future allocations, all
+ * others are freed.
+ *
+ * @param[in,out] a An initialized arena.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the number of blocks.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_arena_reset(rs_arena *a);
+
+/**
+ * @brief Frees an arena.
+ *
+ * All strings owned by the arena are in an invalid state after freeing. You
+ * must call rs_arena_init() if you wish to reuse the same arena.
+ *
+ * @param[in] a The arena to free.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the number of blocks.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_arena_free(rs_arena *a);
+
+/**
+ * @brief Allocates a buffer from an arena.
+ *
+ * @param[in,out] ctx An initialized arena.
+ * @param[in] n The size of the buffer.
+ * @returns The buffer.
+ *
+ * @warning Intended for internal use.
+ *
+ * @allocation When @a n is greater than the space left in the current block.
+ *
+ * @since 1.1.0
+ */
+RS_API void *rs_arena_allocate(void *ctx, size_t n);
+
+/**
+ * @brief Resizes a buffer allocated from an arena.
+ *
+ * The buffer is resized in place when it is the last buffer handed out and
+ * the current block has enough space.
+ *
+ * @param[in,out] ctx An initialized arena.
+ * @param[in] p The buffer to resize.
+ * @param[in] old_n The size of @a p.
+ * @param[in] n The new size of @a p.
+ * @returns The resized buffer.
+ *
+ * @warning Intended for internal use.
+ *
+ * @allocation When @a p cannot be resized in place and @a n is greater than
+ * the space left in the current block.
+ *
+ * @since 1.1.0
+ */
+RS_API void *rs_arena_reallocate(void *ctx, void *p, size_t old_n, size_t n);
+
+/**
+ * @brief Deallocates a buffer allocated from an arena.
+ *
+ * Only the last buffer handed out is reclaimed, all others are reclaimed by
+ * rs_arena_reset().
+ *
+ * @param[in,out] ctx An initialized arena.
+ * @param[in] p The buffer to deallocate.
+ * @param[in] n The size of @a p.
+ *
+ * @warning Intended for internal use.
+ *
+ * @allocation Never.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_arena_deallocate(void *ctx, void *p, size_t n);
+
+/** @} */
+
+/*
+ * ===============================================================
+ *
+ *                              POOL
+ *
+ * ===============================================================
+ */
+
+/**
+ * @defgroup pool Pool
+ * Optional thread local pool allocator for heap buffers.
+ *
+ * Defining `RS_POOL` before including this header makes RS_MALLOC(),
+ * RS_REALLOC() and RS_FREE() use these functions instead of the system
+ * allocator. Buffers are rounded up to size classes of a power of two plus one
+ * byte, so that a heap string whose capacity is a power of two fills its class
+ * with its null terminator. The #rs_pool_header preceding each buffer is not
+ * counted in its class. Buffers are recycled through free lists local to each
+ * thread. A buffer freed on another thread than the one which allocated it is
+ * handed back through a lock free list, from which any thread may recycle it
+ * once its own free list is empty.
+ *
+ * The pool is static, therefore each translation unit including this header
+ * has its own. Buffers may still be freed in any translation unit.
+ * @{
+ */
+
+#ifdef RS_POOL
+
+#if !defined(RS_THREAD_LOCAL) || defined(RS_NO_ATOMICS)
+#error "RS_POOL requires thread local storage and atomic operations."
+#endif
+
+#ifndef RS_POOL_MIN_SHIFT
+/**
+ * @brief Base two logarithm of the smallest pooled size class.
+ *
+ * @since 1.1.0
+ */
+#define RS_POOL_MIN_SHIFT (6)
+#endif
+
+#ifndef RS_POOL_MAX_SHIFT
+/**
+ * @brief Base two logarithm of the largest pooled size class.
+ *
+ * Larger buffers are directly allocated with `malloc()`.
+ *
+ * @since 1.1.0
+ */
+#define RS_POOL_MAX_SHIFT (20)
+#endif
+
+#ifndef RS_POOL_CACHE
+/**
+ * @brief Maximal number of free buffers kept by a thread per size class.
+ *
+ * @since 1.1.0
+ */
+#define RS_POOL_CACHE (64)
+#endif
+
+#ifndef RS_POOL_DEPOT
+/**
+ * @brief Maximal number of buffers handed back between threads per size
+ * class.
+ *
+ * Buffers freed on another thread once this many are waiting are directly
+ * freed.
+ *
+ * @since 1.1.0
+ */
+#define RS_POOL_DEPOT (256)
+#endif
+
+/**
+ * @brief Number of pooled size classes.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+#define RS_POOL_CLASSES (RS_POOL_MAX_SHIFT - RS_POOL_MIN_SHIFT + 1)
+
+/**
+ * @brief Header preceding every buffer allocated by the pool.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+typedef union {
+	struct {
+		/** @brief The pool of the thread which allocated the buffer. */
+		void *owner;
+		/** @brief The size class, or #RS_POOL_CLASSES if unpooled. */
+		size_t cls;
+	} info;
+	/** @brief Keeps buffers aligned like `malloc()`. */
+	rs_align_dummy align;
+} rs_pool_header;
+
+/**
+ * @brief Free lists of a thread.
+ *
+ * Free buffers are linked through their first bytes.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+typedef struct {
+	/** @brief Free buffers of each size class. */
+	void *lists[RS_POOL_CLASSES];
+	/** @brief Number of free buffers of each size class. */
+	size_t counts[RS_POOL_CLASSES];
+} rs_pool;
+
+/**
+ * @brief Allocates a buffer from the pool.
+ *
+ * @param[in] n The size of the buffer.
+ * @returns The buffer.
+ *
+ * @allocation When no free buffer of the size class of @a n is available.
+ *
+ * @since 1.1.0
+ */
+RS_API void *rs_pool_malloc(size_t n);
+
+/**
+ * @brief Resizes a buffer allocated from the pool.
+ *
+ * The buffer is returned as is if @a n fits in its size class.
+ *
+ * @param[in] p The buffer to resize, may be `NULL`.
+ * @param[in] n The new size of the buffer.
+ * @returns The resized buffer.
+ *
+ * @allocation When @a n does not fit in the size class of @a p and no free
+ * buffer of the new size class is available.
+ *
+ * @since 1.1.0
+ */
+RS_API void *rs_pool_realloc(void *p, size_t n);
+
+/**
+ * @brief Returns a buffer to the pool.
+ *
+ * The buffer is kept by the current thread if it allocated it, handed back to
+ * the other threads if not, and freed when the current thread already keeps
+ * #RS_POOL_CACHE buffers of its size class or #RS_POOL_DEPOT buffers of its
+ * size class are already handed back.
+ *
+ * @param[in] p The buffer to free, may be `NULL`.
+ *
+ * @allocation Never.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_pool_free(void *p);
+
+/**
+ * @brief Frees all buffers kept by the current thread.
+ *
+ * Should be called before a thread exits, as the buffers it keeps are
+ * otherwise leaked. Buffers handed back by other threads are freed as well.
+ *
+ * @allocation Never.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_pool_flush(void);
+
+/**
+ * @brief Returns the size class of a buffer.
+ *
+ * @param[in] n The size of the buffer, excluding its #rs_pool_header.
+ * @returns The size class of @a n, or #RS_POOL_CLASSES if unpooled.
+ *
+ * @complexity Constant.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_pool_class(size_t n);
+
+#endif /* RS_POOL */
+
+/** @} */
+
+/*
+ * ===============================================================
+ *
+ *                             SEARCH
+ *
+ * ===============================================================
+ */
+
+/**
+ * @defgroup search Search
+ * Functions that search a string for characters or substrings.
+ * @{
+ */
+
+/**
+ * @brief Value returned by search functions when nothing is found.
+ *
+ * @since 1.1.0
+ */
+#define RS_NPOS ((size_t)-1)
+
+/**
+ * @brief Finds the first occurrence of characters.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] needle The characters to find.
+ * @returns The index of the first occurrence of @a needle, or #RS_NPOS.
+ *
+ * @note Identicle to rs_find_n() with `strlen()`.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of @a s times the length of @a needle in
+ * the worst case, linear in the length of @a s on average.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_find(const rapidstring *s, const char *needle);
+
+/**
+ * @brief Finds the first occurrence of characters.
+ *
+ * Candidates are filtered by comparing the first and last characters of
+ * @a needle with entire vectors, and only then compared.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] needle The characters to find.
+ * @param[in] n The length of @a needle.
+ * @returns The index of the first occurrence of @a needle, or #RS_NPOS. An
+ * empty @a needle is found at index `0`.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of @a s times @a n in the worst case,
+ * linear in the length of @a s on average.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_find_n(const rapidstring *s, const char *needle, size_t n);
+
+/**
+ * @brief Finds the first occurrence of a string.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] needle The string to find.
+ * @returns The index of the first occurrence of @a needle, or #RS_NPOS.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of @a s times the length of @a needle in
+ * the worst case, linear in the length of @a s on average.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_find_rs(const rapidstring *s, const rapidstring *needle);
+
+/**
+ * @brief Finds the first occurrence of a view.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] needle The view to find.
+ * @returns The index of the first occurrence of @a needle, or #RS_NPOS.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of @a s times the size of @a needle in
+ * the worst case, linear in the length of @a s on average.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_find_v(const rapidstring *s, rs_view needle);
+
+/**
+ * @brief Finds the last occurrence of characters.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] needle The characters to find.
+ * @returns The index of the last occurrence of @a needle, or #RS_NPOS.
+ *
+ * @note Identicle to rs_rfind_n() with `strlen()`.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of @a s times the length of @a needle in
+ * the worst case, linear in the length of @a s on average.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_rfind(const rapidstring *s, const char *needle);
+
+/**
+ * @brief Finds the last occurrence of characters.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] needle The characters to find.
+ * @param[in] n The length of @a needle.
+ * @returns The index of the last occurrence of @a needle, or #RS_NPOS. An
+ * empty @a needle is found at the length of @a s.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of @a s times @a n in the worst case,
+ * linear in the length of @a s on average.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_rfind_n(const rapidstring *s, const char *needle, size_t n);
+
+/**
+ * @brief Finds the last occurrence of a string.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] needle The string to find.
+ * @returns The index of the last occurrence of @a needle, or #RS_NPOS.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of @a s times the length of @a needle in
+ * the worst case, linear in the length of @a s on average.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_rfind_rs(const rapidstring *s, const rapidstring *needle);
+
+/**
+ * @brief Finds the last occurrence of a view.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] needle The view to find.
+ * @returns The index of the last occurrence of @a needle, or #RS_NPOS.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of @a s times the size of @a needle in
+ * the worst case, linear in the length of @a s on average.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_rfind_v(const rapidstring *s, rs_view needle);
+
+/**
+ * @brief Finds the first occurrence of a character.
+ *
+ * Stack strings are searched with a single pass over the entire union.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] c The character to find.
+ * @returns The index of the first occurrence of @a c, or #RS_NPOS.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of @a s.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_find_char(const rapidstring *s, char c);
+
+/**
+ * @brief Finds the last occurrence of a character.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] c The character to find.
+ * @returns The index of the last occurrence of @a c, or #RS_NPOS.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of @a s.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_rfind_char(const rapidstring *s, char c);
+
+/**
+ * @brief Counts the non-overlapping occurrences of characters.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] needle The characters to count.
+ * @returns The number of occurrences of @a needle.
+ *
+ * @note Identicle to rs_count_n() with `strlen()`.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of @a s times the length of @a needle in
+ * the worst case, linear in the length of @a s on average.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_count(const rapidstring *s, const char *needle);
+
+/**
+ * @brief Counts the non-overlapping occurrences of characters.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] needle The characters to count.
+ * @param[in] n The length of @a needle.
+ * @returns The number of occurrences of @a needle, or `0` if @a n is `0`.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of @a s times @a n in the worst case,
+ * linear in the length of @a s on average.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_count_n(const rapidstring *s, const char *needle, size_t n);
+
+/**
+ * @brief Counts the non-overlapping occurrences of a view.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] needle The view to count.
+ * @returns The number of occurrences of @a needle, or `0` if it is empty.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of @a s times the size of @a needle in
+ * the worst case, linear in the length of @a s on average.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_count_v(const rapidstring *s, rs_view needle);
+
+/**
+ * @brief Counts the occurrences of a character.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] c The character to count.
+ * @returns The number of occurrences of @a c.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of @a s.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_count_char(const rapidstring *s, char c);
+
+/**
+ * @brief Finds the first occurrence of a character in a buffer.
+ *
+ * @param[in] buffer The buffer to search.
+ * @param[in] len The length of @a buffer.
+ * @param[in] c The character to find.
+ * @returns The index of the first occurrence of @a c, or #RS_NPOS.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_memchr(const char *buffer, size_t len, char c);
+
+/**
+ * @brief Finds the last occurrence of a character in a buffer.
+ *
+ * @param[in] buffer The buffer to search.
+ * @param[in] len The length of @a buffer.
+ * @param[in] c The character to find.
+ * @returns The index of the last occurrence of @a c, or #RS_NPOS.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_memrchr(const char *buffer, size_t len, char c);
+
+/**
+ * @brief Finds the first occurrence of characters in a buffer.
+ *
+ * @param[in] buffer The buffer to search.
+ * @param[in] len The length of @a buffer.
+ * @param[in] needle The characters to find.
+ * @param[in] n The length of @a needle.
+ * @returns The index of the first occurrence of @a needle, or #RS_NPOS.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_memmem(const char *buffer, size_t len, const char *needle,
+			size_t n);
+
+/**
+ * @brief Finds the last occurrence of characters in a buffer.
+ *
+ * @param[in] buffer The buffer to search.
+ * @param[in] len The length of @a buffer.
+ * @param[in] needle The characters to find.
+ * @param[in] n The length of @a needle.
+ * @returns The index of the last occurrence of @a needle, or #RS_NPOS.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_memrmem(const char *buffer, size_t len, const char *needle,
+			 size_t n);
+
+/**
+ * @brief Counts the occurrences of a character in a buffer.
+ *
+ * @param[in] buffer The buffer to search.
+ * @param[in] len The length of @a buffer.
+ * @param[in] c The character to count.
+ * @returns The number of occurrences of @a c.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_memcount(const char *buffer, size_t len, char c);
+
+/**
+ * @brief Returns the number of trailing zero bits.
+ *
+ * @param[in] mask A mask that is not `0`.
+ * @returns The index of the lowest set bit of @a mask.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned int rs_ctz(unsigned int mask);
+
+/**
+ * @brief Returns the index of the highest set bit.
+ *
+ * @param[in] mask A mask that is not `0`.
+ * @returns The index of the highest set bit of @a mask.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned int rs_bsr(unsigned int mask);
+
+/**
+ * @brief Returns the number of set bits.
+ *
+ * @param[in] mask A mask.
+ * @returns The number of set bits in @a mask.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned int rs_popcount(unsigned int mask);
+
+/** @} */
+
+/*
+ * ===============================================================
+ *
+ *                             COMPARE
+ *
+ * ===============================================================
+ */
+
+/**
+ * @defgroup compare Compare
+ * Functions that compare strings for equality or ordering.
+ * @{
+ */
+
+/**
+ * @brief Compares a string with characters.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] input The characters to compare with.
+ * @returns A value smaller than, equal to or greater than `0` if @a s is
+ * respectively ordered before, equal to or after @a input.
+ *
+ * @note Identicle to rs_cmp_n() with `strlen()`.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of the shortest string.
+ *
+ * @since 1.1.0
+ */
+RS_API int rs_cmp(const rapidstring *s, const char *input);
+
+/**
+ * @brief Compares a string with characters.
+ *
+ * Characters are compared as `unsigned char`, like `memcmp()`. When one
+ * string is a prefix of the other, the shortest string is ordered first.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] input The characters to compare with.
+ * @param[in] n The length of @a input.
+ * @returns A value smaller than, equal to or greater than `0` if @a s is
+ * respectively ordered before, equal to or after @a input.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of the shortest string.
+ *
+ * @since 1.1.0
+ */
+RS_API int rs_cmp_n(const rapidstring *s, const char *input, size_t n);
+
+/**
+ * @brief Compares two strings.
+ *
+ * Two stack strings are compared with vectors loaded over their entire
+ * union.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] input The string to compare with.
+ * @returns A value smaller than, equal to or greater than `0` if @a s is
+ * respectively ordered before, equal to or after @a input.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of the shortest string.
+ *
+ * @since 1.1.0
+ */
+RS_API int rs_cmp_rs(const rapidstring *s, const rapidstring *input);
+
+/**
+ * @brief Compares a string with a view.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] input The view to compare with.
+ * @returns A value smaller than, equal to or greater than `0` if @a s is
+ * respectively ordered before, equal to or after @a input.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of the shortest string.
+ *
+ * @since 1.1.0
+ */
+RS_API int rs_cmp_v(const rapidstring *s, rs_view input);
+
+/**
+ * @brief Checks whether a string is equal to characters.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] input The characters to compare with.
+ * @returns `1` if they are equal, `0` otherwise.
+ *
+ * @note Identicle to rs_eq_n() with `strlen()`.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of @a s.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_eq(const rapidstring *s, const char *input);
+
+/**
+ * @brief Checks whether a string is equal to characters.
+ *
+ * The lengths are compared before any character.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] input The characters to compare with.
+ * @param[in] n The length of @a input.
+ * @returns `1` if they are equal, `0` otherwise.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant if the lengths differ, linear in @a n otherwise.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_eq_n(const rapidstring *s, const char *input,
+			     size_t n);
+
+/**
+ * @brief Checks whether two strings are equal.
+ *
+ * The lengths are compared before any character. Two stack strings are
+ * compared with vectors loaded over their entire union.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] input The string to compare with.
+ * @returns `1` if they are equal, `0` otherwise.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant if the lengths differ, linear in the length of @a s
+ * otherwise.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_eq_rs(const rapidstring *s, const rapidstring *input);
+
+/**
+ * @brief Checks whether a string is equal to a view.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] input The view to compare with.
+ * @returns `1` if they are equal, `0` otherwise.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant if the lengths differ, linear in the size of @a input
+ * otherwise.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_eq_v(const rapidstring *s, rs_view input);
+
+/**
+ * @brief Checks whether a string starts with characters.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] prefix The characters to check for.
+ * @returns `1` if @a s starts with @a prefix, `0` otherwise.
+ *
+ * @note Identicle to rs_starts_with_n() with `strlen()`.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of @a prefix.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_starts_with(const rapidstring *s, const char *prefix);
+
+/**
+ * @brief Checks whether a string starts with characters.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] prefix The characters to check for.
+ * @param[in] n The length of @a prefix.
+ * @returns `1` if @a s starts with @a prefix, `0` otherwise. Every string
+ * starts with an empty @a prefix.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in @a n.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_starts_with_n(const rapidstring *s, const char *prefix,
+				      size_t n);
+
+/**
+ * @brief Checks whether a string starts with another string.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] prefix The string to check for.
+ * @returns `1` if @a s starts with @a prefix, `0` otherwise.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of @a prefix.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_starts_with_rs(const rapidstring *s,
+				       const rapidstring *prefix);
+
+/**
+ * @brief Checks whether a string starts with a view.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] prefix The view to check for.
+ * @returns `1` if @a s starts with @a prefix, `0` otherwise.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the size of @a prefix.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_starts_with_v(const rapidstring *s, rs_view prefix);
+
+/**
+ * @brief Checks whether a string ends with characters.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] suffix The characters to check for.
+ * @returns `1` if @a s ends with @a suffix, `0` otherwise.
+ *
+ * @note Identicle to rs_ends_with_n() with `strlen()`.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of @a suffix.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_ends_with(const rapidstring *s, const char *suffix);
+
+/**
+ * @brief Checks whether a string ends with characters.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] suffix The characters to check for.
+ * @param[in] n The length of @a suffix.
+ * @returns `1` if @a s ends with @a suffix, `0` otherwise. Every string ends
+ * with an empty @a suffix.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in @a n.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_ends_with_n(const rapidstring *s, const char *suffix,
+				    size_t n);
+
+/**
+ * @brief Checks whether a string ends with another string.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] suffix The string to check for.
+ * @returns `1` if @a s ends with @a suffix, `0` otherwise.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of @a suffix.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_ends_with_rs(const rapidstring *s,
+				     const rapidstring *suffix);
+
+/**
+ * @brief Checks whether a string ends with a view.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] suffix The view to check for.
+ * @returns `1` if @a s ends with @a suffix, `0` otherwise.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the size of @a suffix.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_ends_with_v(const rapidstring *s, rs_view suffix);
+
+/**
+ * @brief Compares two buffers.
+ *
+ * @param[in] a The first buffer.
+ * @param[in] b The second buffer.
+ * @param[in] n The length of both buffers.
+ * @returns A value smaller than, equal to or greater than `0` if @a a is
+ * respectively ordered before, equal to or after @a b.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API int rs_memcmp(const char *a, const char *b, size_t n);
+
+/**
+ * @brief Checks whether two buffers are equal.
+ *
+ * @param[in] a The first buffer.
+ * @param[in] b The second buffer.
+ * @param[in] n The length of both buffers.
+ * @returns `1` if they are equal, `0` otherwise.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_memeq(const char *a, const char *b, size_t n);
+
+/** @} */
+
+/*
+ * ===============================================================
+ *
+ *                              HASH
+ *
+ * ===============================================================
+ */
+
+/**
+ * @defgroup hash Hash
+ * Functions that hash strings.
+ *
+ * The hash is a fast 64 bit non-cryptographic hash. Its values may change
+ * between versions and architectures, and should not be persisted.
+ * @{
+ */
+
+/**
+ * @brief Hashes a string.
+ *
+ * @param[in] s An initialized string.
+ * @returns The hash of @a s.
+ *
+ * @note Identicle to rs_hash_seed() with a seed of `0`.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of @a s.
+ *
+ * @since 1.1.0
+ */
+RS_API uint64_t rs_hash(const rapidstring *s);
+
+/**
+ * @brief Hashes a string with a seed.
+ *
+ * A stack string is masked to its length with vectors loaded over its entire
+ * union and hashed in three multiply-mix rounds. The result is always equal
+ * to that of rs_hash_seed_n() with the same characters.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] seed The seed of the hash. A random seed makes it harder to
+ * find colliding strings.
+ * @returns The hash of @a s.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of @a s.
+ *
+ * @since 1.1.0
+ */
+RS_API uint64_t rs_hash_seed(const rapidstring *s, uint64_t seed);
+
+/**
+ * @brief Hashes characters.
+ *
+ * @param[in] input The characters to hash.
+ * @param[in] n The length of @a input.
+ * @returns The hash of @a input.
+ *
+ * @note Identicle to rs_hash_seed_n() with a seed of `0`.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in @a n.
+ *
+ * @since 1.1.0
+ */
+RS_API uint64_t rs_hash_n(const char *input, size_t n);
+
+/**
+ * @brief Hashes characters with a seed.
+ *
+ * Up to #RS_HASH_STRIPE characters are hashed in three multiply-mix rounds.
+ * Longer inputs are accumulated in stripes of #RS_HASH_STRIPE characters,
+ * which are vectorized when possible.
+ *
+ * @param[in] input The characters to hash.
+ * @param[in] n The length of @a input.
+ * @param[in] seed The seed of the hash.
+ * @returns The hash of @a input.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in @a n.
+ *
+ * @since 1.1.0
+ */
+RS_API uint64_t rs_hash_seed_n(const char *input, size_t n, uint64_t seed);
+
+/**
+ * @brief Hashes a view.
+ *
+ * @param[in] input The view to hash.
+ * @returns The hash of @a input.
+ *
+ * @note Identicle to rs_hash_n() with the same characters.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the size of @a input.
+ *
+ * @since 1.1.0
+ */
+RS_API uint64_t rs_hash_v(rs_view input);
+
+/**
+ * @brief Number of 64 bit lanes of a hash stripe.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+#define RS_HASH_LANES (4)
+
+/**
+ * @brief Number of characters of a hash stripe.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+#define RS_HASH_STRIPE (RS_HASH_LANES * 8)
+
+/**
+ * @brief Hashes at most #RS_HASH_STRIPE characters.
+ *
+ * @param[in] w The characters to hash, zero padded into words.
+ * @param[in] n The number of characters.
+ * @param[in] seed The seed of the hash.
+ * @returns The hash of the characters.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API uint64_t rs_hash_short(const uint64_t *w, size_t n, uint64_t seed);
+
+/**
+ * @brief Hashes characters, optionally folding them to lowercase.
+ *
+ * @param[in] input The characters to hash.
+ * @param[in] n The length of @a input.
+ * @param[in] seed The seed of the hash.
+ * @param[in] fold Whether ASCII uppercase letters are hashed as lowercase.
+ * @returns The hash of @a input.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API uint64_t rs_hash_fold_n(const char *input, size_t n, uint64_t seed,
+			       unsigned char fold);
+
+/**
+ * @brief Hashes a stack string, optionally folding it to lowercase.
+ *
+ * @param[in] s An initialized stack string.
+ * @param[in] seed The seed of the hash.
+ * @param[in] fold Whether ASCII uppercase letters are hashed as lowercase.
+ * @returns The hash of @a s.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API uint64_t rs_hash_stack(const rapidstring *s, uint64_t seed,
+			      unsigned char fold);
+
+/**
+ * @brief Hashes more than #RS_HASH_STRIPE characters.
+ *
+ * @param[in] input The characters to hash.
+ * @param[in] n The length of @a input.
+ * @param[in] seed The seed of the hash.
+ * @param[in] fold Whether ASCII uppercase letters are hashed as lowercase.
+ * @returns The hash of @a input.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API uint64_t rs_hash_long(const char *input, size_t n, uint64_t seed,
+			     unsigned char fold);
+
+/**
+ * @brief Accumulates stripes of characters into the hash lanes.
+ *
+ * @param[in,out] acc The #RS_HASH_LANES accumulators.
+ * @param[in] key The #RS_HASH_LANES keys.
+ * @param[in] input The characters to accumulate.
+ * @param[in] stripes The number of stripes of @a input.
+ * @param[in] fold Whether ASCII uppercase letters are hashed as lowercase.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_hash_accumulate(uint64_t *acc, const uint64_t *key,
+			       const char *input, size_t stripes,
+			       unsigned char fold);
+
+/**
+ * @brief Scrambles the hash lanes.
+ *
+ * Prevents the accumulators from degenerating on long inputs.
+ *
+ * @param[in,out] acc The #RS_HASH_LANES accumulators.
+ * @param[in] key The #RS_HASH_LANES keys.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_hash_scramble(uint64_t *acc, const uint64_t *key);
+
+/**
+ * @brief Multiplies two words and folds the 128 bit product.
+ *
+ * @param[in] a The first word.
+ * @param[in] b The second word.
+ * @returns The low half of the product xor its high half.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API uint64_t rs_mix(uint64_t a, uint64_t b);
+
+/**
+ * @brief Reads an unaligned word.
+ *
+ * @param[in] p The characters to read.
+ * @returns The word in native byte order.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API uint64_t rs_read64(const char *p);
+
+/** @} */
+
+/*
+ * ===============================================================
+ *
+ *                             INTERN
+ *
+ * ===============================================================
+ */
+
+/**
+ * @defgroup intern Intern
+ * Table deduplicating strings into 32 bit handles.
+ *
+ * Every distinct string is stored once in the table, and interning equal
+ * strings always returns the same handle. Handles may therefore be compared
+ * instead of strings. Handles are consecutive, starting at `0`, and remain
+ * valid until the table is freed, as do the buffers of interned strings.
+ *
+ * @code
+ * rs_intern_table t;
+ * rs_intern_init(&t);
+ *
+ * const uint32_t a = rs_intern(&t, "host");
+ * const uint32_t b = rs_intern_n(&t, "hostname", 4);
+ *
+ * assert(a == b);
+ * assert(strcmp(rs_intern_data(&t, a), "host") == 0);
+ *
+ * rs_intern_free(&t);
+ * @endcode
+ * @{
+ */
+
+#ifndef RS_INTERN_CHUNK
+/**
+ * @brief Size of the chunks interned strings are packed into.
+ *
+ * Strings larger than half a chunk are allocated on their own.
+ *
+ * @since 1.1.0
+ */
+#define RS_INTERN_CHUNK (4096)
+#endif
+
+/**
+ * @brief Value returned by rs_intern_find_n() when nothing is found.
+ *
+ * @since 1.1.0
+ */
+#define RS_INTERN_NONE ((uint32_t)-1)
+
+/**
+ * @brief Interned string.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+typedef struct {
+	/** @brief Null terminated buffer of the string. */
+	const char *data;
+	/** @brief Number of characters of the string. */
+	size_t size;
+} rs_intern_entry;
+
+/**
+ * @brief Slot of the hash table of an #rs_intern_table.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+typedef struct {
+	/** @brief Handle of the string plus one, `0` if the slot is empty. */
+	uint32_t id;
+	/** @brief Low bits of the hash of the string. */
+	uint32_t hash;
+} rs_intern_slot;
+
+/**
+ * @brief Table of interned strings.
+ *
+ * @since 1.1.0
+ */
+typedef struct {
+	/** @brief Arena owning the chunks. */
+	rs_arena arena;
+	/** @brief Free space of the current chunk. */
+	char *chunk;
+	/** @brief Number of characters left in the current chunk. */
+	size_t left;
+	/** @brief Strings indexed by handle. */
+	rs_intern_entry *entries;
+	/** @brief Number of strings. */
+	size_t size;
+	/** @brief Capacity of @a entries. */
+	size_t capacity;
+	/** @brief Open addressing hash table of handles. */
+	rs_intern_slot *slots;
+	/** @brief Number of slots minus one, `0` if there are none. */
+	size_t mask;
+} rs_intern_table;
+
+/**
+ * @brief Initializes an intern table.
+ *
+ * @param[out] t The table to initialize.
+ *
+ * @allocation Never.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_intern_init(rs_intern_table *t);
+
+/**
+ * @brief Frees an intern table.
+ *
+ * All handles and buffers of interned strings are invalidated. You must call
+ * rs_intern_init() if you wish to reuse the same table.
+ *
+ * @param[in,out] t An initialized table.
+ *
+ * @complexity Linear in the number of chunks.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_intern_free(rs_intern_table *t);
+
+/**
+ * @brief Interns characters.
+ *
+ * @param[in,out] t An initialized table.
+ * @param[in] input The characters to intern.
+ * @returns The handle of @a input.
+ *
+ * @note Identicle to rs_intern_n() with `strlen()`.
+ *
+ * @allocation When @a input is not yet interned and the table must grow.
+ *
+ * @complexity Linear in the length of @a input on average.
+ *
+ * @since 1.1.0
+ */
+RS_API uint32_t rs_intern(rs_intern_table *t, const char *input);
+
+/**
+ * @brief Interns characters.
+ *
+ * The characters are only copied if they are not yet interned.
+ *
+ * @param[in,out] t An initialized table.
+ * @param[in] input The characters to intern.
+ * @param[in] n The length of @a input.
+ * @returns The handle of @a input.
+ *
+ * @allocation When @a input is not yet interned and the table must grow.
+ *
+ * @complexity Linear in @a n on average.
+ *
+ * @since 1.1.0
+ */
+RS_API uint32_t rs_intern_n(rs_intern_table *t, const char *input, size_t n);
+
+/**
+ * @brief Interns a string.
+ *
+ * @param[in,out] t An initialized table.
+ * @param[in] input The string to intern.
+ * @returns The handle of @a input.
+ *
+ * @allocation When @a input is not yet interned and the table must grow.
+ *
+ * @complexity Linear in the length of @a input on average.
+ *
+ * @since 1.1.0
+ */
+RS_API uint32_t rs_intern_rs(rs_intern_table *t, const rapidstring *input);
+
+/**
+ * @brief Interns a view.
+ *
+ * @param[in,out] t An initialized table.
+ * @param[in] input The view to intern.
+ * @returns The handle of @a input.
+ *
+ * @allocation When @a input is not yet interned and the table must grow.
+ *
+ * @complexity Linear in the size of @a input on average.
+ *
+ * @since 1.1.0
+ */
+RS_API uint32_t rs_intern_v(rs_intern_table *t, rs_view input);
+
+/**
+ * @brief Finds the handle of characters without interning them.
+ *
+ * @param[in] t An initialized table.
+ * @param[in] input The characters to find.
+ * @param[in] n The length of @a input.
+ * @returns The handle of @a input, or #RS_INTERN_NONE if it is not interned.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in @a n on average.
+ *
+ * @since 1.1.0
+ */
+RS_API uint32_t rs_intern_find_n(const rs_intern_table *t, const char *input,
+				 size_t n);
+
+/**
+ * @brief Gets the buffer of an interned string.
+ *
+ * @param[in] t An initialized table.
+ * @param[in] id A handle returned by this table.
+ * @returns The null terminated buffer of the string.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant.
+ *
+ * @since 1.1.0
+ */
+RS_API const char *rs_intern_data(const rs_intern_table *t, uint32_t id);
+
+/**
+ * @brief Gets the length of an interned string.
+ *
+ * @param[in] t An initialized table.
+ * @param[in] id A handle returned by this table.
+ * @returns The length of the string.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_intern_len(const rs_intern_table *t, uint32_t id);
+
+/**
+ * @brief Gets the number of strings of an intern table.
+ *
+ * @param[in] t An initialized table.
+ * @returns The number of distinct strings interned.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_intern_size(const rs_intern_table *t);
+
+/**
+ * @brief Interns characters of a known hash.
+ *
+ * @param[in,out] t An initialized table.
+ * @param[in] input The characters to intern.
+ * @param[in] n The length of @a input.
+ * @param[in] hash The hash of @a input.
+ * @returns The handle of @a input.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API uint32_t rs_intern_insert(rs_intern_table *t, const char *input,
+				 size_t n, uint64_t hash);
+
+/**
+ * @brief Finds the slot of characters of a known hash.
+ *
+ * @param[in] t An initialized table with at least one empty slot.
+ * @param[in] input The characters to find.
+ * @param[in] n The length of @a input.
+ * @param[in] hash The low bits of the hash of @a input.
+ * @returns The slot of @a input, or the empty slot where it belongs.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API rs_intern_slot *rs_intern_probe(const rs_intern_table *t,
+				       const char *input, size_t n,
+				       uint32_t hash);
+
+/**
+ * @brief Doubles the number of slots of an intern table.
+ *
+ * @param[in,out] t An initialized table.
+ *
+ * @warning Intended for internal use.
+ *
+ * @allocation Always.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_intern_grow(rs_intern_table *t);
+
+/**
+ * @brief Copies characters into the chunks of an intern table.
+ *
+ * @param[in,out] t An initialized table.
+ * @param[in] input The characters to copy.
+ * @param[in] n The length of @a input.
+ * @returns The null terminated copy of @a input.
+ *
+ * @warning Intended for internal use.
+ *
+ * @allocation When the current chunk is full or @a n is larger than half a
+ * chunk.
+ *
+ * @since 1.1.0
+ */
+RS_API const char *rs_intern_store(rs_intern_table *t, const char *input,
+				   size_t n);
+
+/** @} */
+
+/*
+ * ===============================================================
+ *
+ *                              VIEW
+ *
+ * ===============================================================
+ */
+
+/**
+ * @defgroup view View
+ * Functions that create views of strings and characters.
+ *
+ * The state of a string is only checked when a view of it is created, after
+ * which its characters and length are accessed directly. A view is
+ * invalidated by any function which may reallocate or free the string.
+ * @{
+ */
+
+/**
+ * @brief Creates a view of characters.
+ *
+ * @param[in] input The characters to view.
+ * @param[in] n The length of @a input.
+ * @returns The view of @a input.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant.
+ *
+ * @since 1.1.0
+ */
+RS_API rs_view rs_view_n(const char *input, size_t n);
+
+/**
+ * @brief Creates a view of a string.
+ *
+ * @param[in] s An initialized string.
+ * @returns The view of @a s.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant.
+ *
+ * @since 1.1.0
+ */
+RS_API rs_view rs_view_rs(const rapidstring *s);
+
+/**
+ * @brief Creates a view of a substring.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] pos The index of the first character. Must not be greater than
+ * the length of @a s.
+ * @param[in] n The maximal length of the view. The view ends at the end of
+ * @a s if @a n is too large, such as #RS_NPOS.
+ * @returns The view of the substring.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant.
+ *
+ * @since 1.1.0
+ */
+RS_API rs_view rs_substr_view(const rapidstring *s, size_t pos, size_t n);
+
+/**
+ * @brief Creates a view of a part of a view.
+ *
+ * @param[in] v A view.
+ * @param[in] pos The index of the first character. Must not be greater than
+ * the size of @a v.
+ * @param[in] n The maximal size of the view. The view ends at the end of
+ * @a v if @a n is too large, such as #RS_NPOS.
+ * @returns The view of the part of @a v.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant.
+ *
+ * @since 1.1.0
+ */
+RS_API rs_view rs_view_substr(rs_view v, size_t pos, size_t n);
+
+/** @} */
+
+/*
+ * ===============================================================
+ *
+ *                             SHARED
+ *
+ * ===============================================================
+ */
+
+/**
+ * @defgroup shared Shared
+ * Immutable heap strings shared through an atomic reference count.
+ *
+ * Once frozen, copying a heap string with rs_init_w_rs() or rs_cpy_rs() only
+ * increments the reference count of its buffer, and rs_free() decrements it.
+ * The buffer is freed along with the last string sharing it. Copies may be
+ * handed to other threads, as the count is updated atomically when the
+ * compiler supports it.
+ *
+ * Every function modifying a frozen string first gives it a private copy of
+ * the buffer, as rs_thaw() does, so the other strings sharing the buffer are
+ * never affected. The characters of a frozen string must however not be
+ * modified through rs_data(), which does not copy the buffer. Stack strings
+ * are never shared, as copying them is already cheap.
+ * @{
+ */
+
+/**
+ * @brief Freezes a string into an immutable shared buffer.
+ *
+ * The buffer is moved behind a reference count and shrunk to fit. Does
+ * nothing to stack strings or strings which are already frozen. An
+ * #rs_allocator of the string is kept.
+ *
+ * @param[in,out] s An initialized string.
+ *
+ * @allocation When @a s is on the heap and not yet frozen.
+ *
+ * @complexity Linear in the length of @a s when it is not yet frozen,
+ * constant otherwise.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_freeze(rapidstring *s);
+
+/**
+ * @brief Thaws a frozen string so it may be modified.
+ *
+ * The string receives a private copy of the buffer, and releases its
+ * reference to the shared buffer. Does nothing to strings which are not
+ * frozen.
+ *
+ * @param[in,out] s An initialized string.
+ *
+ * @allocation When @a s is frozen.
+ *
+ * @complexity Linear in the length of @a s when it is frozen, constant
+ * otherwise.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_thaw(rapidstring *s);
+
+/**
+ * @brief Checks whether a string is frozen.
+ *
+ * @param[in] s An initialized string.
+ * @returns `1` if @a s shares a frozen buffer, `0` otherwise.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_is_shared(const rapidstring *s);
+
+/**
+ * @brief Gets the number of strings sharing the buffer of a string.
+ *
+ * The count may already be outdated if other threads copy or free strings
+ * sharing the same buffer.
+ *
+ * @param[in] s An initialized string.
+ * @returns The number of strings sharing the buffer of @a s, or `1` if @a s
+ * is not frozen.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant.
+ *
+ * @since 1.1.0
+ */
+RS_API long rs_shared_refs(const rapidstring *s);
+
+/**
+ * @brief Replaces the frozen buffer of a heap string by a private buffer.
+ *
+ * The private buffer is allocated with the allocator of the string, and
+ * receives as many characters of the shared buffer as it can hold.
+ *
+ * @param[in,out] s A frozen string.
+ * @param[in] n The capacity of the private buffer.
+ *
+ * @warning Intended for internal use.
+ *
+ * @allocation Always.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_heap_unshare(rapidstring *s, size_t n);
+
+/** @} */
+
+/*
+ * ===============================================================
+ *
+ *                              ROPE
+ *
+ * ===============================================================
+ */
+
+/**
+ * @defgroup rope Rope
+ * Balanced tree of strings for large incremental edits.
+ *
+ * A rope stores its characters in #rapidstring leaves of at most
+ * #RS_ROPE_LEAF characters, joined by an AVL tree. Appending, inserting,
+ * erasing and splitting only copy the characters of a few leaves instead of
+ * the entire buffer. Small leaves remain on the stack. Use rs_rope_flatten()
+ * once a contiguous buffer is needed.
+ *
+ * @code
+ * rs_rope r;
+ * rs_rope_init(&r);
+ *
+ * rs_rope_cat(&r, "world");
+ * rs_rope_insert_n(&r, 0, "hello ", 6);
+ *
+ * rapidstring s;
+ * rs_init(&s);
+ * rs_rope_flatten(&r, &s);
+ *
+ * rs_free(&s);
+ * rs_rope_free(&r);
+ * @endcode
+ * @{
+ */
+
+#ifndef RS_ROPE_LEAF
+/**
+ * @brief Maximal number of characters of a rope leaf.
+ *
+ * Larger leaves make traversals faster, but each edit copies up to this many
+ * characters.
+ *
+ * @since 1.1.0
+ */
+#define RS_ROPE_LEAF (1024)
+#endif
+
+/**
+ * @brief Node of an #rs_rope.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+typedef struct rs_rope_node {
+	/** @brief Number of characters of the subtree. */
+	size_t len;
+	/** @brief Height of the subtree, `1` for leaves. */
+	size_t height;
+	/** @brief Children of an inner node, or string of a leaf. */
+	union {
+		/** @brief Children of an inner node. */
+		struct {
+			/** @brief The characters before those of @a right. */
+			struct rs_rope_node *left;
+			/** @brief The characters after those of @a left. */
+			struct rs_rope_node *right;
+		} node;
+		/** @brief String of a leaf. */
+		rapidstring leaf;
+	} u;
+} rs_rope_node;
+
+/**
+ * @brief Rope of characters.
+ *
+ * @since 1.1.0
+ */
+typedef struct {
+	/** @brief Root of the tree, `NULL` if the rope is empty. */
+	rs_rope_node *root;
+} rs_rope;
+
+/**
+ * @brief Initializes an empty rope.
+ *
+ * @param[out] r The rope to initialize.
+ *
+ * @allocation Never.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_rope_init(rs_rope *r);
+
+/**
+ * @brief Frees a rope.
+ *
+ * You must call rs_rope_init() if you wish to reuse the same rope.
+ *
+ * @param[in,out] r An initialized rope.
+ *
+ * @complexity Linear in the number of leaves.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_rope_free(rs_rope *r);
+
+/**
+ * @brief Gets the length of a rope.
+ *
+ * @param[in] r An initialized rope.
+ * @returns The number of characters of @a r.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_rope_len(const rs_rope *r);
+
+/**
+ * @brief Gets a character of a rope.
+ *
+ * @param[in] r An initialized rope.
+ * @param[in] i The index of the character, smaller than the length of @a r.
+ * @returns The character at index @a i.
+ *
+ * @allocation Never.
+ *
+ * @complexity Logarithmic in the length of @a r.
+ *
+ * @since 1.1.0
+ */
+RS_API char rs_rope_at(const rs_rope *r, size_t i);
+
+/**
+ * @brief Appends characters to a rope.
+ *
+ * @param[in,out] r An initialized rope.
+ * @param[in] input The characters to append.
+ *
+ * @note Identicle to rs_rope_cat_n() with `strlen()`.
+ *
+ * @allocation When the last leaf must grow, or new leaves are needed.
+ *
+ * @complexity Logarithmic in the length of @a r, plus linear in the length
+ * of @a input.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_rope_cat(rs_rope *r, const char *input);
+
+/**
+ * @brief Appends characters to a rope.
+ *
+ * The last leaf is filled before new leaves are joined to the tree.
+ *
+ * @param[in,out] r An initialized rope.
+ * @param[in] input The characters to append.
+ * @param[in] n The length of @a input.
+ *
+ * @allocation When the last leaf must grow, or new leaves are needed.
+ *
+ * @complexity Logarithmic in the length of @a r, plus linear in @a n.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_rope_cat_n(rs_rope *r, const char *input, size_t n);
+
+/**
+ * @brief Appends a string to a rope.
+ *
+ * @param[in,out] r An initialized rope.
+ * @param[in] input The string to append.
+ *
+ * @allocation When the last leaf must grow, or new leaves are needed.
+ *
+ * @complexity Logarithmic in the length of @a r, plus linear in the length
+ * of @a input.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_rope_cat_rs(rs_rope *r, const rapidstring *input);
+
+/**
+ * @brief Appends a rope to another rope.
+ *
+ * The nodes of @a input are moved into @a r, leaving @a input empty.
+ *
+ * @param[in,out] r An initialized rope.
+ * @param[in,out] input The rope to append.
+ *
+ * @allocation Always, unless either rope is empty or both are small leaves.
+ *
+ * @complexity Logarithmic in the length of both ropes.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_rope_cat_rope(rs_rope *r, rs_rope *input);
+
+/**
+ * @brief Inserts characters into a rope.
+ *
+ * The characters are inserted into the leaf holding @a index if it has room
+ * for them, so repeated small insertions do not add a leaf each.
+ *
+ * @param[in,out] r An initialized rope.
+ * @param[in] index The index to insert at, not greater than the length of
+ * @a r.
+ * @param[in] input The characters to insert.
+ * @param[in] n The length of @a input.
+ *
+ * @allocation When the leaf holding @a index has no room for @a n characters
+ * or must move to the heap.
+ *
+ * @complexity Logarithmic in the length of @a r, plus linear in @a n and
+ * #RS_ROPE_LEAF.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_rope_insert_n(rs_rope *r, size_t index, const char *input,
+			     size_t n);
+
+/**
+ * @brief Erases characters from a rope.
+ *
+ * @param[in,out] r An initialized rope.
+ * @param[in] index The index of the first character to erase.
+ * @param[in] n The number of characters to erase.
+ *
+ * @allocation When a leaf is split.
+ *
+ * @complexity Logarithmic in the length of @a r, plus linear in the number
+ * of leaves erased.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_rope_erase(rs_rope *r, size_t index, size_t n);
+
+/**
+ * @brief Splits a rope in two.
+ *
+ * @param[in,out] r An initialized rope, which keeps the characters before
+ * @a index.
+ * @param[in] index The index to split at, not greater than the length of
+ * @a r.
+ * @param[out] out A rope to initialize with the characters from @a index.
+ *
+ * @allocation When a leaf is split.
+ *
+ * @complexity Logarithmic in the length of @a r.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_rope_split(rs_rope *r, size_t index, rs_rope *out);
+
+/**
+ * @brief Copies a substring of a rope into a string.
+ *
+ * Overwrites any existing data.
+ *
+ * @param[in] r An initialized rope.
+ * @param[in] index The index of the first character, not greater than the
+ * length of @a r.
+ * @param[in] n The maximal number of characters to copy.
+ * @param[in,out] s An initialized string.
+ *
+ * @allocation When the substring is greater than the capacity of @a s.
+ *
+ * @complexity Logarithmic in the length of @a r, plus linear in @a n.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_rope_substr(const rs_rope *r, size_t index, size_t n,
+			   rapidstring *s);
+
+/**
+ * @brief Copies a rope into a string.
+ *
+ * Overwrites any existing data.
+ *
+ * @param[in] r An initialized rope.
+ * @param[in,out] s An initialized string.
+ *
+ * @allocation When the length of @a r is greater than the capacity of @a s.
+ *
+ * @complexity Linear in the length of @a r.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_rope_flatten(const rs_rope *r, rapidstring *s);
+
+/**
+ * @brief Creates a leaf.
+ *
+ * @param[in] input The characters of the leaf.
+ * @param[in] n The length of @a input, at most #RS_ROPE_LEAF.
+ * @returns The leaf.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API rs_rope_node *rs_rope_leaf(const char *input, size_t n);
+
+/**
+ * @brief Creates a balanced tree of leaves.
+ *
+ * @param[in] input The characters of the tree.
+ * @param[in] n The length of @a input, greater than `0`.
+ * @returns The root of the tree.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API rs_rope_node *rs_rope_build(const char *input, size_t n);
+
+/**
+ * @brief Frees a tree.
+ *
+ * @param[in] t The root of the tree, may be `NULL`.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_rope_free_node(rs_rope_node *t);
+
+/**
+ * @brief Updates the length and height of an inner node.
+ *
+ * @param[in,out] t An inner node.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_rope_update(rs_rope_node *t);
+
+/**
+ * @brief Rotates an inner node to the left.
+ *
+ * @param[in,out] t An inner node whose right child is an inner node.
+ * @returns The new root of the subtree.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API rs_rope_node *rs_rope_rotate_left(rs_rope_node *t);
+
+/**
+ * @brief Rotates an inner node to the right.
+ *
+ * @param[in,out] t An inner node whose left child is an inner node.
+ * @returns The new root of the subtree.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API rs_rope_node *rs_rope_rotate_right(rs_rope_node *t);
+
+/**
+ * @brief Joins two balanced trees with an inner node.
+ *
+ * @param[in] l The left tree.
+ * @param[in] mid An unused node which becomes an inner node.
+ * @param[in] r The right tree.
+ * @returns The root of the balanced tree.
+ *
+ * @warning Intended for internal use.
+ *
+ * @complexity Linear in the difference between the heights of the trees.
+ *
+ * @since 1.1.0
+ */
+RS_API rs_rope_node *rs_rope_join3(rs_rope_node *l, rs_rope_node *mid,
+				   rs_rope_node *r);
+
+/**
+ * @brief Joins a tree into the right spine of a higher tree.
+ *
+ * @param[in] l The left tree, higher than @a r by more than one.
+ * @param[in] mid An unused node which becomes an inner node.
+ * @param[in] r The right tree.
+ * @returns The root of the balanced tree.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API rs_rope_node *rs_rope_join_right(rs_rope_node *l, rs_rope_node *mid,
+					rs_rope_node *r);
+
+/**
+ * @brief Joins a tree into the left spine of a higher tree.
+ *
+ * @param[in] l The left tree.
+ * @param[in] mid An unused node which becomes an inner node.
+ * @param[in] r The right tree, higher than @a l by more than one.
+ * @returns The root of the balanced tree.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API rs_rope_node *rs_rope_join_left(rs_rope_node *l, rs_rope_node *mid,
+				       rs_rope_node *r);
+
+/**
+ * @brief Joins two trees.
+ *
+ * Two leaves whose characters fit in a single leaf are merged.
+ *
+ * @param[in] l The left tree, may be `NULL`.
+ * @param[in] r The right tree, may be `NULL`.
+ * @returns The root of the balanced tree.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API rs_rope_node *rs_rope_join(rs_rope_node *l, rs_rope_node *r);
+
+/**
+ * @brief Splits a tree in two.
+ *
+ * The inner nodes on the path to @a index are reused to join the parts.
+ *
+ * @param[in] t The tree, may be `NULL`.
+ * @param[in] index The index to split at.
+ * @param[out] l The tree of the characters before @a index.
+ * @param[out] r The tree of the characters from @a index.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_rope_split_node(rs_rope_node *t, size_t index,
+			       rs_rope_node **l, rs_rope_node **r);
+
+/**
+ * @brief Copies characters of a tree.
+ *
+ * @param[in] t The tree.
+ * @param[in] index The index of the first character.
+ * @param[in] n The number of characters, which must all be in the tree.
+ * @param[out] out The buffer receiving the characters.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_rope_copy(const rs_rope_node *t, size_t index, size_t n,
+			 char *out);
+
+/** @} */
+
+/*
+ * ===============================================================
+ *
+ *                             NUMBER
+ *
+ * ===============================================================
+ */
+
+/**
+ * @defgroup number Number
+ * Formatting and parsing of numbers without intermediate buffers.
+ *
+ * The number of characters is computed up front, after which the digits are
+ * written directly into the buffer of the string, growing it at most once.
+ * Doubles are formatted with the Grisu2 algorithm, which always produces the
+ * shortest digits that round trip, except in rare cases where it produces a
+ * single extra digit.
+ *
+ * Parsing is bounded by the length of the input rather than a null
+ * terminator, does not depend on the locale, and validates and converts
+ * eight digits at a time. Every parsing function returns the number of
+ * characters consumed, or zero if the input does not start with a number
+ * within range, in which case the output is left untouched.
+ *
+ * @code
+ * rapidstring s;
+ * rs_init(&s);
+ *
+ * rs_cat(&s, "latency_ms ");
+ * rs_cat_double(&s, 0.25);
+ * rs_cat(&s, " ");
+ * rs_cat_u64(&s, 1510000000);
+ *
+ * rs_free(&s);
+ * @endcode
+ * @{
+ */
+
+/**
+ * @brief Maximal number of characters of a formatted double.
+ *
+ * @since 1.1.0
+ */
+#define RS_DTOA_MAX (25)
+
+/**
+ * @brief Concatenates the decimal representation of an unsigned integer.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] n The integer to format.
+ *
+ * @allocation When the number of digits of @a n is greater than the
+ * remaining capacity of @a s.
+ *
+ * @complexity Linear in the number of digits of @a n.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_cat_u64(rapidstring *s, uint64_t n);
+
+/**
+ * @brief Concatenates the decimal representation of a signed integer.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] n The integer to format.
+ *
+ * @allocation When the number of characters of @a n is greater than the
+ * remaining capacity of @a s.
+ *
+ * @complexity Linear in the number of digits of @a n.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_cat_i64(rapidstring *s, int64_t n);
+
+/**
+ * @brief Concatenates the lowercase hexadecimal representation of an
+ * unsigned integer.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] n The integer to format.
+ *
+ * @note No `0x` prefix is written.
+ *
+ * @allocation When the number of digits of @a n is greater than the
+ * remaining capacity of @a s.
+ *
+ * @complexity Linear in the number of digits of @a n.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_cat_hex(rapidstring *s, uint64_t n);
+
+/**
+ * @brief Concatenates the uppercase hexadecimal representation of an
+ * unsigned integer.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] n The integer to format.
+ *
+ * @note Identicle to rs_cat_hex() with uppercase digits.
+ *
+ * @allocation When the number of digits of @a n is greater than the
+ * remaining capacity of @a s.
+ *
+ * @complexity Linear in the number of digits of @a n.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_cat_hex_upper(rapidstring *s, uint64_t n);
+
+/**
+ * @brief Concatenates the shortest decimal representation of a double that
+ * round trips.
+ *
+ * Values with a decimal exponent from `-6` to `20` are written in fixed
+ * notation, such as `0.001` or `1500`, others in scientific notation, such as
+ * `1.5e+300`. Integral values are written without a fraction. Special values
+ * are written as `nan`, `inf` and `-inf`.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] n The double to format.
+ *
+ * @allocation When the number of characters of @a n is greater than the
+ * remaining capacity of @a s.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_cat_double(rapidstring *s, double n);
+
+/**
+ * @brief Computes the number of decimal digits of an unsigned integer.
+ *
+ * @param[in] n The integer.
+ *
+ * @returns The number of digits of @a n, at least `1`.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_u64_len(uint64_t n);
+
+/**
+ * @brief Writes the decimal digits of an unsigned integer.
+ *
+ * @param[out] buffer The buffer to write to.
+ * @param[in] n The integer.
+ * @param[in] len The number of digits of @a n.
+ *
+ * @warning Intended for internal use. No null terminator is written.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_u64_write(char *buffer, uint64_t n, size_t len);
+
+/**
+ * @brief Concatenates the hexadecimal representation of an unsigned integer.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] n The integer to format.
+ * @param[in] digits The sixteen hexadecimal digits to use.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_cat_hex_digits(rapidstring *s, uint64_t n, const char *digits);
+
+/**
+ * @brief Writes the shortest decimal representation of a double.
+ *
+ * @param[out] buffer A buffer of at least #RS_DTOA_MAX characters.
+ * @param[in] n The double.
+ *
+ * @returns The number of characters written.
+ *
+ * @warning Intended for internal use. No null terminator is written.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_dtoa(char *buffer, double n);
+
+/**
+ * @brief Generates the digits of a positive, finite double with Grisu2.
+ *
+ * @param[out] buffer A buffer of at least `17` characters.
+ * @param[in] n The double, greater than zero.
+ * @param[out] k The decimal exponent of the last digit.
+ *
+ * @returns The number of digits written.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API int rs_grisu2(char *buffer, double n, int *k);
+
+/**
+ * @brief Lays out digits in fixed or scientific notation.
+ *
+ * @param[in,out] buffer A buffer of at least #RS_DTOA_MAX characters,
+ * starting with the digits.
+ * @param[in] len The number of digits.
+ * @param[in] k The decimal exponent of the last digit.
+ *
+ * @returns The number of characters of the representation.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_dtoa_format(char *buffer, int len, int k);
+
+/**
+ * @brief Floating point number with a 64 bit significand.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+typedef struct {
+	/** @brief The significand. */
+	uint64_t f;
+	/** @brief The binary exponent. */
+	int e;
+} rs_diy_fp;
+
+/**
+ * @brief Multiplies two floating point numbers, rounding the significand.
+ *
+ * @param[in] x The first number.
+ * @param[in] y The second number.
+ *
+ * @returns The product of @a x and @a y.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API rs_diy_fp rs_diy_mul(rs_diy_fp x, rs_diy_fp y);
+
+/**
+ * @brief Finds a cached power of ten which brings a binary exponent into the
+ * range used for digit generation.
+ *
+ * @param[in] e The binary exponent.
+ * @param[out] k The negated decimal exponent of the power of ten.
+ *
+ * @returns The normalized power of ten.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API rs_diy_fp rs_cached_power(int e, int *k);
+
+/**
+ * @brief Moves the last generated digit closer to the exact value.
+ *
+ * @param[in,out] buffer The generated digits.
+ * @param[in] len The number of digits.
+ * @param[in] delta The distance between the boundaries.
+ * @param[in] rest The distance between the digits and the upper boundary.
+ * @param[in] ten_kappa The weight of the last digit.
+ * @param[in] wp_w The distance between the upper boundary and the value.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_grisu_round(char *buffer, int len, uint64_t delta,
+			   uint64_t rest, uint64_t ten_kappa, uint64_t wp_w);
+
+/**
+ * @brief Generates the shortest digits between two boundaries.
+ *
+ * @param[in] w The scaled value.
+ * @param[in] mp The scaled upper boundary.
+ * @param[in] delta The distance between the boundaries.
+ * @param[out] buffer A buffer of at least `17` characters.
+ * @param[in,out] k The decimal exponent, adjusted by the position of the
+ * last digit.
+ *
+ * @returns The number of digits written.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API int rs_grisu_digits(rs_diy_fp w, rs_diy_fp mp, uint64_t delta,
+			   char *buffer, int *k);
+
+/**
+ * @brief Parses an unsigned integer from a string.
+ *
+ * @param[in] s The string to parse.
+ * @param[out] out The parsed integer.
+ *
+ * @returns The number of characters consumed, zero on failure.
+ *
+ * @note Identicle to rs_to_u64_n() with the data and length of @a s.
+ *
+ * @complexity Linear in the number of characters consumed.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_to_u64(const rapidstring *s, uint64_t *out);
+
+/**
+ * @brief Parses an unsigned integer from characters.
+ *
+ * The input must start with a decimal digit. Parsing stops at the first
+ * character that is not a digit, and fails if the value does not fit into
+ * 64 bits.
+ *
+ * @param[in] input The characters to parse.
+ * @param[in] n The length of @a input.
+ * @param[out] out The parsed integer.
+ *
+ * @returns The number of characters consumed, zero on failure.
+ *
+ * @complexity Linear in the number of characters consumed.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_to_u64_n(const char *input, size_t n, uint64_t *out);
+
+/**
+ * @brief Parses an unsigned integer from a view.
+ *
+ * @param[in] input The view to parse.
+ * @param[out] out The parsed integer.
+ *
+ * @returns The number of characters consumed, zero on failure.
+ *
+ * @note Identicle to rs_to_u64_n() with the data and size of @a input.
+ *
+ * @complexity Linear in the number of characters consumed.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_to_u64_v(rs_view input, uint64_t *out);
+
+/**
+ * @brief Parses a signed integer from a string.
+ *
+ * @param[in] s The string to parse.
+ * @param[out] out The parsed integer.
+ *
+ * @returns The number of characters consumed, zero on failure.
+ *
+ * @note Identicle to rs_to_i64_n() with the data and length of @a s.
+ *
+ * @complexity Linear in the number of characters consumed.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_to_i64(const rapidstring *s, int64_t *out);
+
+/**
+ * @brief Parses a signed integer from characters.
+ *
+ * The input must start with a decimal digit, optionally preceded by `-` or
+ * `+`. Parsing stops at the first character that is not a digit, and fails
+ * if the value does not fit into 64 bits.
+ *
+ * @param[in] input The characters to parse.
+ * @param[in] n The length of @a input.
+ * @param[out] out The parsed integer.
+ *
+ * @returns The number of characters consumed, zero on failure.
+ *
+ * @complexity Linear in the number of characters consumed.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_to_i64_n(const char *input, size_t n, int64_t *out);
+
+/**
+ * @brief Parses a signed integer from a view.
+ *
+ * @param[in] input The view to parse.
+ * @param[out] out The parsed integer.
+ *
+ * @returns The number of characters consumed, zero on failure.
+ *
+ * @note Identicle to rs_to_i64_n() with the data and size of @a input.
+ *
+ * @complexity Linear in the number of characters consumed.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_to_i64_v(rs_view input, int64_t *out);
+
+/**
+ * @brief Parses a double from a string.
+ *
+ * @param[in] s The string to parse.
+ * @param[out] out The parsed double.
+ *
+ * @returns The number of characters consumed, zero on failure.
+ *
+ * @note Identicle to rs_to_double_n() with the data and length of @a s.
+ *
+ * @complexity Linear in the number of characters consumed.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_to_double(const rapidstring *s, double *out);
+
+/**
+ * @brief Parses a double from characters.
+ *
+ * The input is an optional `-` or `+`, followed by decimal digits with an
+ * optional `.` and fraction, and an optional exponent such as `e-7`. The
+ * values `inf` and `nan` written by rs_cat_double() are accepted as well.
+ * The result is correctly rounded.
+ *
+ * @param[in] input The characters to parse.
+ * @param[in] n The length of @a input.
+ * @param[out] out The parsed double.
+ *
+ * @returns The number of characters consumed, zero on failure.
+ *
+ * @allocation When the input has more than `19` significant digits or an
+ * exponent too large to be exact, and is longer than #RS_STACK_CAPACITY.
+ *
+ * @complexity Linear in the number of characters consumed.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_to_double_n(const char *input, size_t n, double *out);
+
+/**
+ * @brief Parses a double from a view.
+ *
+ * @param[in] input The view to parse.
+ * @param[out] out The parsed double.
+ *
+ * @returns The number of characters consumed, zero on failure.
+ *
+ * @note Identicle to rs_to_double_n() with the data and size of @a input.
+ *
+ * @complexity Linear in the number of characters consumed.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_to_double_v(rs_view input, double *out);
+
+/**
+ * @brief Checks whether eight characters are all decimal digits.
+ *
+ * @param[in] w The characters, read with rs_read64().
+ *
+ * @returns `1` if all characters are digits, `0` otherwise.
+ *
+ * @warning Intended for internal use. Assumes a little endian machine.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_is_eight_digits(uint64_t w);
+
+/**
+ * @brief Converts eight decimal digits to an integer.
+ *
+ * @param[in] w The digits, read with rs_read64().
+ *
+ * @returns The value of the digits.
+ *
+ * @warning Intended for internal use. Assumes a little endian machine.
+ *
+ * @since 1.1.0
+ */
+RS_API uint64_t rs_parse_eight_digits(uint64_t w);
+
+/**
+ * @brief Accumulates decimal digits into an integer.
+ *
+ * @param[in] input The characters to parse.
+ * @param[in] n The length of @a input.
+ * @param[in,out] v The integer to accumulate into.
+ * @param[in] max The maximal number of digits to accumulate.
+ *
+ * @returns The number of digits accumulated.
+ *
+ * @warning Intended for internal use. Overflow is not detected.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_parse_digits(const char *input, size_t n, uint64_t *v,
+			      size_t max);
+
+/**
+ * @brief Parses a double with the C library.
+ *
+ * @param[in] input The characters of a valid double.
+ * @param[in] n The length of @a input.
+ *
+ * @returns The parsed double.
+ *
+ * @warning Intended for internal use.
+ *
+ * @allocation When @a n is greater than #RS_STACK_CAPACITY.
+ *
+ * @since 1.1.0
+ */
+RS_API double rs_to_double_slow(const char *input, size_t n);
+
+/** @} */
+
+/*
+ * ===============================================================
+ *
+ *                              SPLIT
+ *
+ * ===============================================================
+ */
+
+/**
+ * @defgroup split Split
+ * Iteration over the fields of a string without copies.
+ *
+ * A split iterator yields views of the fields between separators directly
+ * from the buffer of the string, so splitting never allocates. Fields may be
+ * separated by a character, by any character of a set, or by a multi
+ * character separator. The string must not be modified while it is split.
+ *
+ * @code
+ * rapidstring s;
+ * rs_init_w(&s, "GET,/index.html,,HTTP/1.1");
+ *
+ * rs_split_iter it;
+ * rs_view field;
+ * rs_split_init_char(&it, &s, ',');
+ * rs_split_skip_empty(&it);
+ *
+ * while (rs_split_next(&it, &field))
+ * 	printf("%.*s\n", (int)field.size, field.data);
+ *
+ * rs_free(&s);
+ * @endcode
+ * @{
+ */
+
+/**
+ * @brief Fields are separated by a single character.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+#define RS_SPLIT_CHAR (0)
+
+/**
+ * @brief Fields are separated by any character of a set.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+#define RS_SPLIT_ANY (1)
+
+/**
+ * @brief Fields are separated by a sequence of characters.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+#define RS_SPLIT_STR (2)
+
+/**
+ * @brief Iterator over the fields of a string.
+ *
+ * @since 1.1.0
+ */
+typedef struct {
+	/** @brief The characters which remain to be split. */
+	const char *data;
+	/** @brief The number of characters which remain to be split. */
+	size_t size;
+	/** @brief The separator, or the set of separating characters. */
+	const char *sep;
+	/** @brief The length of @a sep. */
+	size_t sep_len;
+	/** @brief The maximal number of remaining fields, zero if unlimited. */
+	size_t limit;
+	/** @brief The separating character of #RS_SPLIT_CHAR. */
+	char c;
+	/** @brief One of #RS_SPLIT_CHAR, #RS_SPLIT_ANY or #RS_SPLIT_STR. */
+	unsigned char mode;
+	/** @brief Whether empty fields are skipped. */
+	unsigned char skip_empty;
+	/** @brief Whether the last field was yielded. */
+	unsigned char done;
+} rs_split_iter;
+
+/**
+ * @brief Initializes an iterator over the fields of a string separated by
+ * characters.
+ *
+ * @param[out] it An iterator to initialize.
+ * @param[in] s The string to split.
+ * @param[in] sep The separator, which must not be empty.
+ *
+ * @note Identicle to rs_split_init_n() with `strlen()`.
+ *
+ * @allocation Never.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_split_init(rs_split_iter *it, const rapidstring *s,
+			  const char *sep);
+
+/**
+ * @brief Initializes an iterator over the fields of a string separated by
+ * characters.
+ *
+ * @param[out] it An iterator to initialize.
+ * @param[in] s The string to split.
+ * @param[in] sep The separator, which must outlive @a it.
+ * @param[in] n The length of @a sep, which must not be zero.
+ *
+ * @allocation Never.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_split_init_n(rs_split_iter *it, const rapidstring *s,
+			    const char *sep, size_t n);
+
+/**
+ * @brief Initializes an iterator over the fields of a string separated by
+ * a character.
+ *
+ * @param[out] it An iterator to initialize.
+ * @param[in] s The string to split.
+ * @param[in] c The separating character.
+ *
+ * @allocation Never.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_split_init_char(rs_split_iter *it, const rapidstring *s,
+			       char c);
+
+/**
+ * @brief Initializes an iterator over the fields of a string separated by
+ * any character of a set.
+ *
+ * @param[out] it An iterator to initialize.
+ * @param[in] s The string to split.
+ * @param[in] set The separating characters.
+ *
+ * @note Identicle to rs_split_init_any_n() with `strlen()`.
+ *
+ * @allocation Never.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_split_init_any(rs_split_iter *it, const rapidstring *s,
+			      const char *set);
+
+/**
+ * @brief Initializes an iterator over the fields of a string separated by
+ * any character of a set.
+ *
+ * @param[out] it An iterator to initialize.
+ * @param[in] s The string to split.
+ * @param[in] set The separating characters, which must outlive @a it.
+ * @param[in] n The number of characters in @a set.
+ *
+ * @allocation Never.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_split_init_any_n(rs_split_iter *it, const rapidstring *s,
+				const char *set, size_t n);
+
+/**
+ * @brief Limits the number of remaining fields of an iterator.
+ *
+ * Once only one field remains, it contains the rest of the string including
+ * its separators.
+ *
+ * @param[in,out] it An initialized iterator.
+ * @param[in] n The maximal number of remaining fields, zero if unlimited.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_split_limit(rs_split_iter *it, size_t n);
+
+/**
+ * @brief Skips the empty fields of an iterator.
+ *
+ * Skipped fields do not count towards the limit of the iterator.
+ *
+ * @param[in,out] it An initialized iterator.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_split_skip_empty(rs_split_iter *it);
+
+/**
+ * @brief Yields the next field of an iterator.
+ *
+ * A string without separators has a single field, which is empty for an
+ * empty string. A trailing separator is followed by an empty field.
+ *
+ * @param[in,out] it An initialized iterator.
+ * @param[out] field A view of the next field within the string.
+ *
+ * @returns `1` if a field was yielded, `0` once all fields were yielded.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of the field and its separator.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_split_next(rs_split_iter *it, rs_view *field);
+
+/**
+ * @brief Initializes the common members of an iterator.
+ *
+ * @param[out] it An iterator to initialize.
+ * @param[in] s The string to split.
+ * @param[in] mode One of #RS_SPLIT_CHAR, #RS_SPLIT_ANY or #RS_SPLIT_STR.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_split_init_mode(rs_split_iter *it, const rapidstring *s,
+			       unsigned char mode);
+
+/**
+ * @brief Finds the first occurrence of any character of a set in a buffer.
+ *
+ * @param[in] buffer The buffer to search.
+ * @param[in] len The length of @a buffer.
+ * @param[in] set The characters to find.
+ * @param[in] n The number of characters in @a set.
+ * @returns The index of the first occurrence, or #RS_NPOS.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_memchr_any(const char *buffer, size_t len, const char *set,
+			    size_t n);
+
+/** @} */
+
+/*
+ * ===============================================================
+ *
+ *                              CASE
+ *
+ * ===============================================================
+ */
+
+/**
+ * @defgroup case Case
+ * Functions that convert or ignore the case of ASCII letters.
+ *
+ * Only the letters `A` to `Z` and `a` to `z` are affected, every other
+ * character, including those of multibyte UTF-8 sequences, is left as is.
+ * @{
+ */
+
+/**
+ * @brief Converts the uppercase ASCII letters of a string to lowercase.
+ *
+ * A stack string is converted with vectors loaded over its entire union.
+ *
+ * @param[in,out] s An initialized string.
+ *
+ * @allocation Only if @a s is shared.
+ *
+ * @complexity Linear in the length of @a s.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_to_lower(rapidstring *s);
+
+/**
+ * @brief Converts the lowercase ASCII letters of a string to uppercase.
+ *
+ * A stack string is converted with vectors loaded over its entire union.
+ *
+ * @param[in,out] s An initialized string.
+ *
+ * @allocation Only if @a s is shared.
+ *
+ * @complexity Linear in the length of @a s.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_to_upper(rapidstring *s);
+
+/**
+ * @brief Compares a string with characters, ignoring case.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] input The characters to compare with.
+ * @returns A value smaller than, equal to or greater than `0` if @a s is
+ * respectively ordered before, equal to or after @a input.
+ *
+ * @note Identicle to rs_cmp_icase_n() with `strlen()`.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of the shortest string.
+ *
+ * @since 1.1.0
+ */
+RS_API int rs_cmp_icase(const rapidstring *s, const char *input);
+
+/**
+ * @brief Compares a string with characters, ignoring case.
+ *
+ * The strings are ordered as if both were converted to lowercase with
+ * rs_to_lower(), without any copy being made.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] input The characters to compare with.
+ * @param[in] n The length of @a input.
+ * @returns A value smaller than, equal to or greater than `0` if @a s is
+ * respectively ordered before, equal to or after @a input.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of the shortest string.
+ *
+ * @since 1.1.0
+ */
+RS_API int rs_cmp_icase_n(const rapidstring *s, const char *input, size_t n);
+
+/**
+ * @brief Compares two strings, ignoring case.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] input The string to compare with.
+ * @returns A value smaller than, equal to or greater than `0` if @a s is
+ * respectively ordered before, equal to or after @a input.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of the shortest string.
+ *
+ * @since 1.1.0
+ */
+RS_API int rs_cmp_icase_rs(const rapidstring *s, const rapidstring *input);
+
+/**
+ * @brief Compares a string with a view, ignoring case.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] input The view to compare with.
+ * @returns A value smaller than, equal to or greater than `0` if @a s is
+ * respectively ordered before, equal to or after @a input.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of the shortest string.
+ *
+ * @since 1.1.0
+ */
+RS_API int rs_cmp_icase_v(const rapidstring *s, rs_view input);
+
+/**
+ * @brief Checks whether a string is equal to characters, ignoring case.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] input The characters to compare with.
+ * @returns `1` if they are equal, `0` otherwise.
+ *
+ * @note Identicle to rs_eq_icase_n() with `strlen()`.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of @a s.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_eq_icase(const rapidstring *s, const char *input);
+
+/**
+ * @brief Checks whether a string is equal to characters, ignoring case.
+ *
+ * The lengths are compared before any character.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] input The characters to compare with.
+ * @param[in] n The length of @a input.
+ * @returns `1` if they are equal, `0` otherwise.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant if the lengths differ, linear in @a n otherwise.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_eq_icase_n(const rapidstring *s, const char *input,
+				   size_t n);
+
+/**
+ * @brief Checks whether two strings are equal, ignoring case.
+ *
+ * The lengths are compared before any character. Two stack strings are
+ * compared with vectors loaded over their entire union.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] input The string to compare with.
+ * @returns `1` if they are equal, `0` otherwise.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant if the lengths differ, linear in the length of @a s
+ * otherwise.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_eq_icase_rs(const rapidstring *s,
+				    const rapidstring *input);
+
+/**
+ * @brief Checks whether a string is equal to a view, ignoring case.
+ *
+ * @param[in] s An initialized string.
+ * @param[in] input The view to compare with.
+ * @returns `1` if they are equal, `0` otherwise.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant if the lengths differ, linear in the size of @a input
+ * otherwise.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_eq_icase_v(const rapidstring *s, rs_view input);
+
+/**
+ * @brief Hashes a string, ignoring case.
+ *
+ * The characters are folded to lowercase as they are hashed, therefore the
+ * hash is equal to that of rs_hash() once @a s is converted with
+ * rs_to_lower().
+ *
+ * @param[in] s An initialized string.
+ * @returns The hash of @a s.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of @a s.
+ *
+ * @since 1.1.0
+ */
+RS_API uint64_t rs_hash_icase(const rapidstring *s);
+
+/**
+ * @brief Hashes characters, ignoring case.
+ *
+ * @param[in] input The characters to hash.
+ * @param[in] n The length of @a input.
+ * @returns The hash of @a input.
+ *
+ * @note Identicle to rs_hash_icase() for a string of the same characters.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in @a n.
+ *
+ * @since 1.1.0
+ */
+RS_API uint64_t rs_hash_icase_n(const char *input, size_t n);
+
+/**
+ * @brief Toggles the case of the characters of a buffer within a range.
+ *
+ * @param[in,out] buffer The buffer to convert.
+ * @param[in] n The length of @a buffer.
+ * @param[in] first The first character of the range.
+ * @param[in] last The last character of the range.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_memcase(char *buffer, size_t n, char first, char last);
+
+/**
+ * @brief Compares two buffers, ignoring case.
+ *
+ * @param[in] a The first buffer.
+ * @param[in] b The second buffer.
+ * @param[in] n The length of both buffers.
+ * @returns A value smaller than, equal to or greater than `0` if @a a is
+ * respectively ordered before, equal to or after @a b.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API int rs_memcmp_icase(const char *a, const char *b, size_t n);
+
+/**
+ * @brief Converts the uppercase ASCII letters of a word to lowercase.
+ *
+ * @param[in] w The word to convert.
+ * @returns The converted word.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API uint64_t rs_fold64(uint64_t w);
+
+/** @} */
+
+/*
+ * ===============================================================
+ *
+ *                              UTF-8
+ *
+ * ===============================================================
+ */
+
+/**
+ * @defgroup utf8 UTF-8
+ * Functions that validate and measure UTF-8 strings.
+ *
+ * Validation follows RFC 3629: overlong encodings, surrogates and code
+ * points past U+10FFFF are rejected.
+ * @{
+ */
+
+/**
+ * @brief Checks whether a string is valid UTF-8.
+ *
+ * The string is never modified, therefore it may be checked from several
+ * threads at once.
+ *
+ * @param[in] s An initialized string.
+ * @returns `1` if @a s is valid UTF-8, `0` otherwise.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant for a heap string remembered valid by
+ * rs_utf8_validate(), linear in the length of @a s otherwise.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_utf8_valid(const rapidstring *s);
+
+/**
+ * @brief Checks whether a string is valid UTF-8 and remembers a valid result.
+ *
+ * A valid heap string remembers its result until it is resized or
+ * rs_utf8_forget() is called, therefore checking it again with
+ * rs_utf8_valid() is constant.
+ *
+ * @param[in,out] s An initialized string.
+ * @returns `1` if @a s is valid UTF-8, `0` otherwise.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant for a heap string already found valid, linear in the
+ * length of @a s otherwise.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_utf8_validate(rapidstring *s);
+
+/**
+ * @brief Forgets a remembered rs_utf8_validate() result.
+ *
+ * Must be called after writing characters through rs_data() which may not
+ * be valid UTF-8, otherwise rs_utf8_valid() keeps reporting the string as
+ * valid.
+ *
+ * @param[in,out] s An initialized string.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_utf8_forget(rapidstring *s);
+
+/**
+ * @brief Checks whether characters are valid UTF-8.
+ *
+ * Vectors are loaded one, two and three characters behind to find the
+ * characters that must be continuations. Vectors of ASCII characters are
+ * skipped two at a time.
+ *
+ * @param[in] input The characters to check.
+ * @param[in] n The length of @a input.
+ * @returns `1` if @a input is valid UTF-8, `0` otherwise.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in @a n.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_utf8_valid_n(const char *input, size_t n);
+
+/**
+ * @brief Checks whether a view is valid UTF-8.
+ *
+ * @param[in] input The view to check.
+ * @returns `1` if @a input is valid UTF-8, `0` otherwise.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the size of @a input.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_utf8_valid_v(rs_view input);
+
+/**
+ * @brief Counts the code points of a string.
+ *
+ * @param[in] s An initialized string.
+ * @returns The number of code points of @a s.
+ *
+ * @note Identicle to rs_utf8_len_n() with the buffer of @a s.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of @a s.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_utf8_len(const rapidstring *s);
+
+/**
+ * @brief Counts the code points of characters.
+ *
+ * Every character that is not a continuation is counted, which is the number
+ * of code points of valid UTF-8.
+ *
+ * @param[in] input The characters to count.
+ * @param[in] n The length of @a input.
+ * @returns The number of code points of @a input.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in @a n.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_utf8_len_n(const char *input, size_t n);
+
+/**
+ * @brief Checks whether a string only contains ASCII characters.
+ *
+ * A stack string is checked with vectors loaded over its entire union.
+ *
+ * @param[in] s An initialized string.
+ * @returns `1` if @a s is ASCII, `0` otherwise.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the length of @a s.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_is_ascii(const rapidstring *s);
+
+/**
+ * @brief Checks whether characters are all ASCII.
+ *
+ * @param[in] input The characters to check.
+ * @param[in] n The length of @a input.
+ * @returns `1` if @a input is ASCII, `0` otherwise.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in @a n.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_is_ascii_n(const char *input, size_t n);
+
+/** @} */
+
+/*
+ * ===============================================================
+ *
+ *                            ENCODING
+ *
+ * ===============================================================
+ */
+
+/**
+ * @defgroup encoding Encoding
+ * Functions that encode binary data as text and decode it back.
+ *
+ * The exact length of the output is computed first, the string is grown
+ * once and the output is written directly into its buffer. Base64 uses the
+ * standard alphabet of RFC 4648 and hexadecimal encodes with lowercase
+ * digits.
+ * @{
+ */
+
+/**
+ * @brief Concatenates the base64 encoding of characters to a string.
+ *
+ * The output is padded with `=` to a multiple of four characters.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] input The characters to encode.
+ * @param[in] n The length of @a input.
+ *
+ * @allocation If the capacity of @a s is smaller than its length plus the
+ * length of the encoding.
+ *
+ * @complexity Linear in @a n.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_cat_base64_n(rapidstring *s, const char *input, size_t n);
+
+/**
+ * @brief Concatenates the base64 encoding of a view to a string.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] input The view to encode.
+ *
+ * @allocation If the capacity of @a s is smaller than its length plus the
+ * length of the encoding.
+ *
+ * @complexity Linear in the size of @a input.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_cat_base64_v(rapidstring *s, rs_view input);
+
+/**
+ * @brief Concatenates the decoding of base64 characters to a string.
+ *
+ * The padding is optional, but may only be found at the end of @a input.
+ * If any character is invalid, the length of @a s is left unchanged.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] input The characters to decode.
+ * @param[in] n The length of @a input.
+ * @returns `1` if @a input is valid base64, `0` otherwise.
+ *
+ * @allocation If the capacity of @a s is smaller than its length plus the
+ * length of the decoding.
+ *
+ * @complexity Linear in @a n.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_decode_base64_n(rapidstring *s, const char *input,
+					size_t n);
+
+/**
+ * @brief Concatenates the decoding of a base64 view to a string.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] input The view to decode.
+ * @returns `1` if @a input is valid base64, `0` otherwise.
+ *
+ * @allocation If the capacity of @a s is smaller than its length plus the
+ * length of the decoding.
+ *
+ * @complexity Linear in the size of @a input.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_decode_base64_v(rapidstring *s, rs_view input);
+
+/**
+ * @brief Concatenates the hexadecimal encoding of characters to a string.
+ *
+ * Each character is encoded as two digits, most significant first. Vectors
+ * of characters are split into digits and interleaved.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] input The characters to encode.
+ * @param[in] n The length of @a input.
+ *
+ * @note Unlike rs_cat_hex(), which formats a single number.
+ *
+ * @allocation If the capacity of @a s is smaller than its length plus twice
+ * @a n.
+ *
+ * @complexity Linear in @a n.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_cat_hex_n(rapidstring *s, const char *input, size_t n);
+
+/**
+ * @brief Concatenates the hexadecimal encoding of a view to a string.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] input The view to encode.
+ *
+ * @allocation If the capacity of @a s is smaller than its length plus twice
+ * the size of @a input.
+ *
+ * @complexity Linear in the size of @a input.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_cat_hex_v(rapidstring *s, rs_view input);
+
+/**
+ * @brief Concatenates the decoding of hexadecimal digits to a string.
+ *
+ * Both lowercase and uppercase digits are accepted. If @a n is odd or any
+ * digit is invalid, the length of @a s is left unchanged.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] input The digits to decode.
+ * @param[in] n The length of @a input.
+ * @returns `1` if @a input is valid hexadecimal, `0` otherwise.
+ *
+ * @allocation If the capacity of @a s is smaller than its length plus half
+ * of @a n.
+ *
+ * @complexity Linear in @a n.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_decode_hex_n(rapidstring *s, const char *input,
+				     size_t n);
+
+/**
+ * @brief Concatenates the decoding of a hexadecimal view to a string.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] input The view to decode.
+ * @returns `1` if @a input is valid hexadecimal, `0` otherwise.
+ *
+ * @allocation If the capacity of @a s is smaller than its length plus half
+ * the size of @a input.
+ *
+ * @complexity Linear in the size of @a input.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_decode_hex_v(rapidstring *s, rs_view input);
+
+/**
+ * @brief Encodes characters as base64.
+ *
+ * @param[out] buffer The output, of at least the encoded length.
+ * @param[in] input The characters to encode.
+ * @param[in] n The length of @a input.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_base64_encode(char *buffer, const char *input, size_t n);
+
+/**
+ * @brief Decodes base64 characters without padding.
+ *
+ * @param[out] buffer The output, of at least the decoded length.
+ * @param[in] input The characters to decode.
+ * @param[in] n The length of @a input, whose remainder by four is not one.
+ * @returns `1` if @a input is valid, `0` otherwise.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_base64_decode(char *buffer, const char *input,
+				      size_t n);
+
+/**
+ * @brief Encodes characters as hexadecimal digits.
+ *
+ * @param[out] buffer The output, of at least twice @a n.
+ * @param[in] input The characters to encode.
+ * @param[in] n The length of @a input.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_hex_encode(char *buffer, const char *input, size_t n);
+
+/**
+ * @brief Decodes hexadecimal digits.
+ *
+ * @param[out] buffer The output, of at least @a n.
+ * @param[in] input The digits to decode.
+ * @param[in] n The length of @a buffer, half the length of @a input.
+ * @returns `1` if @a input is valid, `0` otherwise.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_hex_decode(char *buffer, const char *input, size_t n);
+
+/**
+ * @brief Gets the value of a hexadecimal digit.
+ *
+ * @param[in] c The digit.
+ * @returns The value of @a c, or `-1` if it is not a digit.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API int rs_hex_value(char c);
+
+/** @} */
+
+/*
+ * ===============================================================
+ *
+ *                              TRIM
+ *
+ * ===============================================================
+ */
+
+/**
+ * @defgroup trim Trim
+ * Functions that remove the characters of a set from the ends of a string.
+ * @{
+ */
+
+/**
+ * @brief Whitespace characters of the C locale, for use as a trim set.
+ *
+ * @since 1.1.0
+ */
+#define RS_WHITESPACE " \t\n\v\f\r"
+
+/**
+ * @brief Removes the characters of a set from both ends of a string.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] set The characters to remove, such as #RS_WHITESPACE.
+ *
+ * @note Identicle to rs_trim_n() with `strlen()`.
+ *
+ * @allocation Only if @a s is shared.
+ *
+ * @complexity Linear in the number of characters removed.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_trim(rapidstring *s, const char *set);
+
+/**
+ * @brief Removes the characters of a set from both ends of a string.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] set The characters to remove.
+ * @param[in] n The length of @a set.
+ *
+ * @allocation Only if @a s is shared.
+ *
+ * @complexity Linear in the number of characters removed.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_trim_n(rapidstring *s, const char *set, size_t n);
+
+/**
+ * @brief Removes the characters of a set from the start of a string.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] set The characters to remove, such as #RS_WHITESPACE.
+ *
+ * @note Identicle to rs_ltrim_n() with `strlen()`.
+ *
+ * @allocation Only if @a s is shared.
+ *
+ * @complexity Linear in the number of characters removed for a heap string,
+ * linear in the length of @a s otherwise.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_ltrim(rapidstring *s, const char *set);
+
+/**
+ * @brief Removes the characters of a set from the start of a string.
+ *
+ * The buffer of a heap string is advanced past the removed characters, the
+ * others are not moved. The space is reclaimed when the string grows.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] set The characters to remove.
+ * @param[in] n The length of @a set.
+ *
+ * @allocation Only if @a s is shared.
+ *
+ * @complexity Linear in the number of characters removed for a heap string,
+ * linear in the length of @a s otherwise.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_ltrim_n(rapidstring *s, const char *set, size_t n);
+
+/**
+ * @brief Removes the characters of a set from the end of a string.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] set The characters to remove, such as #RS_WHITESPACE.
+ *
+ * @note Identicle to rs_rtrim_n() with `strlen()`.
+ *
+ * @allocation Only if @a s is shared.
+ *
+ * @complexity Linear in the number of characters removed.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_rtrim(rapidstring *s, const char *set);
+
+/**
+ * @brief Removes the characters of a set from the end of a string.
+ *
+ * @param[in,out] s An initialized string.
+ * @param[in] set The characters to remove.
+ * @param[in] n The length of @a set.
+ *
+ * @allocation Only if @a s is shared.
+ *
+ * @complexity Linear in the number of characters removed.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_rtrim_n(rapidstring *s, const char *set, size_t n);
+
+/**
+ * @brief Removes the characters of a set from both ends of a view.
+ *
+ * @param[in] v A view.
+ * @param[in] set The characters to remove.
+ * @param[in] n The length of @a set.
+ * @returns The trimmed view.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the number of characters removed.
+ *
+ * @since 1.1.0
+ */
+RS_API rs_view rs_view_trim_n(rs_view v, const char *set, size_t n);
+
+/**
+ * @brief Counts the leading characters of a buffer found in a set.
+ *
+ * @param[in] buffer The buffer to scan.
+ * @param[in] len The length of @a buffer.
+ * @param[in] set The characters to skip.
+ * @param[in] n The length of @a set.
+ * @returns The number of leading characters of @a buffer in @a set.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_memspan(const char *buffer, size_t len, const char *set,
+			 size_t n);
+
+/**
+ * @brief Counts the trailing characters of a buffer found in a set.
+ *
+ * @param[in] buffer The buffer to scan.
+ * @param[in] len The length of @a buffer.
+ * @param[in] set The characters to skip.
+ * @param[in] n The length of @a set.
+ * @returns The number of trailing characters of @a buffer in @a set.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_memrspan(const char *buffer, size_t len, const char *set,
+			  size_t n);
+
+/** @} */
+
+/*
+ * ===============================================================
+ *
+ *                           GAP BUFFER
+ *
+ * ===============================================================
+ */
+
+/**
+ * @defgroup gap Gap buffer
+ * Buffer with a movable gap for repeated edits around a cursor.
+ *
+ * The characters before the cursor are stored at the start of the buffer and
+ * the characters after the cursor at its end, leaving a gap in between.
+ * Inserting or erasing at the cursor only copies the edited characters.
+ * Moving the cursor copies the characters it passes over. Use
+ * rs_gap_materialize() once a contiguous string is needed.
+ *
+ * @code
+ * rs_gap g;
+ * rs_gap_init_w(&g, "hello world");
+ *
+ * rs_gap_move(&g, 5);
+ * rs_gap_insert(&g, ",");
+ * rs_gap_erase_after(&g, 1);
+ * rs_gap_insert(&g, "\n");
+ *
+ * rapidstring s;
+ * rs_init(&s);
+ * rs_gap_materialize(&g, &s);
+ *
+ * rs_free(&s);
+ * rs_gap_free(&g);
+ * @endcode
+ * @{
+ */
+
+/**
+ * @brief Gap buffer of characters.
+ *
+ * @since 1.1.0
+ */
+typedef struct {
+	/** @brief Buffer of @a capacity characters, `NULL` if it is empty. */
+	char *buffer;
+	/** @brief Number of characters before the gap, which is the cursor. */
+	size_t before;
+	/** @brief Number of characters after the gap, which end the buffer. */
+	size_t after;
+	/** @brief Size of the buffer. */
+	size_t capacity;
+} rs_gap;
+
+/**
+ * @brief Initializes an empty gap buffer.
+ *
+ * @param[out] g The gap buffer to initialize.
+ *
+ * @allocation Never.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_gap_init(rs_gap *g);
+
+/**
+ * @brief Initializes a gap buffer with characters.
+ *
+ * @param[out] g The gap buffer to initialize.
+ * @param[in] input The initial characters.
+ *
+ * @note Identicle to rs_gap_init_w_n() with `strlen()`.
+ *
+ * @allocation When @a input is not empty.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_gap_init_w(rs_gap *g, const char *input);
+
+/**
+ * @brief Initializes a gap buffer with characters.
+ *
+ * The cursor is placed after the characters.
+ *
+ * @param[out] g The gap buffer to initialize.
+ * @param[in] input The initial characters.
+ * @param[in] n The length of @a input.
+ *
+ * @allocation When @a n is not `0`.
+ *
+ * @complexity Linear in @a n.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_gap_init_w_n(rs_gap *g, const char *input, size_t n);
+
+/**
+ * @brief Initializes a gap buffer with a string.
+ *
+ * @param[out] g The gap buffer to initialize.
+ * @param[in] input The initial characters.
+ *
+ * @allocation When @a input is not empty.
+ *
+ * @complexity Linear in the length of @a input.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_gap_init_w_rs(rs_gap *g, const rapidstring *input);
+
+/**
+ * @brief Frees a gap buffer.
+ *
+ * You must call rs_gap_init() if you wish to reuse the same gap buffer.
+ *
+ * @param[in,out] g An initialized gap buffer.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_gap_free(rs_gap *g);
+
+/**
+ * @brief Gets the length of a gap buffer.
+ *
+ * @param[in] g An initialized gap buffer.
+ * @returns The number of characters of @a g.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_gap_len(const rs_gap *g);
+
+/**
+ * @brief Gets the cursor of a gap buffer.
+ *
+ * @param[in] g An initialized gap buffer.
+ * @returns The number of characters before the cursor.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_gap_cursor(const rs_gap *g);
+
+/**
+ * @brief Gets a character of a gap buffer.
+ *
+ * @param[in] g An initialized gap buffer.
+ * @param[in] i The index of the character, smaller than the length of @a g.
+ * @returns The character at index @a i.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant.
+ *
+ * @since 1.1.0
+ */
+RS_API char rs_gap_at(const rs_gap *g, size_t i);
+
+/**
+ * @brief Moves the cursor of a gap buffer.
+ *
+ * @param[in,out] g An initialized gap buffer.
+ * @param[in] index The new cursor, not greater than the length of @a g.
+ *
+ * @allocation Never.
+ *
+ * @complexity Linear in the distance between the cursor and @a index.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_gap_move(rs_gap *g, size_t index);
+
+/**
+ * @brief Inserts characters at the cursor of a gap buffer.
+ *
+ * @param[in,out] g An initialized gap buffer.
+ * @param[in] input The characters to insert.
+ *
+ * @note Identicle to rs_gap_insert_n() with `strlen()`.
+ *
+ * @allocation When the length of @a input is greater than the gap.
+ *
+ * @complexity Linear in the length of @a input.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_gap_insert(rs_gap *g, const char *input);
+
+/**
+ * @brief Inserts characters at the cursor of a gap buffer.
+ *
+ * The cursor is moved after the inserted characters.
+ *
+ * @param[in,out] g An initialized gap buffer.
+ * @param[in] input The characters to insert, which must not be within @a g.
+ * @param[in] n The length of @a input.
+ *
+ * @allocation When @a n is greater than the gap.
+ *
+ * @complexity Linear in @a n, or in the length of @a g when it grows.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_gap_insert_n(rs_gap *g, const char *input, size_t n);
+
+/**
+ * @brief Erases characters before the cursor of a gap buffer.
+ *
+ * @param[in,out] g An initialized gap buffer.
+ * @param[in] n The number of characters to erase, not greater than the
+ * cursor.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_gap_erase_before(rs_gap *g, size_t n);
+
+/**
+ * @brief Erases characters after the cursor of a gap buffer.
+ *
+ * @param[in,out] g An initialized gap buffer.
+ * @param[in] n The number of characters to erase, not greater than the
+ * number of characters after the cursor.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_gap_erase_after(rs_gap *g, size_t n);
+
+/**
+ * @brief Copies a gap buffer into a string.
+ *
+ * Overwrites any existing data. The gap buffer is left unchanged.
+ *
+ * @param[in] g An initialized gap buffer.
+ * @param[in,out] s An initialized string.
+ *
+ * @allocation When the length of @a g is greater than the capacity of @a s.
+ *
+ * @complexity Linear in the length of @a g.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_gap_materialize(const rs_gap *g, rapidstring *s);
+
+/**
+ * @brief Grows the gap of a gap buffer.
+ *
+ * @param[in,out] g An initialized gap buffer.
+ * @param[in] n The minimal size of the gap.
+ *
+ * @warning Intended for internal use.
+ *
+ * @allocation Always.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_gap_grow(rs_gap *g, size_t n);
+
+/** @} */
+
+/*
+ * ===============================================================
+ *
+ *                              TABLE
+ *
+ * ===============================================================
+ */
+
+/**
+ * @defgroup table Table
+ * Column of strings packed into a single buffer.
+ *
+ * A table appends the characters of its strings one after the other into a
+ * single buffer, and records where each string starts in an array of
+ * offsets. String `i` spans from `offsets[i]` to `offsets[i + 1]`. This costs
+ * one offset per string instead of a #rapidstring and a heap allocation, and
+ * scanning the strings walks memory linearly.
+ *
+ * The offsets and characters are laid out as the variable length binary
+ * arrays of Apache Arrow without a validity bitmap. Offsets are 32 bit
+ * (`binary` or `utf8`) until the characters exceed `INT32_MAX` bytes, at
+ * which point they are widened to 64 bit (`large_binary` or `large_utf8`).
+ * rs_table_offsets() and rs_table_data() may be handed to Arrow without any
+ * copies while the table is not modified.
+ *
+ * @code
+ * rs_table t;
+ * rs_table_init(&t);
+ *
+ * rs_table_push(&t, "alpha");
+ * rs_table_push(&t, "beta");
+ *
+ * const rs_view v = rs_table_at(&t, 1);
+ * assert(v.size == 4);
+ *
+ * rs_table_free(&t);
+ * @endcode
+ * @{
+ */
+
+/**
+ * @brief Greatest offset of a table with 32 bit offsets.
+ *
+ * @since 1.1.0
+ */
+#define RS_TABLE_SMALL_MAX ((size_t)0x7FFFFFFF)
+
+/**
+ * @brief Column of strings.
+ *
+ * @since 1.1.0
+ */
+typedef struct {
+	/**
+	 * @brief `size + 1` offsets into @a data, of type `int32_t`, or
+	 * `int64_t` if @a large is set. `NULL` if @a capacity is `0`.
+	 */
+	void *offsets;
+	/** @brief Characters of the strings, without null terminators. */
+	char *data;
+	/** @brief Number of strings. */
+	size_t size;
+	/** @brief Number of strings @a offsets has room for. */
+	size_t capacity;
+	/** @brief Number of characters @a data has room for. */
+	size_t data_capacity;
+	/** @brief Whether the offsets are 64 bit. */
+	unsigned char large;
+} rs_table;
+
+/**
+ * @brief Initializes an empty table with 32 bit offsets.
+ *
+ * @param[out] t The table to initialize.
+ *
+ * @allocation Never.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_table_init(rs_table *t);
+
+/**
+ * @brief Initializes an empty table with 64 bit offsets.
+ *
+ * @param[out] t The table to initialize.
+ *
+ * @allocation Never.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_table_init_large(rs_table *t);
+
+/**
+ * @brief Frees a table.
+ *
+ * You must call rs_table_init() if you wish to reuse the same table.
+ *
+ * @param[in,out] t An initialized table.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_table_free(rs_table *t);
+
+/**
+ * @brief Reserves room in a table.
+ *
+ * @param[in,out] t An initialized table.
+ * @param[in] n The number of strings to make room for in total.
+ * @param[in] bytes The number of characters to make room for in total.
+ *
+ * @allocation When @a n or @a bytes is greater than the corresponding
+ * capacity of @a t.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_table_reserve(rs_table *t, size_t n, size_t bytes);
+
+/**
+ * @brief Removes all strings from a table.
+ *
+ * The capacities and the width of the offsets remain the same.
+ *
+ * @param[in,out] t An initialized table.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_table_clear(rs_table *t);
+
+/**
+ * @brief Gets the number of strings of a table.
+ *
+ * @param[in] t An initialized table.
+ * @returns The number of strings of @a t.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_table_size(const rs_table *t);
+
+/**
+ * @brief Gets the number of characters of a table.
+ *
+ * @param[in] t An initialized table.
+ * @returns The number of characters of all the strings of @a t.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_table_bytes(const rs_table *t);
+
+/**
+ * @brief Appends characters to a table.
+ *
+ * @param[in,out] t An initialized table.
+ * @param[in] input The characters of the new string.
+ *
+ * @note Identicle to rs_table_push_n() with `strlen()`.
+ *
+ * @allocation When the offsets or the characters of @a t must grow.
+ *
+ * @complexity Linear in the length of @a input.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_table_push(rs_table *t, const char *input);
+
+/**
+ * @brief Appends characters to a table.
+ *
+ * @param[in,out] t An initialized table.
+ * @param[in] input The characters of the new string, which must not be
+ * within @a t.
+ * @param[in] n The length of @a input.
+ *
+ * @allocation When the offsets or the characters of @a t must grow.
+ *
+ * @complexity Linear in @a n.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_table_push_n(rs_table *t, const char *input, size_t n);
+
+/**
+ * @brief Appends a string to a table.
+ *
+ * @param[in,out] t An initialized table.
+ * @param[in] input The new string.
+ *
+ * @allocation When the offsets or the characters of @a t must grow.
+ *
+ * @complexity Linear in the length of @a input.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_table_push_rs(rs_table *t, const rapidstring *input);
+
+/**
+ * @brief Appends a view to a table.
+ *
+ * @param[in,out] t An initialized table.
+ * @param[in] input The new string, which must not be within @a t.
+ *
+ * @note Identicle to rs_table_push_n() with the data and size of @a input.
+ *
+ * @allocation When the offsets or the characters of @a t must grow.
+ *
+ * @complexity Linear in the size of @a input.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_table_push_v(rs_table *t, rs_view input);
+
+/**
+ * @brief Gets a string of a table.
+ *
+ * The view is invalidated when strings are appended to @a t.
+ *
+ * @param[in] t An initialized table.
+ * @param[in] i The index of the string, smaller than the size of @a t.
+ * @returns A view of the string, which is not null terminated.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant.
+ *
+ * @since 1.1.0
+ */
+RS_API rs_view rs_table_at(const rs_table *t, size_t i);
+
+/**
+ * @brief Gets the offsets of a table.
+ *
+ * @param[in] t An initialized table.
+ * @returns The size of @a t plus one offsets, of type `int32_t`, or `int64_t`
+ * if rs_table_is_large() is `1`.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant.
+ *
+ * @since 1.1.0
+ */
+RS_API const void *rs_table_offsets(const rs_table *t);
+
+/**
+ * @brief Gets the characters of a table.
+ *
+ * @param[in] t An initialized table.
+ * @returns The characters of all the strings of @a t, which are not null
+ * terminated.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant.
+ *
+ * @since 1.1.0
+ */
+RS_API const char *rs_table_data(const rs_table *t);
+
+/**
+ * @brief Checks whether a table has 64 bit offsets.
+ *
+ * @param[in] t An initialized table.
+ * @returns `1` if the offsets of @a t are `int64_t`, `0` if they are
+ * `int32_t`.
+ *
+ * @allocation Never.
+ *
+ * @complexity Constant.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_table_is_large(const rs_table *t);
+
+/**
+ * @brief Widens the offsets of a table to 64 bit.
+ *
+ * @param[in,out] t An initialized table with 32 bit offsets.
+ *
+ * @warning Intended for internal use.
+ *
+ * @allocation When the offsets have been allocated.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_table_widen(rs_table *t);
+
+/** @} */
+
+/*
+ * ===============================================================
+ *
+ *                              SORT
+ *
+ * ===============================================================
+ */
+
+/**
+ * @defgroup sort Sort
+ * Sorting of arrays of strings.
+ * @{
+ */
+
+/**
+ * @brief Sorts an array of strings.
+ *
+ * Strings are ordered as by rs_cmp_rs(). The sort is a multikey quicksort
+ * that partitions the strings by their next eight characters at once, read
+ * as a big endian integer. Only the first eight characters of each string
+ * are read while building these keys, directly from the stack buffer for
+ * stack strings, and a heap buffer is read again only if its key is equal
+ * to the key of other strings. The strings themselves are only moved once
+ * their order has been found.
+ *
+ * @param[in,out] strings The initialized strings to sort.
+ * @param[in] n The number of strings.
+ *
+ * @note The sort is not stable, although equal strings are indistinguishable
+ * unless their buffers are compared.
+ *
+ * @allocation When @a n is greater than `1`.
+ *
+ * @complexity Linearithmic in @a n, plus linear in the lengths of the common
+ * prefixes on average.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_sort(rapidstring *strings, size_t n);
+
+/**
+ * @brief Sort key of a string.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+typedef struct {
+	/** @brief Eight characters from the current depth, big endian. */
+	uint64_t key;
+	/** @brief Buffer of the string. */
+	const char *data;
+	/** @brief Length of the string. */
+	size_t len;
+	/** @brief Index of the string before sorting. */
+	size_t index;
+} rs_sort_entry;
+
+/**
+ * @brief Reverses the bytes of an integer.
+ *
+ * @param[in] w The integer.
+ * @returns @a w with its bytes reversed.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API uint64_t rs_bswap64(uint64_t w);
+
+/**
+ * @brief Reads up to eight characters as a sort key.
+ *
+ * @param[in] input The characters.
+ * @param[in] n The length of @a input.
+ * @returns The first eight characters as a big endian integer, padded with
+ * zeros.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API uint64_t rs_sort_key(const char *input, size_t n);
+
+/**
+ * @brief Reads the sort key of a stack string.
+ *
+ * @param[in] s An initialized stack string.
+ * @returns The first eight characters as a big endian integer, padded with
+ * zeros.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API uint64_t rs_sort_stack_key(const rapidstring *s);
+
+/**
+ * @brief Builds the sort entries of strings.
+ *
+ * @param[in] strings The strings.
+ * @param[out] e The entries, indexed like @a strings.
+ * @param[in] begin The index of the first string.
+ * @param[in] end The index past the last string.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_sort_fill(const rapidstring *strings, rs_sort_entry *e,
+			 size_t begin, size_t end);
+
+/**
+ * @brief Sorts entries sharing their first characters.
+ *
+ * @param[in,out] e The entries, whose keys are read at @a depth.
+ * @param[in] n The number of entries.
+ * @param[in] depth The number of characters shared by every entry.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_sort_entries(rs_sort_entry *e, size_t n, size_t depth);
+
+/**
+ * @brief Sorts entries sharing their first characters within a budget of
+ * partitions.
+ *
+ * The two smaller parts of each partition are sorted recursively and the
+ * largest one in the loop, so the recursion is never deeper than the
+ * logarithm of @a n. The parts with the same keys as the pivot are read
+ * deeper and get a new budget, the others share what is left of @a budget.
+ * Once it runs out, the entries are heapsorted.
+ *
+ * @param[in,out] e The entries, whose keys are read at @a depth.
+ * @param[in] n The number of entries.
+ * @param[in] depth The number of characters shared by every entry.
+ * @param[in] budget The number of partitions left at @a depth.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_sort_intro(rs_sort_entry *e, size_t n, size_t depth,
+			  size_t budget);
+
+/**
+ * @brief Number of partitions after which rs_sort_intro() heapsorts
+ * entries.
+ *
+ * @param[in] n The number of entries.
+ * @returns Twice the logarithm of @a n.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_sort_budget(size_t n);
+
+/**
+ * @brief Heapsorts entries sharing their first characters.
+ *
+ * @param[in,out] e The entries.
+ * @param[in] n The number of entries.
+ * @param[in] depth The number of characters shared by every entry.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_sort_heap(rs_sort_entry *e, size_t n, size_t depth);
+
+/**
+ * @brief Moves an entry down a heap until its children are not greater.
+ *
+ * @param[in,out] e The entries of the heap.
+ * @param[in] i The index of the entry.
+ * @param[in] n The number of entries in the heap.
+ * @param[in] depth The number of characters shared by every entry.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_sort_sift(rs_sort_entry *e, size_t i, size_t n, size_t depth);
+
+/**
+ * @brief Median of three keys.
+ *
+ * @param[in] a The first key.
+ * @param[in] b The second key.
+ * @param[in] c The third key.
+ * @returns The key between the other two.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API uint64_t rs_sort_median(uint64_t a, uint64_t b, uint64_t c);
+
+/**
+ * @brief Partitions entries around the median key of three, or of three
+ * medians of three when there are many entries.
+ *
+ * @param[in,out] e The entries.
+ * @param[in] n The number of entries, greater than `0`.
+ * @param[out] lt The number of entries with a smaller key.
+ * @param[out] gt The index of the first entry with a greater key.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_sort_partition(rs_sort_entry *e, size_t n, size_t *lt,
+			      size_t *gt);
+
+/**
+ * @brief Moves on to the next characters of entries with equal keys.
+ *
+ * The strings ending within the key are sorted to the front, and the keys of
+ * the other entries are read eight characters deeper.
+ *
+ * @param[in,out] e The entries.
+ * @param[in] n The number of entries.
+ * @param[in] depth The number of characters shared by every entry.
+ * @returns The number of strings ending within the key.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_sort_deepen(rs_sort_entry *e, size_t n, size_t depth);
+
+/**
+ * @brief Compares two entries sharing their first characters.
+ *
+ * @param[in] a The first entry.
+ * @param[in] b The second entry.
+ * @param[in] depth The number of characters shared by both entries.
+ * @returns `1` if @a a is ordered before @a b, `0` otherwise.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_sort_less(const rs_sort_entry *a,
+				  const rs_sort_entry *b, size_t depth);
+
+/**
+ * @brief Moves strings into the order of sorted entries.
+ *
+ * @param[in,out] strings The strings.
+ * @param[in] e The sorted entries.
+ * @param[in] n The number of strings.
+ *
+ * @warning Intended for internal use.
+ *
+ * @allocation Always.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_sort_permute(rapidstring *strings, const rs_sort_entry *e,
+			    size_t n);
+
+/** @} */
+
+/*
+ * ===============================================================
+ *
+ *                          PARALLEL SORT
+ *
+ * ===============================================================
+ */
+
+/**
+ * @defgroup parallel Parallel sort
+ * Optional multithreaded sorting of large arrays of strings.
+ *
+ * Defining `RS_PARALLEL` before including this header declares
+ * rs_parallel_sort(), which uses POSIX threads, or Windows threads when
+ * compiling for Windows.
+ *
+ * The strings are sorted in four steps, each split across the threads:
+ * - The sort entries of rs_sort() are built.
+ * - The entries are distributed into buckets by a sample of their keys. Keys
+ *   equal to a splitter get a bucket of their own, so frequent prefixes do not
+ *   pile up in a single bucket.
+ * - The buckets are sorted as tasks held in a deque per thread. Tasks larger
+ *   than #RS_PARALLEL_GRAIN are partitioned once more and their parts pushed
+ *   back, and idle threads steal the oldest, therefore largest, tasks of the
+ *   other threads. Skewed buckets are thereby shared by every thread.
+ * - The strings are moved into their sorted order.
+ * @{
+ */
+
+#ifdef RS_PARALLEL
+
+#ifdef RS_NO_ATOMICS
+#error "RS_PARALLEL requires atomic operations."
+#endif
+
+#ifndef RS_PARALLEL_MIN
+/**
+ * @brief Number of strings under which rs_parallel_sort() uses rs_sort().
+ *
+ * @since 1.1.0
+ */
+#define RS_PARALLEL_MIN (65536)
+#endif
+
+#ifndef RS_PARALLEL_GRAIN
+/**
+ * @brief Number of entries under which a task is sorted by a single thread.
+ *
+ * @since 1.1.0
+ */
+#define RS_PARALLEL_GRAIN (8192)
+#endif
+
+#ifndef RS_PARALLEL_BUCKETS
+/**
+ * @brief Number of sample splitters per thread.
+ *
+ * @since 1.1.0
+ */
+#define RS_PARALLEL_BUCKETS (8)
+#endif
+
+#ifdef _WIN32
+#include <windows.h>
+
+/**
+ * @brief Thread handle.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+typedef HANDLE rs_thread;
+
+/**
+ * @brief Mutex.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+typedef CRITICAL_SECTION rs_mutex;
+
+/** @brief Return type of a thread function. */
+#define RS_THREAD_RESULT DWORD WINAPI
+#else
+#include <pthread.h>
+#include <sched.h>
+
+/**
+ * @brief Thread handle.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+typedef pthread_t rs_thread;
+
+/**
+ * @brief Mutex.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+typedef pthread_mutex_t rs_mutex;
+
+/** @brief Return type of a thread function. */
+#define RS_THREAD_RESULT void *
+#endif
+
+/**
+ * @brief Range of sort entries to sort.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+typedef struct {
+	/** @brief The entries. */
+	rs_sort_entry *e;
+	/** @brief Number of entries. */
+	size_t n;
+	/** @brief Number of characters shared by every entry. */
+	size_t depth;
+	/** @brief Number of partitions left at @a depth. */
+	size_t budget;
+} rs_sort_task;
+
+/**
+ * @brief Tasks of a thread, which other threads may steal.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+typedef struct {
+	/** @brief Protects the other members. */
+	rs_mutex lock;
+	/** @brief The tasks, the oldest first. */
+	rs_sort_task *tasks;
+	/** @brief Index of the oldest task. */
+	size_t head;
+	/** @brief Index past the newest task. */
+	size_t tail;
+	/** @brief Capacity of @a tasks. */
+	size_t capacity;
+} rs_sort_deque;
+
+/**
+ * @brief State shared by the threads of rs_parallel_sort().
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+typedef struct {
+	/** @brief The strings to sort. */
+	rapidstring *strings;
+	/** @brief Number of strings. */
+	size_t n;
+	/** @brief Number of threads, including the calling thread. */
+	unsigned int threads;
+	/** @brief Step currently run by the threads. */
+	unsigned int step;
+	/**
+	 * @brief Entries in the order of the strings, large enough to be
+	 * reused for @a sorted.
+	 */
+	rs_sort_entry *e;
+	/** @brief Entries in the order of the buckets, then sorted. */
+	rs_sort_entry *out;
+	/** @brief Strings in sorted order, in the memory of @a e. */
+	rapidstring *sorted;
+	/** @brief Sorted distinct keys delimiting the buckets. */
+	uint64_t *splitters;
+	/** @brief Number of splitters. */
+	size_t splitter_count;
+	/** @brief Number of buckets, twice the splitters plus one. */
+	size_t buckets;
+	/**
+	 * @brief Size of each bucket in the range of each thread, replaced by
+	 * the position of each bucket of each thread in @a out.
+	 */
+	size_t *counts;
+	/** @brief Task deque of each thread. */
+	rs_sort_deque *deques;
+	/** @brief Each thread, the calling thread first. */
+	struct rs_parallel_worker *workers;
+	/** @brief Number of tasks pushed but not yet finished. */
+	volatile long pending;
+} rs_parallel;
+
+/**
+ * @brief Thread of rs_parallel_sort().
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+typedef struct rs_parallel_worker {
+	/** @brief The shared state. */
+	rs_parallel *p;
+	/** @brief Index of the thread, `0` being the calling thread. */
+	unsigned int id;
+	/** @brief Handle of the thread. */
+	rs_thread handle;
+	/** @brief Whether the thread was created for the current step. */
+	unsigned char started;
+} rs_parallel_worker;
+
+/**
+ * @brief Sorts an array of strings with several threads.
+ *
+ * The strings are ordered as by rs_sort(), with the same entries and multikey
+ * quicksort.
+ *
+ * @param[in,out] strings The initialized strings to sort.
+ * @param[in] n The number of strings.
+ * @param[in] threads The number of threads, including the calling thread.
+ *
+ * @note rs_sort() is used when @a threads is smaller than `2` or @a n is
+ * smaller than #RS_PARALLEL_MIN. A thread which cannot be created has its
+ * share of the work done by the calling thread.
+ *
+ * @allocation When @a n is greater than `1`. At most two arrays of @a n
+ * #rs_sort_entry, 64 bytes per string on 64 bit targets, are held at once,
+ * plus the splitters, bucket counts and task deques.
+ *
+ * @complexity Linearithmic in @a n divided by @a threads on average.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_parallel_sort(rapidstring *strings, size_t n,
+			     unsigned int threads);
+
+/**
+ * @brief Runs a step of rs_parallel_sort() on every thread.
+ *
+ * @param[in,out] p The shared state.
+ * @param[in] step The step to run.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_parallel_run(rs_parallel *p, unsigned int step);
+
+/**
+ * @brief Runs the current step of rs_parallel_sort() on a thread.
+ *
+ * @param[in] arg The #rs_parallel_worker of the thread.
+ * @returns Nothing.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API RS_THREAD_RESULT rs_parallel_thread(void *arg);
+
+/**
+ * @brief Runs a step of rs_parallel_sort() on a thread.
+ *
+ * @param[in,out] p The shared state.
+ * @param[in] id The index of the thread.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_parallel_step(rs_parallel *p, unsigned int id);
+
+/**
+ * @brief Chooses the bucket splitters from a sample of the keys.
+ *
+ * @param[in,out] p The shared state, whose entries are built.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_parallel_sample(rs_parallel *p);
+
+/**
+ * @brief Finds the bucket of a key.
+ *
+ * @param[in] p The shared state.
+ * @param[in] key The key.
+ * @returns `2 * i + 1` if @a key is the splitter `i`, `2 * i` if it is
+ * between the splitters `i - 1` and `i`.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API size_t rs_parallel_bucket(const rs_parallel *p, uint64_t key);
+
+/**
+ * @brief Sorts tasks until every task is finished.
+ *
+ * @param[in,out] p The shared state.
+ * @param[in] id The index of the thread.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_parallel_work(rs_parallel *p, unsigned int id);
+
+/**
+ * @brief Pushes a task to the deque of a thread.
+ *
+ * @param[in,out] p The shared state.
+ * @param[in] id The index of the thread.
+ * @param[in] e The entries of the task.
+ * @param[in] n The number of entries.
+ * @param[in] depth The number of characters shared by every entry.
+ * @param[in] budget The number of partitions left at @a depth.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API void rs_parallel_push(rs_parallel *p, unsigned int id,
+			     rs_sort_entry *e, size_t n, size_t depth,
+			     size_t budget);
+
+/**
+ * @brief Pops the newest task of a thread, or steals the oldest task of
+ * another thread.
+ *
+ * @param[in,out] p The shared state.
+ * @param[in] id The index of the thread.
+ * @param[out] task The task.
+ * @returns `1` if a task was found, `0` otherwise.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API unsigned char rs_parallel_pop(rs_parallel *p, unsigned int id,
+				     rs_sort_task *task);
+
+/**
+ * @brief Compares two keys for `qsort()`.
+ *
+ * @param[in] a The first key.
+ * @param[in] b The second key.
+ * @returns A value smaller than, equal to or greater than `0` if @a a is
+ * respectively smaller than, equal to or greater than @a b.
+ *
+ * @warning Intended for internal use.
+ *
+ * @since 1.1.0
+ */
+RS_API int rs_parallel_key_cmp(const void *a, const void *b);
+
+#endif /* RS_PARALLEL */
+
+/** @} */
+
+/*
+ * ===============================================================
+ *
+ *                   CONSTRUCTION & DESTRUCTION
+ *
+ * ===============================================================
+ */
+
+RS_API void rs_init(rapidstring *s)
+{
+	assert(s != NULL);
+
+	rs_stack_resize(s, 0);
+}
+
+RS_API void rs_init_w(rapidstring *s, const char *input)
+{
+	assert(input != NULL);
+
+	rs_init_w_n(s, input, strlen(input));
+}
+
+RS_API void rs_init_w_n(rapidstring *s, const char *input, size_t n)
+{
+	/*
+	 * A fresh string is never shared, offset or on the heap, so the checks
+	 * of rs_cpy_n() are skipped rather than made on unwritten heap fields.
+	 */
+	if (RS_HEAP_LIKELY(n > RS_STACK_CAPACITY)) {
+		rs_heap_init_g(s, n);
+		rs_heap_cpy_n(s, input, n);
+	} else {
+		rs_init(s);
+		rs_stack_cpy_n(s, input, n);
+	}
+}
+
+RS_API void rs_init_w_cap(rapidstring *s, size_t n)
+{
+	if (RS_HEAP_LIKELY(n > RS_STACK_CAPACITY)) {
+		rs_heap_init(s, n);
+		rs_heap_resize(s, 0);
+	} else {
+		rs_init(s);
+	}
+}
+
+RS_API void rs_init_w_rs(rapidstring *s, const rapidstring *input)
+{
+	if (RS_UNLIKELY(rs_is_shared(input))) {
+		(void)RS_SHARED_ADD(&RS_SHARED_HEADER(input)->refs, 1);
+		*s = *input;
+	} else {
+		RS_DATA_SIZE(rs_init_w_n, s, input);
+	}
+}
+
+RS_API void rs_init_w_v(rapidstring *s, rs_view input)
+{
+	rs_init_w_n(s, input.data, input.size);
+}
+
+RS_API void rs_init_w_many(rapidstring *s, const rs_view *pieces, size_t n)
+{
+	size_t total = 0;
+	size_t i;
+	char *p;
+
+	assert(pieces != NULL || n == 0);
+
+	for (i = 0; i < n; i++)
+		total += pieces[i].size;
+
+	rs_init_w_cap(s, total);
+	p = rs_data(s);
+
+	for (i = 0; i < n; i++) {
+		memcpy(p, pieces[i].data, pieces[i].size);
+		p += pieces[i].size;
+	}
+
+	rs_resize(s, total);
+}
+
+RS_API void rs_init_w_many_rs(rapidstring *s,
+			      const rapidstring *const *pieces, size_t n)
+{
+	size_t total = 0;
+	size_t i;
+	char *p;
+
+	assert(pieces != NULL || n == 0);
+
+	for (i = 0; i < n; i++)
+		total += rs_len(pieces[i]);
+
+	rs_init_w_cap(s, total);
+	p = rs_data(s);
+
+	for (i = 0; i < n; i++) {
+		const size_t len = rs_len(pieces[i]);
+
+		memcpy(p, rs_data_c(pieces[i]), len);
+		p += len;
+	}
+
+	rs_resize(s, total);
+}
+
+RS_API void rs_init_w_alloc(rapidstring *s, const rs_allocator *a)
+{
+	rs_init_w_cap_alloc(s, RS_STACK_CAPACITY, a);
+}
+
+RS_API void rs_init_w_cap_alloc(rapidstring *s, size_t n,
+				const rs_allocator *a)
+{
+	rs_heap_init_alloc(s, n, a);
+	rs_heap_resize(s, 0);
+}
+
+RS_API void rs_free(rapidstring *s)
+{
+	RS_ASSERT_RS(s);
+
+	if (RS_HEAP_LIKELY(rs_is_heap(s)))
+		rs_heap_free(s);
+}
+
+/*
+ * ===============================================================
+ *
+ *                             COPYING
+ *
+ * ===============================================================
+ */
+
+RS_API void rs_stack_cpy_n(rapidstring *s, const char *input, size_t n)
+{
+	assert(rs_is_stack(s));
+	assert(input != NULL);
+	assert(RS_STACK_CAPACITY >= n);
+
+	memcpy(s->stack.buffer, input, n);
+	rs_stack_resize(s, n);
+}
+
+RS_API void rs_heap_cpy_n(rapidstring *s, const char *input, size_t n)
+{
+	assert(rs_is_heap(s));
+	assert(input != NULL);
+	assert(s->heap.capacity >= n);
+
+	memcpy(s->heap.buffer, input, n);
+	rs_heap_resize(s, n);
+}
+
+RS_API void rs_cpy(rapidstring *s, const char *input)
+{
+	assert(input != NULL);
+
+	rs_cpy_n(s, input, strlen(input));
+}
+
+RS_API void rs_cpy_n(rapidstring *s, const char *input, size_t n)
+{
+	if (RS_HEAP_LIKELY(rs_is_heap(s))) {
+		if (RS_UNLIKELY(s->heap.mode & RS_HEAP_MODE_SHARED))
+			rs_heap_unshare(s, n);
+		else if (RS_UNLIKELY(s->heap.mode & RS_HEAP_MODE_OFFSET))
+			rs_heap_rebase(s, 0);
+
+		rs_grow_heap(s, n);
+		rs_heap_cpy_n(s, input, n);
+	} else if (RS_HEAP_LIKELY(n > RS_STACK_CAPACITY)) {
+		rs_heap_init_g(s, n);
+		rs_heap_cpy_n(s, input, n);
+	} else {
+		rs_stack_cpy_n(s, input, n);
+	}
+}
+
+RS_API void rs_cpy_rs(rapidstring *s, const rapidstring *input)
+{
+	if (RS_UNLIKELY(rs_is_shared(input))) {
+		/* Acquired first in case both strings share the same buffer. */
+		(void)RS_SHARED_ADD(&RS_SHARED_HEADER(input)->refs, 1);
+		rs_free(s);
+		*s = *input;
+	} else {
+		RS_DATA_SIZE(rs_cpy_n, s, input);
+	}
+}
+
+RS_API void rs_cpy_v(rapidstring *s, rs_view input)
+{
+	rs_cpy_n(s, input.data, input.size);
+}
+
+RS_API char *rs_cpy_reserve(rapidstring *s, size_t n)
+{
+	if (RS_HEAP_LIKELY(rs_is_heap(s))) {
+		if (RS_UNLIKELY(s->heap.mode & RS_HEAP_MODE_SHARED))
+			rs_heap_unshare(s, n);
+		else if (RS_UNLIKELY(s->heap.mode & RS_HEAP_MODE_OFFSET))
+			rs_heap_rebase(s, 0);
+
+		if (RS_UNLIKELY(s->heap.capacity < n))
+			rs_realloc(s, n);
+
+		return s->heap.buffer;
+	} else if (RS_HEAP_LIKELY(n > RS_STACK_CAPACITY)) {
+		/* The characters on the stack are overwritten anyway. */
+		rs_heap_init(s, n);
+
+		return s->heap.buffer;
+	}
+
+	return s->stack.buffer;
+}
+
+/*
+ * ===============================================================
+ *
+ *                            CAPACITY
+ *
+ * ===============================================================
+ */
+
+RS_API unsigned char rs_empty(const rapidstring *s)
+{
+	return rs_len(s) == 0;
+}
+
+RS_API size_t rs_stack_len(const rapidstring *s)
+{
+	size_t len;
+
+	assert(rs_is_stack(s));
+
+	len = (unsigned char)(RS_STACK_CAPACITY - s->stack.left);
+
+	/*
+	 * The length never exceeds the stack capacity, which the compiler is
+	 * told so that copies of stack strings stay in bounds.
+	 */
+	RS_ASSUME(len <= RS_STACK_CAPACITY);
+
+	return len;
+}
+
+RS_API size_t rs_heap_len(const rapidstring *s)
+{
+	assert(rs_is_heap(s));
+
+	return s->heap.size;
+}
+
+RS_API size_t rs_len(const rapidstring *s)
+{
+	return rs_is_heap(s) ? rs_heap_len(s) : rs_stack_len(s);
+}
+
+RS_API size_t rs_cap(const rapidstring *s)
+{
+	return rs_is_heap(s) ? s->heap.capacity : RS_STACK_CAPACITY;
+}
+
+RS_API void rs_reserve(rapidstring *s, size_t n)
+{
+	if (RS_HEAP_LIKELY(rs_is_heap(s))) {
+		if (RS_LIKELY(s->heap.capacity < n))
+			rs_realloc(s, n);
+	} else {
+		rs_stack_to_heap(s, n);
+	}
+}
+
+RS_API void rs_shrink_to_fit(rapidstring *s)
+{
+	/* Shared buffers are always exactly the size of their string. */
+	if (RS_LIKELY(rs_is_heap(s)) &&
+	    !(s->heap.mode & RS_HEAP_MODE_SHARED))
+		rs_realloc(s, rs_heap_len(s));
+}
+
+RS_API unsigned char rs_is_heap(const rapidstring *s)
+{
+	RS_ASSERT_RS(s);
+
+	return s->heap.flag == RS_HEAP_FLAG;
+}
+
+RS_API unsigned char rs_is_stack(const rapidstring *s)
+{
+	return !rs_is_heap(s);
+}
+
+RS_API const rs_allocator *rs_get_alloc(const rapidstring *s)
+{
+	if (RS_UNLIKELY(rs_is_heap(s) && (s->heap.mode & RS_HEAP_MODE_ALLOC)))
+		return RS_HEAP_HEADER(s)->allocator;
+
+	return NULL;
+}
+
+/*
+ * ===============================================================
+ *
+ *                            MODIFIERS
+ *
+ * ===============================================================
+ */
+
+RS_API char *rs_data(rapidstring *s)
+{
+	RS_ASSERT_RS(s);
+
+	return rs_is_heap(s) ? s->heap.buffer : s->stack.buffer;
+}
+
+RS_API const char *rs_data_c(const rapidstring *s)
+{
+	RS_ASSERT_RS(s);
+
+	return rs_is_heap(s) ? s->heap.buffer : s->stack.buffer;
+}
+
+RS_API void rs_stack_cat_n(rapidstring *s, const char *input, size_t n)
+{
+	const size_t stack_len = rs_stack_len(s);
+
+	assert(input != NULL);
+	assert(RS_STACK_CAPACITY >= rs_stack_len(s) + n);
+
+	memcpy(s->stack.buffer + stack_len, input, n);
+	rs_stack_resize(s, stack_len + n);
+}
+
+RS_API void rs_heap_cat_n(rapidstring *s, const char *input, size_t n)
+{
+	RS_ASSERT_RS(s);
+	assert(input != NULL);
+	assert(s->heap.capacity >= s->heap.size + n);
+
+	memcpy(s->heap.buffer + rs_heap_len(s), input, n);
+	rs_heap_resize(s, rs_heap_len(s) + n);
+}
+
+RS_API void rs_cat(rapidstring *s, const char *input)
+{
+	assert(input != NULL);
+
+	rs_cat_n(s, input, strlen(input));
+}
+
+RS_API void rs_cat_n(rapidstring *s, const char *input, size_t n)
+{
+	if (RS_HEAP_LIKELY(rs_is_heap(s))) {
+		rs_grow_heap(s, rs_heap_len(s) + n);
+		rs_heap_cat_n(s, input, n);
+	} else if (RS_HEAP_LIKELY(s->stack.left < n)) {
+		rs_stack_to_heap_g(s, n);
+		rs_heap_cat_n(s, input, n);
+	} else {
+		rs_stack_cat_n(s, input, n);
+	}
+}
+
+RS_API void rs_cat_rs(rapidstring *s, const rapidstring *input)
+{
+	RS_DATA_SIZE(rs_cat_n, s, input);
+}
+
+RS_API void rs_cat_v(rapidstring *s, rs_view input)
+{
+	rs_cat_n(s, input.data, input.size);
+}
+
+RS_API char *rs_cat_reserve(rapidstring *s, size_t n)
+{
+	if (RS_HEAP_LIKELY(rs_is_heap(s))) {
+		rs_grow_heap(s, rs_heap_len(s) + n);
+
+		return s->heap.buffer + rs_heap_len(s);
+	} else if (RS_HEAP_LIKELY(s->stack.left < n)) {
+		rs_stack_to_heap_g(s, n);
+
+		return s->heap.buffer + rs_heap_len(s);
+	}
+
+	return s->stack.buffer + rs_stack_len(s);
+}
+
+RS_API void rs_cat_many(rapidstring *s, const rs_view *pieces, size_t n)
+{
+	const size_t len = rs_len(s);
+	size_t total = 0;
+	size_t i;
+	char *p;
+
+	assert(pieces != NULL || n == 0);
+
+	for (i = 0; i < n; i++)
+		total += pieces[i].size;
+
+	p = rs_cat_reserve(s, total);
+
+	for (i = 0; i < n; i++) {
+		memcpy(p, pieces[i].data, pieces[i].size);
+		p += pieces[i].size;
+	}
+
+	rs_resize(s, len + total);
+}
+
+RS_API void rs_cat_many_rs(rapidstring *s, const rapidstring *const *pieces,
+			   size_t n)
+{
+	const size_t len = rs_len(s);
+	size_t total = 0;
+	size_t i;
+	char *p;
+
+	assert(pieces != NULL || n == 0);
+
+	for (i = 0; i < n; i++) {
+		assert(pieces[i] != s);
+		total += rs_len(pieces[i]);
+	}
+
+	p = rs_cat_reserve(s, total);
+
+	for (i = 0; i < n; i++) {
+		const size_t piece_len = rs_len(pieces[i]);
+
+		memcpy(p, rs_data_c(pieces[i]), piece_len);
+		p += piece_len;
+	}
+
+	rs_resize(s, len + total);
+}
+
+RS_API void rs_join(rapidstring *s, const rs_view *pieces, size_t n,
+		    const char *sep)
+{
+	assert(sep != NULL);
+
+	rs_join_n(s, pieces, n, sep, strlen(sep));
+}
+
+RS_API void rs_join_n(rapidstring *s, const rs_view *pieces, size_t n,
+		      const char *sep, size_t sep_len)
+{
+	size_t total = 0;
+	size_t i;
+	char *p;
+
+	assert(pieces != NULL || n == 0);
+	assert(sep != NULL || sep_len == 0);
+
+	for (i = 0; i < n; i++)
+		total += pieces[i].size;
+
+	if (RS_LIKELY(n > 1))
+		total += (n - 1) * sep_len;
+
+	p = rs_cpy_reserve(s, total);
+
+	for (i = 0; i < n; i++) {
+		if (RS_LIKELY(i != 0)) {
+			memcpy(p, sep, sep_len);
+			p += sep_len;
+		}
+
+		memcpy(p, pieces[i].data, pieces[i].size);
+		p += pieces[i].size;
+	}
+
+	rs_resize(s, total);
+}
+
+RS_API void rs_join_rs(rapidstring *s, const rapidstring *const *pieces,
+		       size_t n, const char *sep)
+{
+	assert(sep != NULL);
+
+	rs_join_rs_n(s, pieces, n, sep, strlen(sep));
+}
+
+RS_API void rs_join_rs_n(rapidstring *s, const rapidstring *const *pieces,
+			 size_t n, const char *sep, size_t sep_len)
+{
+	size_t total = 0;
+	size_t i;
+	char *p;
+
+	assert(pieces != NULL || n == 0);
+	assert(sep != NULL || sep_len == 0);
+
+	for (i = 0; i < n; i++) {
+		assert(pieces[i] != s);
+		total += rs_len(pieces[i]);
+	}
+
+	if (RS_LIKELY(n > 1))
+		total += (n - 1) * sep_len;
+
+	p = rs_cpy_reserve(s, total);
+
+	for (i = 0; i < n; i++) {
+		const size_t piece_len = rs_len(pieces[i]);
+
+		if (RS_LIKELY(i != 0)) {
+			memcpy(p, sep, sep_len);
+			p += sep_len;
+		}
+
+		memcpy(p, rs_data_c(pieces[i]), piece_len);
+		p += piece_len;
+	}
+
+	rs_resize(s, total);
+}
+
+RS_API void rs_steal(rapidstring *s, char *buffer, size_t cap, size_t size)
+{
+	assert(buffer != NULL);
+	assert(cap > size);
+	assert(cap >= 1);
+
+	s->heap.flag = RS_HEAP_FLAG;
+	s->heap.mode = 0;
+	s->heap.buffer = buffer;
+	s->heap.capacity = cap - 1;
+	rs_heap_resize(s, size);
+}
+
+RS_API void rs_stack_erase(rapidstring *s, size_t index, size_t n)
+{
+	const size_t total = index + n;
+	const size_t stack_len = rs_stack_len(s);
+
+	assert(rs_is_stack(s));
+	RS_ASSUME(index <= stack_len);
+	RS_ASSUME(n <= stack_len - index);
+
+	memmove(s->stack.buffer + index, s->stack.buffer + total,
+		stack_len - total + 1);
+	s->stack.left += (unsigned char)(n);
+}
+
+RS_API void rs_heap_erase(rapidstring *s, size_t index, size_t n)
+{
+	const size_t total = index + n;
+	const size_t heap_len = rs_heap_len(s);
+
+	assert(rs_is_heap(s));
+	assert(index <= heap_len);
+	assert(n <= heap_len - index);
+
+	if (RS_UNLIKELY(s->heap.mode & RS_HEAP_MODE_SHARED))
+		rs_heap_unshare(s, heap_len);
+
+	memmove(s->heap.buffer + index, s->heap.buffer + total,
+		heap_len - total + 1);
+	s->heap.size -= n;
+	s->heap.mode &= (unsigned char)~RS_HEAP_MODE_UTF8;
+}
+
+RS_API void rs_erase(rapidstring *s, size_t index, size_t n)
+{
+	if (RS_HEAP_LIKELY(rs_is_heap(s)))
+		rs_heap_erase(s, index, n);
+	else
+		rs_stack_erase(s, index, n);
+}
+
+RS_API void rs_insert(rapidstring *s, size_t index, const char *input)
+{
+	assert(input != NULL);
+
+	rs_replace_range_n(s, index, 0, input, strlen(input));
+}
+
+RS_API void rs_insert_n(rapidstring *s, size_t index, const char *input,
+			size_t n)
+{
+	rs_replace_range_n(s, index, 0, input, n);
+}
+
+RS_API void rs_insert_rs(rapidstring *s, size_t index,
+			 const rapidstring *input)
+{
+	assert(s != input);
+
+	if (RS_HEAP_LIKELY(rs_is_heap(input)))
+		rs_insert_n(s, index, input->heap.buffer, rs_heap_len(input));
+	else
+		rs_insert_n(s, index, input->stack.buffer,
+			    rs_stack_len(input));
+}
+
+RS_API void rs_insert_v(rapidstring *s, size_t index, rs_view input)
+{
+	rs_replace_range_n(s, index, 0, input.data, input.size);
+}
+
+RS_API void rs_replace_range(rapidstring *s, size_t index, size_t n,
+			     const char *input)
+{
+	assert(input != NULL);
+
+	rs_replace_range_n(s, index, n, input, strlen(input));
+}
+
+RS_API void rs_replace_range_n(rapidstring *s, size_t index, size_t n,
+			       const char *input, size_t i_n)
+{
+	const size_t len = rs_len(s);
+	const size_t total = len - n + i_n;
+	char *p;
+
+	assert(input != NULL);
+	RS_ASSUME(index <= len);
+	RS_ASSUME(n <= len - index);
+
+	if (RS_HEAP_LIKELY(rs_is_heap(s))) {
+		if (RS_UNLIKELY(s->heap.mode & RS_HEAP_MODE_SHARED)) {
+			rs_replace_range_grow(s, index, n, input, i_n);
+			return;
+		}
+
+		rs_grow_heap(s, total);
+		p = s->heap.buffer;
+	} else if (RS_HEAP_LIKELY(total > RS_STACK_CAPACITY)) {
+		rs_replace_range_grow(s, index, n, input, i_n);
+		return;
+	} else {
+		p = s->stack.buffer;
+	}
+
+	memmove(p + index + i_n, p + index + n, len - index - n);
+	memcpy(p + index, input, i_n);
+
+	if (RS_HEAP_LIKELY(rs_is_heap(s)))
+		rs_heap_resize(s, total);
+	else
+		rs_stack_resize(s, total);
+}
+
+RS_API void rs_replace_range_v(rapidstring *s, size_t index, size_t n,
+			       rs_view input)
+{
+	rs_replace_range_n(s, index, n, input.data, input.size);
+}
+
+RS_API void rs_replace_range_grow(rapidstring *s, size_t index, size_t n,
+				  const char *input, size_t i_n)
+{
+	const char *p = rs_data_c(s);
+	const size_t len = rs_len(s);
+	const size_t total = len - n + i_n;
+	const rs_allocator *a = rs_get_alloc(s);
+	rapidstring out;
+
+	/* A shared string is thawed to its exact size, like rs_thaw(). */
+	if (RS_UNLIKELY(a != NULL))
+		rs_heap_init_alloc(&out, total, a);
+	else if (rs_is_heap(s))
+		rs_heap_init(&out, total);
+	else
+		rs_heap_init_g(&out, total);
+
+	memcpy(out.heap.buffer, p, index);
+	memcpy(out.heap.buffer + index, input, i_n);
+
+	if (index + n < len)
+		memcpy(out.heap.buffer + index + i_n, p + index + n,
+		       len - index - n);
+
+	rs_heap_resize(&out, total);
+
+	rs_free(s);
+	*s = out;
+}
+
+RS_API size_t rs_replace_all(rapidstring *s, const char *needle,
+			     const char *replacement)
+{
+	assert(needle != NULL);
+	assert(replacement != NULL);
+
+	return rs_replace_all_n(s, needle, strlen(needle), replacement,
+				strlen(replacement));
+}
+
+RS_API size_t rs_replace_all_n(rapidstring *s, const char *needle, size_t n,
+			       const char *replacement, size_t r_n)
+{
+	const size_t len = rs_len(s);
+	size_t src = 0;
+	size_t dst = 0;
+	size_t count = 0;
+	size_t i;
+	char *p;
+
+	assert(needle != NULL);
+	assert(replacement != NULL || r_n == 0);
+	assert(n > 0);
+
+	if (r_n > n || RS_UNLIKELY(rs_is_shared(s)))
+		return rs_replace_all_grow(s, needle, n, replacement, r_n);
+
+	p = rs_data(s);
+
+	/* The result is never ahead of the input, so it is written in place. */
+	while ((i = rs_memmem(p + src, len - src, needle, n)) != RS_NPOS) {
+		memmove(p + dst, p + src, i);
+		memcpy(p + dst + i, replacement, r_n);
+		dst += i + r_n;
+		src += i + n;
+		count++;
+	}
+
+	if (count != 0) {
+		memmove(p + dst, p + src, len - src);
+		dst += len - src;
+
+		if (RS_HEAP_LIKELY(rs_is_heap(s)))
+			rs_heap_resize(s, dst);
+		else
+			rs_stack_resize(s, dst);
+	}
+
+	return count;
+}
+
+RS_API size_t rs_replace_all_v(rapidstring *s, rs_view needle,
+			       rs_view replacement)
+{
+	return rs_replace_all_n(s, needle.data, needle.size, replacement.data,
+				replacement.size);
+}
+
+RS_API size_t rs_replace_all_grow(rapidstring *s, const char *needle,
+				  size_t n, const char *replacement,
+				  size_t r_n)
+{
+	const char *p = rs_data_c(s);
+	const size_t len = rs_len(s);
+	const rs_allocator *a = rs_get_alloc(s);
+	size_t src = 0;
+	size_t count = 0;
+	size_t total;
+	size_t i;
+	rapidstring out;
+	char *q;
+
+	/* The matches are counted first to size the result exactly. */
+	while ((i = rs_memmem(p + src, len - src, needle, n)) != RS_NPOS) {
+		src += i + n;
+		count++;
+	}
+
+	if (count == 0)
+		return 0;
+
+	total = len - count * n + count * r_n;
+
+	if (RS_UNLIKELY(a != NULL))
+		rs_init_w_cap_alloc(&out, total, a);
+	else
+		rs_init_w_cap(&out, total);
+
+	q = rs_data(&out);
+	src = 0;
+
+	while ((i = rs_memmem(p + src, len - src, needle, n)) != RS_NPOS) {
+		memcpy(q, p + src, i);
+		memcpy(q + i, replacement, r_n);
+		q += i + r_n;
+		src += i + n;
+	}
+
+	memcpy(q, p + src, len - src);
+
+	if (RS_HEAP_LIKELY(rs_is_heap(&out)))
+		rs_heap_resize(&out, total);
+	else
+		rs_stack_resize(&out, total);
+
+	rs_free(s);
+	*s = out;
+
+	return count;
+}
+
+RS_API void rs_stack_clear(rapidstring *s)
+{
 	rs_stack_resize(s, 0);
 }
 
-RS_API void rs_init_w(rapidstring *s, const char *input)
+RS_API void rs_heap_clear(rapidstring *s)
+{
+	rs_heap_resize(s, 0);
+}
+
+RS_API void rs_clear(rapidstring *s)
+{
+	if (RS_HEAP_LIKELY(rs_is_heap(s)))
+		rs_heap_clear(s);
+	else
+		rs_stack_clear(s);
+}
+
+RS_API void rs_stack_resize(rapidstring *s, size_t n)
+{
+	RS_ASSUME(RS_STACK_CAPACITY >= n);
+
+	/* A full string is terminated by its remaining capacity of zero. */
+	((char *)&s->stack)[n] = '\0';
+	s->stack.left = (unsigned char)(RS_STACK_CAPACITY - n);
+}
+
+RS_API void rs_heap_resize(rapidstring *s, size_t n)
+{
+	assert(rs_is_heap(s));
+	RS_ASSUME(s->heap.capacity >= n);
+
+	/* The capacity of a frozen string is its length. */
+	if (RS_UNLIKELY(s->heap.mode & RS_HEAP_MODE_SHARED))
+		rs_heap_unshare(s, s->heap.capacity);
+
+	s->heap.buffer[n] = '\0';
+	s->heap.size = n;
+	s->heap.mode &= (unsigned char)~RS_HEAP_MODE_UTF8;
+}
+
+RS_API void rs_resize(rapidstring *s, size_t n)
+{
+	if (RS_HEAP_LIKELY(rs_is_heap(s))) {
+		if (RS_UNLIKELY(s->heap.capacity < n))
+			rs_realloc(s, n);
+
+		rs_heap_resize(s, n);
+	} else if (RS_HEAP_LIKELY(n > RS_STACK_CAPACITY)) {
+		rs_stack_to_heap(s, n);
+		rs_heap_resize(s, n);
+	} else {
+		rs_stack_resize(s, n);
+	}
+}
+
+RS_API void rs_resize_w(rapidstring *s, size_t n, char c)
+{
+	const size_t sz = rs_len(s);
+
+	rs_resize(s, n);
+
+	if (RS_LIKELY(sz < n)) {
+		const size_t diff = n - sz;
+		memset(rs_data(s) + sz, c, diff);
+	}
+}
+
+/*
+ * ===============================================================
+ *
+ *                         HEAP OPERATIONS
+ *
+ * ===============================================================
+ */
+
+RS_API void rs_heap_init(rapidstring *s, size_t n)
+{
+	s->heap.buffer = (char *)RS_MALLOC(n + 1);
+	s->heap.capacity = n;
+	s->heap.mode = 0;
+	s->heap.flag = RS_HEAP_FLAG;
+}
+
+RS_API void rs_heap_init_g(rapidstring *s, size_t n)
+{
+	rs_heap_init(s, n * RS_GROWTH_FACTOR);
+}
+
+RS_API void rs_heap_init_alloc(rapidstring *s, size_t n,
+			       const rs_allocator *a)
+{
+	rs_heap_header *header;
+
+	assert(a != NULL);
+	assert(a->allocate != NULL);
+	assert(a->deallocate != NULL);
+
+	header = (rs_heap_header *)a->allocate(
+		a->ctx, sizeof(rs_heap_header) + n + 1);
+	header->allocator = a;
+
+	s->heap.buffer = (char *)(header + 1);
+	s->heap.capacity = n;
+	s->heap.mode = RS_HEAP_MODE_ALLOC;
+	s->heap.flag = RS_HEAP_FLAG;
+}
+
+RS_API void rs_stack_to_heap(rapidstring *s, size_t n)
+{
+	const size_t stack_len = rs_stack_len(s);
+	char *buffer = (char *)RS_MALLOC(stack_len + n + 1);
+
+	/* The characters are copied before the heap fields overwrite them. */
+	memcpy(buffer, s->stack.buffer, stack_len);
+
+	s->heap.buffer = buffer;
+	s->heap.capacity = stack_len + n;
+	s->heap.mode = 0;
+	s->heap.flag = RS_HEAP_FLAG;
+	rs_heap_resize(s, stack_len);
+}
+
+RS_API void rs_stack_to_heap_g(rapidstring *s, size_t n)
+{
+	rs_stack_to_heap(s, n * RS_GROWTH_FACTOR);
+}
+
+RS_API void rs_realloc(rapidstring *s, size_t n)
+{
+	if (RS_UNLIKELY(s->heap.mode & RS_HEAP_MODE_SHARED)) {
+		rs_heap_unshare(s, n);
+		return;
+	}
+
+	/* The dropped characters are reclaimed by the new allocation. */
+	if (RS_UNLIKELY(s->heap.mode & RS_HEAP_MODE_OFFSET))
+		rs_heap_rebase(s, rs_heap_len(s) + 1);
+
+	if (RS_UNLIKELY(s->heap.mode & RS_HEAP_MODE_ALLOC)) {
+		rs_heap_header *header = RS_HEAP_HEADER(s);
+		const rs_allocator *a = header->allocator;
+		const size_t hdr_sz = sizeof(rs_heap_header);
+		const size_t old_n = hdr_sz + s->heap.capacity + 1;
+		const size_t new_n = hdr_sz + n + 1;
+
+		if (RS_LIKELY(a->reallocate != NULL)) {
+			header = (rs_heap_header *)a->reallocate(a->ctx, header,
+								 old_n, new_n);
+		} else {
+			void *block = a->allocate(a->ctx, new_n);
+			memcpy(block, header, old_n < new_n ? old_n : new_n);
+			a->deallocate(a->ctx, header, old_n);
+			header = (rs_heap_header *)block;
+		}
+
+		s->heap.buffer = (char *)(header + 1);
+	} else {
+		s->heap.buffer = (char *)RS_REALLOC(s->heap.buffer, n + 1);
+	}
+
+	s->heap.capacity = n;
+}
+
+RS_API void rs_grow_heap(rapidstring *s, size_t n)
+{
+	if (RS_UNLIKELY(s->heap.capacity < n))
+		rs_realloc(s, n * RS_GROWTH_FACTOR);
+	else if (RS_UNLIKELY(s->heap.mode & RS_HEAP_MODE_SHARED))
+		rs_heap_unshare(s, s->heap.capacity);
+}
+
+RS_API void rs_heap_free(rapidstring *s)
+{
+	assert(rs_is_heap(s));
+
+	if (RS_UNLIKELY(s->heap.mode & RS_HEAP_MODE_SHARED)) {
+		rs_shared_header *header = RS_SHARED_HEADER(s);
+
+		if (RS_SHARED_ADD(&header->refs, -1) == 0) {
+			const rs_allocator *a = header->header.allocator;
+
+			if (a != NULL)
+				a->deallocate(a->ctx, header,
+					      sizeof(rs_shared_header) +
+						      s->heap.capacity + 1);
+			else
+				RS_FREE(header);
+		}
+	} else if (RS_UNLIKELY(s->heap.mode & RS_HEAP_MODE_ALLOC)) {
+		rs_heap_header *header = RS_HEAP_HEADER(s);
+		const rs_allocator *a = header->allocator;
+
+		a->deallocate(a->ctx, header,
+			      sizeof(rs_heap_header) + rs_heap_offset(s) +
+				      s->heap.capacity + 1);
+	} else {
+		RS_FREE(s->heap.buffer - rs_heap_offset(s));
+	}
+}
+
+RS_API void rs_heap_skip(rapidstring *s, size_t n)
+{
+	size_t offset = rs_heap_offset(s) + n;
+	unsigned char *p;
+
+	assert(rs_is_heap(s));
+	assert(!(s->heap.mode & RS_HEAP_MODE_SHARED));
+	assert(n <= rs_heap_len(s));
+
+	if (RS_UNLIKELY(n == 0))
+		return;
+
+	s->heap.buffer += n;
+	s->heap.size -= n;
+	s->heap.capacity -= n;
+	s->heap.mode |= RS_HEAP_MODE_OFFSET;
+	s->heap.mode &= (unsigned char)~RS_HEAP_MODE_UTF8;
+
+	/* Seven bits per character, the first of them being the lowest. */
+	p = (unsigned char *)s->heap.buffer;
+
+	do {
+		const unsigned char bits = (unsigned char)(offset & 0x7F);
+
+		offset >>= 7;
+		*--p = (unsigned char)(bits | (offset != 0 ? 0x80 : 0));
+	} while (offset != 0);
+}
+
+RS_API size_t rs_heap_offset(const rapidstring *s)
+{
+	const unsigned char *p = (const unsigned char *)s->heap.buffer;
+	size_t offset = 0;
+	unsigned int shift = 0;
+
+	if (RS_LIKELY(!(s->heap.mode & RS_HEAP_MODE_OFFSET)))
+		return 0;
+
+	do {
+		offset |= (size_t)(*--p & 0x7F) << shift;
+		shift += 7;
+	} while (*p & 0x80);
+
+	return offset;
+}
+
+RS_API void rs_heap_rebase(rapidstring *s, size_t n)
+{
+	const size_t offset = rs_heap_offset(s);
+	char *buffer = s->heap.buffer - offset;
+
+	assert(s->heap.mode & RS_HEAP_MODE_OFFSET);
+
+	memmove(buffer, s->heap.buffer, n);
+	s->heap.buffer = buffer;
+	s->heap.capacity += offset;
+	s->heap.mode &= (unsigned char)~RS_HEAP_MODE_OFFSET;
+}
+
+/*
+ * ===============================================================
+ *
+ *                              ARENA
+ *
+ * ===============================================================
+ */
+
+/* Buffers must be aligned for the pointer of an rs_heap_header. */
+enum { RS_ARENA_ALIGN = sizeof(rs_align_dummy) };
+
+#define RS_ARENA_ROUND(n) \
+	(((n) + RS_ARENA_ALIGN - 1) & ~(size_t)(RS_ARENA_ALIGN - 1))
+#define RS_ARENA_DATA(block) ((char *)((block) + 1))
+
+RS_API void rs_arena_init(rs_arena *a, size_t block_size)
+{
+	assert(a != NULL);
+
+	a->allocator.allocate = rs_arena_allocate;
+	a->allocator.reallocate = rs_arena_reallocate;
+	a->allocator.deallocate = rs_arena_deallocate;
+	a->allocator.ctx = a;
+	a->head = NULL;
+	a->last = NULL;
+	a->block_size = block_size;
+}
+
+RS_API const rs_allocator *rs_arena_alloc(rs_arena *a)
+{
+	assert(a != NULL);
+
+	return &a->allocator;
+}
+
+RS_API void rs_arena_reset(rs_arena *a)
+{
+	assert(a != NULL);
+
+	if (RS_LIKELY(a->head != NULL)) {
+		rs_arena_block *block = a->head->next;
+
+		while (block != NULL) {
+			rs_arena_block *next = block->next;
+			RS_FREE(block);
+			block = next;
+		}
+
+		a->head->next = NULL;
+		a->head->used = 0;
+	}
+
+	a->last = NULL;
+}
+
+RS_API void rs_arena_free(rs_arena *a)
+{
+	rs_arena_reset(a);
+	RS_FREE(a->head);
+	a->head = NULL;
+}
+
+RS_API void *rs_arena_allocate(void *ctx, size_t n)
+{
+	rs_arena *a = (rs_arena *)ctx;
+	rs_arena_block *block = a->head;
+	const size_t sz = RS_ARENA_ROUND(n);
+
+	if (RS_UNLIKELY(block == NULL || block->capacity - block->used < sz)) {
+		const size_t cap = sz > a->block_size ? sz : a->block_size;
+
+		block = (rs_arena_block *)RS_MALLOC(sizeof(rs_arena_block) +
+						    cap);
+		block->next = a->head;
+		block->capacity = cap;
+		block->used = 0;
+		a->head = block;
+	}
+
+	a->last = RS_ARENA_DATA(block) + block->used;
+	block->used += sz;
+
+	return a->last;
+}
+
+RS_API void *rs_arena_reallocate(void *ctx, void *p, size_t old_n, size_t n)
+{
+	rs_arena *a = (rs_arena *)ctx;
+
+	if (RS_LIKELY(p == a->last)) {
+		rs_arena_block *block = a->head;
+		const size_t offset = (size_t)(a->last - RS_ARENA_DATA(block));
+
+		if (RS_LIKELY(block->capacity - offset >= RS_ARENA_ROUND(n))) {
+			block->used = offset + RS_ARENA_ROUND(n);
+			return p;
+		}
+	} else if (n <= old_n) {
+		return p;
+	}
+
+	return memcpy(rs_arena_allocate(ctx, n), p, old_n < n ? old_n : n);
+}
+
+RS_API void rs_arena_deallocate(void *ctx, void *p, size_t n)
+{
+	rs_arena *a = (rs_arena *)ctx;
+
+	(void)n;
+
+	if (p == a->last) {
+		a->head->used = (size_t)(a->last - RS_ARENA_DATA(a->head));
+		a->last = NULL;
+	}
+}
+
+/*
+ * ===============================================================
+ *
+ *                              POOL
+ *
+ * ===============================================================
+ */
+
+#ifdef RS_POOL
+
+static RS_THREAD_LOCAL rs_pool rs_pool_local;
+
+/* Buffers freed by a thread which did not allocate them, and their number. */
+static void *volatile rs_pool_depot[RS_POOL_CLASSES];
+static volatile long rs_pool_depot_count[RS_POOL_CLASSES];
+
+#define RS_POOL_NEXT(p) (*(void **)(p))
+#define RS_POOL_SIZE(cls) (((size_t)1 << ((cls) + RS_POOL_MIN_SHIFT)) + 1)
+
+RS_API void *rs_pool_malloc(size_t n)
+{
+	const size_t cls = rs_pool_class(n);
+	rs_pool *pool = &rs_pool_local;
+	rs_pool_header *header;
+
+	if (RS_UNLIKELY(cls == RS_POOL_CLASSES)) {
+		header = (rs_pool_header *)malloc(sizeof(rs_pool_header) + n);
+		pool = NULL;
+	} else if (RS_LIKELY(pool->lists[cls] != NULL)) {
+		header = (rs_pool_header *)pool->lists[cls];
+		pool->lists[cls] = RS_POOL_NEXT(header);
+		pool->counts[cls]--;
+	} else {
+		header = (rs_pool_header *)RS_ATOMIC_XCHG_PTR(
+			&rs_pool_depot[cls], NULL);
+
+		if (RS_LIKELY(header != NULL)) {
+			void *p = RS_POOL_NEXT(header);
+			long adopted = 1;
+
+			/* Adopt the remaining buffers handed back. */
+			pool->lists[cls] = p;
+
+			while (p != NULL) {
+				pool->counts[cls]++;
+				adopted++;
+				p = RS_POOL_NEXT(p);
+			}
+
+			RS_ATOMIC_ADD(&rs_pool_depot_count[cls], -adopted);
+		} else {
+			header = (rs_pool_header *)malloc(
+				sizeof(rs_pool_header) + RS_POOL_SIZE(cls));
+		}
+	}
+
+	header->info.owner = pool;
+	header->info.cls = cls;
+
+	return header + 1;
+}
+
+RS_API void *rs_pool_realloc(void *p, size_t n)
+{
+	rs_pool_header *header;
+	size_t old_n;
+	void *buffer;
+
+	if (RS_UNLIKELY(p == NULL))
+		return rs_pool_malloc(n);
+
+	header = (rs_pool_header *)p - 1;
+
+	if (RS_UNLIKELY(header->info.cls == RS_POOL_CLASSES)) {
+		if (RS_LIKELY(rs_pool_class(n) == RS_POOL_CLASSES)) {
+			header = (rs_pool_header *)realloc(
+				header, sizeof(rs_pool_header) + n);
+
+			return header + 1;
+		}
+
+		/* The size of an unpooled buffer is unknown, copy at most n. */
+		old_n = n;
+	} else {
+		old_n = RS_POOL_SIZE(header->info.cls);
+
+		if (n <= old_n)
+			return p;
+	}
+
+	buffer = rs_pool_malloc(n);
+	memcpy(buffer, p, old_n < n ? old_n : n);
+	rs_pool_free(p);
+
+	return buffer;
+}
+
+RS_API void rs_pool_free(void *p)
+{
+	rs_pool_header *header;
+	rs_pool *pool = &rs_pool_local;
+	size_t cls;
+
+	if (RS_UNLIKELY(p == NULL))
+		return;
+
+	header = (rs_pool_header *)p - 1;
+	cls = header->info.cls;
+
+	if (RS_UNLIKELY(cls == RS_POOL_CLASSES)) {
+		free(header);
+	} else if (RS_LIKELY(header->info.owner == pool)) {
+		if (RS_LIKELY(pool->counts[cls] < RS_POOL_CACHE)) {
+			RS_POOL_NEXT(header) = pool->lists[cls];
+			pool->lists[cls] = header;
+			pool->counts[cls]++;
+		} else {
+			free(header);
+		}
+	} else if (RS_UNLIKELY(RS_ATOMIC_ADD(&rs_pool_depot_count[cls], 1) >
+			       RS_POOL_DEPOT)) {
+		RS_ATOMIC_ADD(&rs_pool_depot_count[cls], -1);
+		free(header);
+	} else {
+		void *head;
+
+		do {
+			head = rs_pool_depot[cls];
+			RS_POOL_NEXT(header) = head;
+		} while (!RS_ATOMIC_CAS_PTR(&rs_pool_depot[cls], head, header));
+	}
+}
+
+RS_API void rs_pool_flush(void)
+{
+	rs_pool *pool = &rs_pool_local;
+	size_t i;
+
+	for (i = 0; i < RS_POOL_CLASSES; i++) {
+		void *p = RS_ATOMIC_XCHG_PTR(&rs_pool_depot[i], NULL);
+		long freed = 0;
+
+		while (p != NULL) {
+			void *next = RS_POOL_NEXT(p);
+			free(p);
+			p = next;
+			freed++;
+		}
+
+		RS_ATOMIC_ADD(&rs_pool_depot_count[i], -freed);
+
+		p = pool->lists[i];
+
+		while (p != NULL) {
+			void *next = RS_POOL_NEXT(p);
+			free(p);
+			p = next;
+		}
+
+		pool->lists[i] = NULL;
+		pool->counts[i] = 0;
+	}
+}
+
+RS_API size_t rs_pool_class(size_t n)
+{
+	if (n <= RS_POOL_SIZE(0))
+		return 0;
+
+	if (RS_UNLIKELY(n > RS_POOL_SIZE(RS_POOL_CLASSES - 1)))
+		return RS_POOL_CLASSES;
+
+	/* Sizes from 2^k + 2 to 2^(k + 1) + 1 are one class past 2^k. */
+	return rs_bsr((unsigned int)((n - 2) >> RS_POOL_MIN_SHIFT)) + 1;
+}
+
+#endif /* RS_POOL */
+
+/*
+ * ===============================================================
+ *
+ *                             SEARCH
+ *
+ * ===============================================================
+ */
+
+#ifdef RS_SIMD
+/*
+ * A stack string may be compared with vectors loaded over the entire union,
+ * which does not read out of bounds and whose result fits in a 32 bit mask.
+ */
+#define RS_STACK_VEC                      \
+	(sizeof(rapidstring) <= 32 && \
+	 sizeof(rapidstring) % RS_VEC_SIZE == 0)
+
+/* Mask of the first n bits, n being smaller than 32. */
+#define RS_LOW_MASK(n) ((1u << (n)) - 1)
+
+/*
+ * Returns a mask of the characters of a stack string equal to those of a
+ * vector. Characters past the length of the string are not masked.
+ */
+#define RS_STACK_MASK_EQ(s, v, mask)                                        \
+	do {                                                                \
+		const char *rs_p_ = (const char *)(s);                      \
+		size_t rs_i_;                                               \
+		mask = 0;                                                   \
+		for (rs_i_ = 0; rs_i_ < sizeof(rapidstring);                \
+		     rs_i_ += RS_VEC_SIZE) {                                \
+			const rs_vec rs_v_ = RS_VEC_LOAD(rs_p_ + rs_i_);     \
+			mask |= RS_VEC_MASK(RS_VEC_EQ(rs_v_, v)) << rs_i_; \
+		}                                                           \
+	} while (0)
+#endif
+
+RS_API size_t rs_find(const rapidstring *s, const char *needle)
+{
+	assert(needle != NULL);
+
+	return rs_find_n(s, needle, strlen(needle));
+}
+
+RS_API size_t rs_find_n(const rapidstring *s, const char *needle, size_t n)
+{
+	assert(needle != NULL);
+
+#ifdef RS_SIMD
+	if (RS_STACK_VEC && RS_STACK_LIKELY(rs_is_stack(s))) {
+		const size_t len = rs_stack_len(s);
+		unsigned int first;
+		unsigned int last;
+
+		if (RS_UNLIKELY(n == 0))
+			return 0;
+
+		if (RS_UNLIKELY(n > len))
+			return RS_NPOS;
+
+		RS_STACK_MASK_EQ(s, RS_VEC_SET1(needle[0]), first);
+		RS_STACK_MASK_EQ(s, RS_VEC_SET1(needle[n - 1]), last);
+
+		/* Candidates must have their last character matching too. */
+		first &= (last >> (n - 1)) & RS_LOW_MASK(len - n + 1);
+
+		while (first != 0) {
+			const unsigned int i = rs_ctz(first);
+
+			if (memcmp(s->stack.buffer + i, needle, n) == 0)
+				return i;
+
+			first &= first - 1;
+		}
+
+		return RS_NPOS;
+	}
+#endif
+
+	return rs_memmem(rs_data_c(s), rs_len(s), needle, n);
+}
+
+RS_API size_t rs_find_rs(const rapidstring *s, const rapidstring *needle)
+{
+	return rs_find_n(s, rs_data_c(needle), rs_len(needle));
+}
+
+RS_API size_t rs_find_v(const rapidstring *s, rs_view needle)
+{
+	return rs_find_n(s, needle.data, needle.size);
+}
+
+RS_API size_t rs_rfind(const rapidstring *s, const char *needle)
+{
+	assert(needle != NULL);
+
+	return rs_rfind_n(s, needle, strlen(needle));
+}
+
+RS_API size_t rs_rfind_n(const rapidstring *s, const char *needle, size_t n)
+{
+	assert(needle != NULL);
+
+	return rs_memrmem(rs_data_c(s), rs_len(s), needle, n);
+}
+
+RS_API size_t rs_rfind_rs(const rapidstring *s, const rapidstring *needle)
+{
+	return rs_rfind_n(s, rs_data_c(needle), rs_len(needle));
+}
+
+RS_API size_t rs_rfind_v(const rapidstring *s, rs_view needle)
+{
+	return rs_rfind_n(s, needle.data, needle.size);
+}
+
+RS_API size_t rs_find_char(const rapidstring *s, char c)
+{
+#ifdef RS_SIMD
+	if (RS_STACK_VEC && RS_STACK_LIKELY(rs_is_stack(s))) {
+		unsigned int mask;
+
+		RS_STACK_MASK_EQ(s, RS_VEC_SET1(c), mask);
+		mask &= RS_LOW_MASK(rs_stack_len(s));
+
+		return mask != 0 ? rs_ctz(mask) : RS_NPOS;
+	}
+#endif
+
+	return rs_memchr(rs_data_c(s), rs_len(s), c);
+}
+
+RS_API size_t rs_rfind_char(const rapidstring *s, char c)
+{
+#ifdef RS_SIMD
+	if (RS_STACK_VEC && RS_STACK_LIKELY(rs_is_stack(s))) {
+		unsigned int mask;
+
+		RS_STACK_MASK_EQ(s, RS_VEC_SET1(c), mask);
+		mask &= RS_LOW_MASK(rs_stack_len(s));
+
+		return mask != 0 ? rs_bsr(mask) : RS_NPOS;
+	}
+#endif
+
+	return rs_memrchr(rs_data_c(s), rs_len(s), c);
+}
+
+RS_API size_t rs_count(const rapidstring *s, const char *needle)
+{
+	assert(needle != NULL);
+
+	return rs_count_n(s, needle, strlen(needle));
+}
+
+RS_API size_t rs_count_n(const rapidstring *s, const char *needle, size_t n)
+{
+	const char *buffer = rs_data_c(s);
+	size_t len = rs_len(s);
+	size_t count = 0;
+	size_t i;
+
+	assert(needle != NULL);
+
+	if (RS_UNLIKELY(n == 0))
+		return 0;
+
+	if (n == 1)
+		return rs_memcount(buffer, len, needle[0]);
+
+	while ((i = rs_memmem(buffer, len, needle, n)) != RS_NPOS) {
+		count++;
+		buffer += i + n;
+		len -= i + n;
+	}
+
+	return count;
+}
+
+RS_API size_t rs_count_v(const rapidstring *s, rs_view needle)
+{
+	return rs_count_n(s, needle.data, needle.size);
+}
+
+RS_API size_t rs_count_char(const rapidstring *s, char c)
+{
+#ifdef RS_SIMD
+	if (RS_STACK_VEC && RS_STACK_LIKELY(rs_is_stack(s))) {
+		unsigned int mask;
+
+		RS_STACK_MASK_EQ(s, RS_VEC_SET1(c), mask);
+
+		return rs_popcount(mask & RS_LOW_MASK(rs_stack_len(s)));
+	}
+#endif
+
+	return rs_memcount(rs_data_c(s), rs_len(s), c);
+}
+
+RS_API size_t rs_memchr(const char *buffer, size_t len, char c)
+{
+#ifdef RS_SIMD
+	size_t i = 0;
+
+	if (RS_LIKELY(len >= RS_VEC_SIZE)) {
+		const rs_vec v = RS_VEC_SET1(c);
+		unsigned int mask;
+
+		for (; i + RS_VEC_SIZE <= len; i += RS_VEC_SIZE) {
+			const rs_vec b = RS_VEC_LOAD(buffer + i);
+
+			mask = RS_VEC_MASK(RS_VEC_EQ(b, v));
+
+			if (mask != 0)
+				return i + rs_ctz(mask);
+		}
+
+		if (i == len)
+			return RS_NPOS;
+
+		/* Overlap the last vector with the previous one. */
+		mask = RS_VEC_MASK(
+			RS_VEC_EQ(RS_VEC_LOAD(buffer + len - RS_VEC_SIZE), v));
+		mask >>= RS_VEC_SIZE - (len - i);
+
+		return mask != 0 ? i + rs_ctz(mask) : RS_NPOS;
+	}
+
+	for (; i < len; i++)
+		if (buffer[i] == c)
+			return i;
+
+	return RS_NPOS;
+#else
+	const char *p = (const char *)memchr(buffer, c, len);
+
+	return p != NULL ? (size_t)(p - buffer) : RS_NPOS;
+#endif
+}
+
+RS_API size_t rs_memrchr(const char *buffer, size_t len, char c)
+{
+	size_t i = len;
+
+#ifdef RS_SIMD
+	if (RS_LIKELY(len >= RS_VEC_SIZE)) {
+		const rs_vec v = RS_VEC_SET1(c);
+		unsigned int mask;
+
+		for (; i >= RS_VEC_SIZE; i -= RS_VEC_SIZE) {
+			mask = RS_VEC_MASK(RS_VEC_EQ(
+				RS_VEC_LOAD(buffer + i - RS_VEC_SIZE), v));
+
+			if (mask != 0)
+				return i - RS_VEC_SIZE + rs_bsr(mask);
+		}
+
+		if (i == 0)
+			return RS_NPOS;
+
+		/* Overlap the first vector with the previous one. */
+		mask = RS_VEC_MASK(RS_VEC_EQ(RS_VEC_LOAD(buffer), v));
+		mask &= RS_LOW_MASK(i);
+
+		return mask != 0 ? rs_bsr(mask) : RS_NPOS;
+	}
+#endif
+
+	while (i-- > 0)
+		if (buffer[i] == c)
+			return i;
+
+	return RS_NPOS;
+}
+
+RS_API size_t rs_memmem(const char *buffer, size_t len, const char *needle,
+			size_t n)
+{
+	size_t i = 0;
+
+	if (RS_UNLIKELY(n == 0))
+		return 0;
+
+	if (RS_UNLIKELY(n > len))
+		return RS_NPOS;
+
+	if (n == 1)
+		return rs_memchr(buffer, len, needle[0]);
+
+#ifdef RS_SIMD
+	{
+		const rs_vec first = RS_VEC_SET1(needle[0]);
+		const rs_vec last = RS_VEC_SET1(needle[n - 1]);
+
+		for (; i + n - 1 + RS_VEC_SIZE <= len; i += RS_VEC_SIZE) {
+			rs_vec f = RS_VEC_LOAD(buffer + i);
+			rs_vec l = RS_VEC_LOAD(buffer + i + n - 1);
+			unsigned int mask;
+
+			f = RS_VEC_EQ(f, first);
+			l = RS_VEC_EQ(l, last);
+			mask = RS_VEC_MASK(RS_VEC_AND(f, l));
+
+			while (mask != 0) {
+				const size_t j = i + rs_ctz(mask);
+				const char *p = buffer + j + 1;
+
+				if (memcmp(p, needle + 1, n - 2) == 0)
+					return j;
+
+				mask &= mask - 1;
+			}
+		}
+	}
+#endif
+
+	for (; i + n <= len; i++)
+		if (buffer[i] == needle[0] &&
+		    memcmp(buffer + i + 1, needle + 1, n - 1) == 0)
+			return i;
+
+	return RS_NPOS;
+}
+
+RS_API size_t rs_memrmem(const char *buffer, size_t len, const char *needle,
+			 size_t n)
+{
+	/* Number of positions left to check, from the end. */
+	size_t i;
+
+	if (RS_UNLIKELY(n == 0))
+		return len;
+
+	if (RS_UNLIKELY(n > len))
+		return RS_NPOS;
+
+	if (n == 1)
+		return rs_memrchr(buffer, len, needle[0]);
+
+	i = len - n + 1;
+
+#ifdef RS_SIMD
+	{
+		const rs_vec first = RS_VEC_SET1(needle[0]);
+		const rs_vec last = RS_VEC_SET1(needle[n - 1]);
+
+		while (i >= RS_VEC_SIZE) {
+			rs_vec f, l;
+			unsigned int mask;
+
+			i -= RS_VEC_SIZE;
+			f = RS_VEC_EQ(RS_VEC_LOAD(buffer + i), first);
+			l = RS_VEC_EQ(RS_VEC_LOAD(buffer + i + n - 1), last);
+			mask = RS_VEC_MASK(RS_VEC_AND(f, l));
+
+			while (mask != 0) {
+				const unsigned int bit = rs_bsr(mask);
+				const size_t j = i + bit;
+				const char *p = buffer + j + 1;
+
+				if (memcmp(p, needle + 1, n - 2) == 0)
+					return j;
+
+				mask &= ~(1u << bit);
+			}
+		}
+	}
+#endif
+
+	while (i-- > 0)
+		if (buffer[i] == needle[0] &&
+		    memcmp(buffer + i + 1, needle + 1, n - 1) == 0)
+			return i;
+
+	return RS_NPOS;
+}
+
+RS_API size_t rs_memcount(const char *buffer, size_t len, char c)
+{
+	size_t count = 0;
+	size_t i = 0;
+
+#ifdef RS_SIMD
+	const rs_vec v = RS_VEC_SET1(c);
+
+	for (; i + RS_VEC_SIZE <= len; i += RS_VEC_SIZE)
+		count += rs_popcount(
+			RS_VEC_MASK(RS_VEC_EQ(RS_VEC_LOAD(buffer + i), v)));
+#endif
+
+	for (; i < len; i++)
+		count += buffer[i] == c;
+
+	return count;
+}
+
+RS_API unsigned int rs_ctz(unsigned int mask)
+{
+	assert(mask != 0);
+
+#if RS_GCC_VERSION > 30400
+	return (unsigned int)__builtin_ctz(mask);
+#elif defined(_MSC_VER)
+	{
+		unsigned long i;
+		_BitScanForward(&i, mask);
+		return (unsigned int)i;
+	}
+#else
+	{
+		unsigned int i = 0;
+
+		while (!(mask & 1)) {
+			mask >>= 1;
+			i++;
+		}
+
+		return i;
+	}
+#endif
+}
+
+RS_API unsigned int rs_bsr(unsigned int mask)
+{
+	assert(mask != 0);
+
+#if RS_GCC_VERSION > 30400
+	return (unsigned int)(sizeof(mask) * 8 - 1) -
+	       (unsigned int)__builtin_clz(mask);
+#elif defined(_MSC_VER)
+	{
+		unsigned long i;
+		_BitScanReverse(&i, mask);
+		return (unsigned int)i;
+	}
+#else
+	{
+		unsigned int i = 0;
+
+		while (mask >>= 1)
+			i++;
+
+		return i;
+	}
+#endif
+}
+
+RS_API unsigned int rs_popcount(unsigned int mask)
+{
+#if RS_GCC_VERSION > 30400
+	return (unsigned int)__builtin_popcount(mask);
+#else
+	unsigned int count = 0;
+
+	while (mask != 0) {
+		mask &= mask - 1;
+		count++;
+	}
+
+	return count;
+#endif
+}
+
+/*
+ * ===============================================================
+ *
+ *                             COMPARE
+ *
+ * ===============================================================
+ */
+
+#ifdef RS_SIMD
+/*
+ * Returns a mask of the characters that differ between two stack strings.
+ * Characters past the lengths of the strings are not masked.
+ */
+#define RS_STACK_MASK_NE(a, b, mask)                                     \
+	do {                                                             \
+		const char *rs_a_ = (const char *)(a);                   \
+		const char *rs_b_ = (const char *)(b);                   \
+		size_t rs_i_;                                            \
+		mask = 0;                                                \
+		for (rs_i_ = 0; rs_i_ < sizeof(rapidstring);             \
+		     rs_i_ += RS_VEC_SIZE) {                             \
+			const rs_vec rs_v_ = RS_VEC_EQ(                  \
+				RS_VEC_LOAD(rs_a_ + rs_i_),              \
+				RS_VEC_LOAD(rs_b_ + rs_i_));             \
+			mask |= RS_VEC_MASK(rs_v_) << rs_i_;             \
+		}                                                        \
+		mask = ~mask;                                            \
+	} while (0)
+
+#if RS_HEAP_FLAG == 0xFF
+/*
+ * Stack strings loaded as vectors have a remaining capacity below 32, so
+ * their flags may only be combined into the heap flag if either is on the
+ * heap.
+ */
+#define RS_BOTH_STACK(a, b) \
+	(((a)->stack.left | (b)->stack.left) != RS_HEAP_FLAG)
+#else
+#define RS_BOTH_STACK(a, b) (rs_is_stack(a) && rs_is_stack(b))
+#endif
+#endif
+
+/* Difference of the unsigned characters of two buffers at an index. */
+#define RS_CHAR_DIFF(a, b, i)                       \
+	((int)((const unsigned char *)(a))[i] - \
+	 (int)((const unsigned char *)(b))[i])
+
+RS_API int rs_cmp(const rapidstring *s, const char *input)
+{
+	assert(input != NULL);
+
+	return rs_cmp_n(s, input, strlen(input));
+}
+
+RS_API int rs_cmp_n(const rapidstring *s, const char *input, size_t n)
+{
+	const size_t len = rs_len(s);
+	int cmp;
+
+	assert(input != NULL);
+
+	cmp = rs_memcmp(rs_data_c(s), input, len < n ? len : n);
+
+	if (cmp != 0)
+		return cmp;
+
+	return (len > n) - (len < n);
+}
+
+RS_API int rs_cmp_rs(const rapidstring *s, const rapidstring *input)
+{
+#ifdef RS_SIMD
+	if (RS_STACK_VEC && RS_STACK_LIKELY(RS_BOTH_STACK(s, input))) {
+		const size_t len = rs_stack_len(s);
+		const size_t n = rs_stack_len(input);
+		unsigned int mask;
+
+		RS_STACK_MASK_NE(s, input, mask);
+		mask &= RS_LOW_MASK(len < n ? len : n);
+
+		if (mask != 0) {
+			const char *a = s->stack.buffer;
+			const char *b = input->stack.buffer;
+
+			return RS_CHAR_DIFF(a, b, rs_ctz(mask));
+		}
+
+		return (len > n) - (len < n);
+	}
+#endif
+
+	return rs_cmp_n(s, rs_data_c(input), rs_len(input));
+}
+
+RS_API int rs_cmp_v(const rapidstring *s, rs_view input)
+{
+	return rs_cmp_n(s, input.data, input.size);
+}
+
+RS_API unsigned char rs_eq(const rapidstring *s, const char *input)
+{
+	assert(input != NULL);
+
+	return rs_eq_n(s, input, strlen(input));
+}
+
+RS_API unsigned char rs_eq_n(const rapidstring *s, const char *input,
+			     size_t n)
+{
+	assert(input != NULL);
+
+	return rs_len(s) == n && rs_memeq(rs_data_c(s), input, n);
+}
+
+RS_API unsigned char rs_eq_rs(const rapidstring *s, const rapidstring *input)
+{
+#ifdef RS_SIMD
+	if (RS_STACK_VEC && RS_STACK_LIKELY(RS_BOTH_STACK(s, input))) {
+		unsigned int mask;
+
+		/* Equal remaining capacities imply equal lengths. */
+		if (s->stack.left != input->stack.left)
+			return 0;
+
+		RS_STACK_MASK_NE(s, input, mask);
+
+		return (mask & RS_LOW_MASK(rs_stack_len(s))) == 0;
+	}
+#endif
+
+	return rs_eq_n(s, rs_data_c(input), rs_len(input));
+}
+
+RS_API unsigned char rs_eq_v(const rapidstring *s, rs_view input)
+{
+	return rs_eq_n(s, input.data, input.size);
+}
+
+RS_API unsigned char rs_starts_with(const rapidstring *s, const char *prefix)
+{
+	assert(prefix != NULL);
+
+	return rs_starts_with_n(s, prefix, strlen(prefix));
+}
+
+RS_API unsigned char rs_starts_with_n(const rapidstring *s, const char *prefix,
+				      size_t n)
+{
+	assert(prefix != NULL);
+
+	return rs_len(s) >= n && rs_memeq(rs_data_c(s), prefix, n);
+}
+
+RS_API unsigned char rs_starts_with_rs(const rapidstring *s,
+				       const rapidstring *prefix)
+{
+	return rs_starts_with_n(s, rs_data_c(prefix), rs_len(prefix));
+}
+
+RS_API unsigned char rs_starts_with_v(const rapidstring *s, rs_view prefix)
+{
+	return rs_starts_with_n(s, prefix.data, prefix.size);
+}
+
+RS_API unsigned char rs_ends_with(const rapidstring *s, const char *suffix)
+{
+	assert(suffix != NULL);
+
+	return rs_ends_with_n(s, suffix, strlen(suffix));
+}
+
+RS_API unsigned char rs_ends_with_n(const rapidstring *s, const char *suffix,
+				    size_t n)
+{
+	const size_t len = rs_len(s);
+
+	assert(suffix != NULL);
+
+	return len >= n && rs_memeq(rs_data_c(s) + len - n, suffix, n);
+}
+
+RS_API unsigned char rs_ends_with_rs(const rapidstring *s,
+				     const rapidstring *suffix)
+{
+	return rs_ends_with_n(s, rs_data_c(suffix), rs_len(suffix));
+}
+
+RS_API unsigned char rs_ends_with_v(const rapidstring *s, rs_view suffix)
+{
+	return rs_ends_with_n(s, suffix.data, suffix.size);
+}
+
+RS_API int rs_memcmp(const char *a, const char *b, size_t n)
+{
+#ifdef RS_SIMD
+	if (RS_LIKELY(n >= RS_VEC_SIZE)) {
+		size_t i = 0;
+		unsigned int mask;
+
+		for (; i + RS_VEC_SIZE <= n; i += RS_VEC_SIZE) {
+			mask = RS_VEC_MASK(RS_VEC_EQ(RS_VEC_LOAD(a + i),
+						     RS_VEC_LOAD(b + i)));
+			mask ^= RS_VEC_FULL;
+
+			if (mask != 0)
+				return RS_CHAR_DIFF(a, b, i + rs_ctz(mask));
+		}
+
+		if (i == n)
+			return 0;
+
+		/* Overlap the last vector with the previous one. */
+		i = n - RS_VEC_SIZE;
+		mask = RS_VEC_MASK(
+			RS_VEC_EQ(RS_VEC_LOAD(a + i), RS_VEC_LOAD(b + i)));
+		mask ^= RS_VEC_FULL;
+
+		return mask != 0 ? RS_CHAR_DIFF(a, b, i + rs_ctz(mask)) : 0;
+	}
+#endif
+
+	return memcmp(a, b, n);
+}
+
+RS_API unsigned char rs_memeq(const char *a, const char *b, size_t n)
+{
+#ifdef RS_SIMD
+	if (RS_LIKELY(n >= RS_VEC_SIZE)) {
+		size_t i = 0;
+
+		for (; i + RS_VEC_SIZE < n; i += RS_VEC_SIZE)
+			if (RS_VEC_MASK(RS_VEC_EQ(RS_VEC_LOAD(a + i),
+						  RS_VEC_LOAD(b + i))) !=
+			    RS_VEC_FULL)
+				return 0;
+
+		/* The last vector may overlap the previous one. */
+		i = n - RS_VEC_SIZE;
+
+		return RS_VEC_MASK(RS_VEC_EQ(
+			       RS_VEC_LOAD(a + i), RS_VEC_LOAD(b + i))) ==
+		       RS_VEC_FULL;
+	}
+#endif
+
+	return memcmp(a, b, n) == 0;
+}
+
+/*
+ * ===============================================================
+ *
+ *                              HASH
+ *
+ * ===============================================================
+ */
+
+#define RS_HASH_P0 UINT64_C(0xA0761D6478BD642F)
+#define RS_HASH_P1 UINT64_C(0xE7037ED1A0B428DB)
+#define RS_HASH_P2 UINT64_C(0x8EBC6AF09C88C6E3)
+#define RS_HASH_P3 UINT64_C(0x589965CC75374CC3)
+
+/* Number of stripes accumulated between two scrambles. */
+enum { RS_HASH_BLOCK = 32 };
+
+RS_API uint64_t rs_hash(const rapidstring *s)
+{
+	return rs_hash_seed(s, 0);
+}
+
+RS_API uint64_t rs_hash_seed(const rapidstring *s, uint64_t seed)
+{
+#ifdef RS_SIMD
+	if (RS_STACK_VEC && RS_STACK_LIKELY(rs_is_stack(s)))
+		return rs_hash_stack(s, seed, 0);
+#endif
+
+	return rs_hash_seed_n(rs_data_c(s), rs_len(s), seed);
+}
+
+RS_API uint64_t rs_hash_n(const char *input, size_t n)
+{
+	return rs_hash_seed_n(input, n, 0);
+}
+
+RS_API uint64_t rs_hash_seed_n(const char *input, size_t n, uint64_t seed)
+{
+	return rs_hash_fold_n(input, n, seed, 0);
+}
+
+RS_API uint64_t rs_hash_v(rs_view input)
+{
+	return rs_hash_seed_n(input.data, input.size, 0);
+}
+
+RS_API uint64_t rs_hash_fold_n(const char *input, size_t n, uint64_t seed,
+			       unsigned char fold)
+{
+	assert(input != NULL);
+
+	if (RS_LIKELY(n <= RS_HASH_STRIPE)) {
+		uint64_t w[RS_HASH_LANES] = { 0 };
+		size_t i;
+
+		memcpy(w, input, n);
+
+		if (fold)
+			for (i = 0; i < RS_HASH_LANES; i++)
+				w[i] = rs_fold64(w[i]);
+
+		return rs_hash_short(w, n, seed);
+	}
+
+	return rs_hash_long(input, n, seed, fold);
+}
+
+RS_API uint64_t rs_hash_stack(const rapidstring *s, uint64_t seed,
+			      unsigned char fold)
+{
+#ifdef RS_SIMD
+	if (RS_STACK_VEC) {
+		uint64_t w[RS_HASH_LANES] = { 0 };
+		const size_t len = rs_stack_len(s);
+		const rs_vec v = RS_VEC_SET1(len);
+		size_t i;
+
+		/* Clear the characters past the length, as if zero padded. */
+		for (i = 0; i < sizeof(rapidstring); i += RS_VEC_SIZE) {
+			const rs_vec index = RS_VEC_ADD(RS_VEC_INDEX,
+							RS_VEC_SET1(i));
+			rs_vec c = RS_VEC_LOAD((const char *)s + i);
+
+			if (fold)
+				c = RS_VEC_CASE(c, 'A', 'Z');
+
+			RS_VEC_STORE((char *)w + i,
+				     RS_VEC_AND(c, RS_VEC_GT(v, index)));
+		}
+
+		return rs_hash_short(w, len, seed);
+	}
+#endif
+
+	return rs_hash_fold_n(s->stack.buffer, rs_stack_len(s), seed, fold);
+}
+
+RS_API uint64_t rs_hash_short(const uint64_t *w, size_t n, uint64_t seed)
+{
+	uint64_t a;
+	uint64_t b;
+
+	seed ^= RS_HASH_P0;
+	a = rs_mix(w[0] ^ RS_HASH_P1, w[1] ^ seed);
+	b = rs_mix(w[2] ^ RS_HASH_P2, w[3] ^ seed);
+
+	return rs_mix(a ^ RS_HASH_P3, b ^ RS_HASH_P1 ^ (uint64_t)n);
+}
+
+RS_API uint64_t rs_hash_long(const char *input, size_t n, uint64_t seed,
+			     unsigned char fold)
+{
+	uint64_t acc[RS_HASH_LANES];
+	uint64_t key[RS_HASH_LANES];
+	/* The last stripe is always accumulated separately. */
+	const size_t stripes = (n - 1) / RS_HASH_STRIPE;
+	size_t i;
+	uint64_t h;
+
+	acc[0] = UINT64_C(0x9E3779B97F4A7C15);
+	acc[1] = UINT64_C(0xC2B2AE3D27D4EB4F);
+	acc[2] = UINT64_C(0x165667B19E3779F9);
+	acc[3] = UINT64_C(0x85EBCA77C2B2AE63);
+	key[0] = RS_HASH_P0 + seed;
+	key[1] = RS_HASH_P1 + seed;
+	key[2] = RS_HASH_P2 + seed;
+	key[3] = RS_HASH_P3 + seed;
+
+	for (i = 0; i + RS_HASH_BLOCK <= stripes; i += RS_HASH_BLOCK) {
+		rs_hash_accumulate(acc, key, input + i * RS_HASH_STRIPE,
+				   RS_HASH_BLOCK, fold);
+		rs_hash_scramble(acc, key);
+	}
+
+	rs_hash_accumulate(acc, key, input + i * RS_HASH_STRIPE, stripes - i,
+			   fold);
+
+	/* Overlap the last stripe with the previous one. */
+	rs_hash_accumulate(acc, key, input + n - RS_HASH_STRIPE, 1, fold);
+
+	h = rs_mix(acc[0] ^ key[2], acc[1] ^ key[3]) ^
+	    rs_mix(acc[2] ^ key[0], acc[3] ^ key[1]);
+
+	return rs_mix(h ^ RS_HASH_P0, RS_HASH_P1 ^ (uint64_t)n);
+}
+
+RS_API void rs_hash_accumulate(uint64_t *acc, const uint64_t *key,
+			       const char *input, size_t stripes,
+			       unsigned char fold)
+{
+#ifdef RS_SIMD
+	enum { VECS = RS_HASH_STRIPE / RS_VEC_SIZE };
+	rs_vec a[VECS];
+	rs_vec k[VECS];
+	size_t i;
+
+	for (i = 0; i < VECS; i++) {
+		a[i] = RS_VEC_LOAD((const char *)acc + i * RS_VEC_SIZE);
+		k[i] = RS_VEC_LOAD((const char *)key + i * RS_VEC_SIZE);
+	}
+
+	for (; stripes > 0; stripes--, input += RS_HASH_STRIPE) {
+		for (i = 0; i < VECS; i++) {
+			rs_vec d = RS_VEC_LOAD(input + i * RS_VEC_SIZE);
+			rs_vec x;
+
+			if (fold)
+				d = RS_VEC_CASE(d, 'A', 'Z');
+
+			x = RS_VEC_XOR(d, k[i]);
+
+			a[i] = RS_VEC_ADD64(a[i], RS_VEC_SWAP64(d));
+			a[i] = RS_VEC_ADD64(
+				a[i], RS_VEC_MUL32(x, RS_VEC_SRL64(x, 32)));
+		}
+	}
+
+	for (i = 0; i < VECS; i++)
+		RS_VEC_STORE((char *)acc + i * RS_VEC_SIZE, a[i]);
+#else
+	size_t i;
+
+	for (; stripes > 0; stripes--, input += RS_HASH_STRIPE) {
+		for (i = 0; i < RS_HASH_LANES; i++) {
+			const uint64_t w = rs_read64(input + i * 8);
+			const uint64_t d = fold ? rs_fold64(w) : w;
+			const uint64_t x = d ^ key[i];
+
+			/* Each lane also receives the data of its neighbour. */
+			acc[i ^ 1] += d;
+			acc[i] += (x & 0xFFFFFFFF) * (x >> 32);
+		}
+	}
+#endif
+}
+
+RS_API void rs_hash_scramble(uint64_t *acc, const uint64_t *key)
+{
+	size_t i;
+
+	for (i = 0; i < RS_HASH_LANES; i++) {
+		acc[i] ^= (acc[i] >> 47) ^ key[i];
+		acc[i] *= 0x9E3779B1;
+	}
+}
+
+RS_API uint64_t rs_mix(uint64_t a, uint64_t b)
+{
+#if defined(__SIZEOF_INT128__)
+	__extension__ typedef unsigned __int128 rs_u128;
+	const rs_u128 r = (rs_u128)a * b;
+
+	return (uint64_t)r ^ (uint64_t)(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	uint64_t hi;
+	const uint64_t lo = _umul128(a, b, &hi);
+
+	return lo ^ hi;
+#else
+	const uint64_t mask = 0xFFFFFFFF;
+	const uint64_t lo_lo = (a & mask) * (b & mask);
+	const uint64_t hi_lo = (a >> 32) * (b & mask);
+	const uint64_t lo_hi = (a & mask) * (b >> 32);
+	const uint64_t hi_hi = (a >> 32) * (b >> 32);
+	const uint64_t cross = (lo_lo >> 32) + (hi_lo & mask) + lo_hi;
+
+	return ((cross << 32) | (lo_lo & mask)) ^
+	       (hi_hi + (hi_lo >> 32) + (cross >> 32));
+#endif
+}
+
+RS_API uint64_t rs_read64(const char *p)
+{
+	uint64_t w;
+
+	memcpy(&w, p, sizeof(w));
+
+	return w;
+}
+
+/*
+ * ===============================================================
+ *
+ *                             INTERN
+ *
+ * ===============================================================
+ */
+
+/* Number of slots of a table when first used. */
+#define RS_INTERN_MIN_SLOTS (16)
+
+RS_API void rs_intern_init(rs_intern_table *t)
+{
+	assert(t != NULL);
+
+	rs_arena_init(&t->arena, RS_INTERN_CHUNK);
+	t->chunk = NULL;
+	t->left = 0;
+	t->entries = NULL;
+	t->size = 0;
+	t->capacity = 0;
+	t->slots = NULL;
+	t->mask = 0;
+}
+
+RS_API void rs_intern_free(rs_intern_table *t)
+{
+	assert(t != NULL);
+
+	rs_arena_free(&t->arena);
+	RS_FREE(t->entries);
+	RS_FREE(t->slots);
+}
+
+RS_API uint32_t rs_intern(rs_intern_table *t, const char *input)
+{
+	assert(input != NULL);
+
+	return rs_intern_n(t, input, strlen(input));
+}
+
+RS_API uint32_t rs_intern_n(rs_intern_table *t, const char *input, size_t n)
+{
+	return rs_intern_insert(t, input, n, rs_hash_n(input, n));
+}
+
+RS_API uint32_t rs_intern_rs(rs_intern_table *t, const rapidstring *input)
+{
+	return rs_intern_insert(t, rs_data_c(input), rs_len(input),
+				rs_hash(input));
+}
+
+RS_API uint32_t rs_intern_v(rs_intern_table *t, rs_view input)
+{
+	return rs_intern_n(t, input.data, input.size);
+}
+
+RS_API uint32_t rs_intern_find_n(const rs_intern_table *t, const char *input,
+				 size_t n)
+{
+	const rs_intern_slot *slot;
+
+	assert(t != NULL);
+
+	if (RS_UNLIKELY(t->slots == NULL))
+		return RS_INTERN_NONE;
+
+	slot = rs_intern_probe(t, input, n, (uint32_t)rs_hash_n(input, n));
+
+	/* An empty slot wraps around to #RS_INTERN_NONE. */
+	return slot->id - 1;
+}
+
+RS_API const char *rs_intern_data(const rs_intern_table *t, uint32_t id)
+{
+	assert(t != NULL);
+	assert(id < t->size);
+
+	return t->entries[id].data;
+}
+
+RS_API size_t rs_intern_len(const rs_intern_table *t, uint32_t id)
+{
+	assert(t != NULL);
+	assert(id < t->size);
+
+	return t->entries[id].size;
+}
+
+RS_API size_t rs_intern_size(const rs_intern_table *t)
+{
+	assert(t != NULL);
+
+	return t->size;
+}
+
+RS_API uint32_t rs_intern_insert(rs_intern_table *t, const char *input,
+				 size_t n, uint64_t hash)
+{
+	rs_intern_slot *slot;
+	rs_intern_entry *entry;
+
+	assert(t != NULL);
+	assert(input != NULL);
+	assert(t->size < RS_INTERN_NONE);
+
+	/* Keep the load factor under one half. */
+	if (RS_UNLIKELY((t->size + 1) * 2 > t->mask + 1))
+		rs_intern_grow(t);
+
+	slot = rs_intern_probe(t, input, n, (uint32_t)hash);
+
+	if (RS_LIKELY(slot->id != 0))
+		return slot->id - 1;
+
+	if (RS_UNLIKELY(t->size == t->capacity)) {
+		t->capacity = t->capacity != 0 ?
+				      t->capacity * RS_GROWTH_FACTOR :
+				      RS_INTERN_MIN_SLOTS / 2;
+		t->entries = (rs_intern_entry *)RS_REALLOC(
+			t->entries, t->capacity * sizeof(rs_intern_entry));
+	}
+
+	entry = t->entries + t->size;
+	entry->data = rs_intern_store(t, input, n);
+	entry->size = n;
+	slot->id = (uint32_t)++t->size;
+	slot->hash = (uint32_t)hash;
+
+	return slot->id - 1;
+}
+
+RS_API rs_intern_slot *rs_intern_probe(const rs_intern_table *t,
+				       const char *input, size_t n,
+				       uint32_t hash)
+{
+	size_t i = hash & t->mask;
+
+	for (;; i = (i + 1) & t->mask) {
+		rs_intern_slot *slot = t->slots + i;
+
+		if (slot->id == 0)
+			return slot;
+
+		if (slot->hash == hash) {
+			const rs_intern_entry *e = t->entries + slot->id - 1;
+
+			if (e->size == n && rs_memeq(e->data, input, n))
+				return slot;
+		}
+	}
+}
+
+RS_API void rs_intern_grow(rs_intern_table *t)
+{
+	const size_t old_n = t->slots != NULL ? t->mask + 1 : 0;
+	const size_t n = old_n != 0 ? old_n * 2 : RS_INTERN_MIN_SLOTS;
+	rs_intern_slot *old = t->slots;
+	size_t i;
+
+	t->slots = (rs_intern_slot *)RS_MALLOC(n * sizeof(rs_intern_slot));
+	t->mask = n - 1;
+	memset(t->slots, 0, n * sizeof(rs_intern_slot));
+
+	/* Strings are distinct, so only an empty slot must be found. */
+	for (i = 0; i < old_n; i++) {
+		if (old[i].id != 0) {
+			size_t j = old[i].hash & t->mask;
+
+			while (t->slots[j].id != 0)
+				j = (j + 1) & t->mask;
+
+			t->slots[j] = old[i];
+		}
+	}
+
+	RS_FREE(old);
+}
+
+RS_API const char *rs_intern_store(rs_intern_table *t, const char *input,
+				   size_t n)
+{
+	char *p;
+
+	if (RS_UNLIKELY(n + 1 > t->left)) {
+		/* Large strings would waste most of the current chunk. */
+		if (n + 1 > RS_INTERN_CHUNK / 2) {
+			p = (char *)rs_arena_allocate(&t->arena, n + 1);
+			memcpy(p, input, n);
+			p[n] = '\0';
+
+			return p;
+		}
+
+		t->chunk = (char *)rs_arena_allocate(&t->arena,
+						     RS_INTERN_CHUNK);
+		t->left = RS_INTERN_CHUNK;
+	}
+
+	p = t->chunk;
+	t->chunk += n + 1;
+	t->left -= n + 1;
+	memcpy(p, input, n);
+	p[n] = '\0';
+
+	return p;
+}
+
+/*
+ * ===============================================================
+ *
+ *                              VIEW
+ *
+ * ===============================================================
+ */
+
+RS_API rs_view rs_view_n(const char *input, size_t n)
+{
+	rs_view v;
+
+	assert(input != NULL);
+
+	v.data = input;
+	v.size = n;
+
+	return v;
+}
+
+RS_API rs_view rs_view_rs(const rapidstring *s)
+{
+	const unsigned char heap = rs_is_heap(s);
+	rs_view v;
+
+	/* Both members are selected from a single flag check. */
+	v.data = heap ? s->heap.buffer : s->stack.buffer;
+	v.size = heap ? s->heap.size : rs_stack_len(s);
+
+	return v;
+}
+
+RS_API rs_view rs_substr_view(const rapidstring *s, size_t pos, size_t n)
+{
+	return rs_view_substr(rs_view_rs(s), pos, n);
+}
+
+RS_API rs_view rs_view_substr(rs_view v, size_t pos, size_t n)
+{
+	assert(pos <= v.size);
+
+	v.data += pos;
+	v.size -= pos;
+
+	if (n < v.size)
+		v.size = n;
+
+	return v;
+}
+
+/*
+ * ===============================================================
+ *
+ *                             SHARED
+ *
+ * ===============================================================
+ */
+
+RS_API void rs_freeze(rapidstring *s)
+{
+	RS_ASSERT_RS(s);
+
+	if (RS_HEAP_LIKELY(rs_is_heap(s)) &&
+	    !(s->heap.mode & RS_HEAP_MODE_SHARED)) {
+		const size_t len = rs_heap_len(s);
+		const size_t sz = sizeof(rs_shared_header) + len + 1;
+		const rs_allocator *a = rs_get_alloc(s);
+		rs_shared_header *header;
+
+		if (RS_UNLIKELY(a != NULL))
+			header = (rs_shared_header *)a->allocate(a->ctx, sz);
+		else
+			header = (rs_shared_header *)RS_MALLOC(sz);
+
+		header->refs = 1;
+		header->header.allocator = a;
+		memcpy(header + 1, s->heap.buffer, len + 1);
+
+		rs_heap_free(s);
+		s->heap.buffer = (char *)(header + 1);
+		s->heap.capacity = len;
+		s->heap.mode &= (unsigned char)~RS_HEAP_MODE_OFFSET;
+		s->heap.mode |= RS_HEAP_MODE_SHARED;
+	}
+}
+
+RS_API void rs_thaw(rapidstring *s)
+{
+	if (RS_UNLIKELY(rs_is_shared(s)))
+		rs_heap_unshare(s, rs_heap_len(s));
+}
+
+RS_API unsigned char rs_is_shared(const rapidstring *s)
+{
+	return rs_is_heap(s) && (s->heap.mode & RS_HEAP_MODE_SHARED);
+}
+
+RS_API long rs_shared_refs(const rapidstring *s)
+{
+	return rs_is_shared(s) ? RS_SHARED_HEADER(s)->refs : 1;
+}
+
+RS_API void rs_heap_unshare(rapidstring *s, size_t n)
+{
+	const rs_allocator *a = rs_get_alloc(s);
+	const size_t len = rs_heap_len(s);
+	rapidstring shared = *s;
+
+	assert(rs_is_shared(s));
+
+	if (RS_UNLIKELY(a != NULL))
+		rs_heap_init_alloc(s, n, a);
+	else
+		rs_heap_init(s, n);
+
+	rs_heap_cpy_n(s, shared.heap.buffer, len < n ? len : n);
+	rs_heap_free(&shared);
+}
+
+/*
+ * ===============================================================
+ *
+ *                              ROPE
+ *
+ * ===============================================================
+ */
+
+#define RS_ROPE_IS_LEAF(t) ((t)->height == 1)
+#define RS_ROPE_LEFT(t) ((t)->u.node.left)
+#define RS_ROPE_RIGHT(t) ((t)->u.node.right)
+
+RS_API void rs_rope_init(rs_rope *r)
+{
+	assert(r != NULL);
+
+	r->root = NULL;
+}
+
+RS_API void rs_rope_free(rs_rope *r)
+{
+	assert(r != NULL);
+
+	rs_rope_free_node(r->root);
+}
+
+RS_API size_t rs_rope_len(const rs_rope *r)
+{
+	assert(r != NULL);
+
+	return r->root != NULL ? r->root->len : 0;
+}
+
+RS_API char rs_rope_at(const rs_rope *r, size_t i)
+{
+	const rs_rope_node *t = r->root;
+
+	assert(i < rs_rope_len(r));
+
+	while (!RS_ROPE_IS_LEAF(t)) {
+		const size_t left_len = RS_ROPE_LEFT(t)->len;
+
+		if (i < left_len) {
+			t = RS_ROPE_LEFT(t);
+		} else {
+			i -= left_len;
+			t = RS_ROPE_RIGHT(t);
+		}
+	}
+
+	return rs_data_c(&t->u.leaf)[i];
+}
+
+RS_API void rs_rope_cat(rs_rope *r, const char *input)
+{
+	assert(input != NULL);
+
+	rs_rope_cat_n(r, input, strlen(input));
+}
+
+RS_API void rs_rope_cat_n(rs_rope *r, const char *input, size_t n)
+{
+	rs_rope_node *t = r->root;
+
+	assert(input != NULL);
+
+	if (RS_LIKELY(t != NULL)) {
+		rs_rope_node *leaf = t;
+
+		while (!RS_ROPE_IS_LEAF(leaf))
+			leaf = RS_ROPE_RIGHT(leaf);
+
+		/* Fill the last leaf before adding new ones. */
+		if (RS_LIKELY(leaf->len < RS_ROPE_LEAF)) {
+			const size_t left = RS_ROPE_LEAF - leaf->len;
+			const size_t k = n < left ? n : left;
+
+			rs_cat_n(&leaf->u.leaf, input, k);
+
+			for (; t != leaf; t = RS_ROPE_RIGHT(t))
+				t->len += k;
+
+			leaf->len += k;
+			input += k;
+			n -= k;
+		}
+	}
+
+	if (n != 0)
+		r->root = rs_rope_join(r->root, rs_rope_build(input, n));
+}
+
+RS_API void rs_rope_cat_rs(rs_rope *r, const rapidstring *input)
+{
+	rs_rope_cat_n(r, rs_data_c(input), rs_len(input));
+}
+
+RS_API void rs_rope_cat_rope(rs_rope *r, rs_rope *input)
+{
+	assert(r != input);
+
+	r->root = rs_rope_join(r->root, input->root);
+	input->root = NULL;
+}
+
+RS_API void rs_rope_insert_n(rs_rope *r, size_t index, const char *input,
+			     size_t n)
+{
+	rs_rope_node *right;
+
+	assert(input != NULL);
+	assert(index <= rs_rope_len(r));
+
+	if (RS_UNLIKELY(n == 0))
+		return;
+
+	if (RS_LIKELY(r->root != NULL)) {
+		rs_rope_node *leaf = r->root;
+		size_t i = index;
+
+		while (!RS_ROPE_IS_LEAF(leaf)) {
+			if (i <= RS_ROPE_LEFT(leaf)->len) {
+				leaf = RS_ROPE_LEFT(leaf);
+			} else {
+				i -= RS_ROPE_LEFT(leaf)->len;
+				leaf = RS_ROPE_RIGHT(leaf);
+			}
+		}
+
+		/* Fill the leaf holding the index before adding new ones. */
+		if (RS_LIKELY(n <= RS_ROPE_LEAF - leaf->len)) {
+			rs_rope_node *t = r->root;
+
+			rs_insert_n(&leaf->u.leaf, i, input, n);
+
+			for (i = index; t != leaf;) {
+				const size_t left_len = RS_ROPE_LEFT(t)->len;
+
+				t->len += n;
+
+				if (i <= left_len) {
+					t = RS_ROPE_LEFT(t);
+				} else {
+					i -= left_len;
+					t = RS_ROPE_RIGHT(t);
+				}
+			}
+
+			leaf->len += n;
+
+			return;
+		}
+	}
+
+	/* The leaf left of the split has room again, which appending fills. */
+	rs_rope_split_node(r->root, index, &r->root, &right);
+	rs_rope_cat_n(r, input, n);
+	r->root = rs_rope_join(r->root, right);
+}
+
+RS_API void rs_rope_erase(rs_rope *r, size_t index, size_t n)
+{
+	rs_rope_node *left;
+	rs_rope_node *mid;
+	rs_rope_node *right;
+
+	assert(index <= rs_rope_len(r));
+	assert(n <= rs_rope_len(r) - index);
+
+	rs_rope_split_node(r->root, index, &left, &mid);
+	rs_rope_split_node(mid, n, &mid, &right);
+	rs_rope_free_node(mid);
+	r->root = rs_rope_join(left, right);
+}
+
+RS_API void rs_rope_split(rs_rope *r, size_t index, rs_rope *out)
+{
+	assert(out != NULL);
+	assert(index <= rs_rope_len(r));
+
+	rs_rope_split_node(r->root, index, &r->root, &out->root);
+}
+
+RS_API void rs_rope_substr(const rs_rope *r, size_t index, size_t n,
+			   rapidstring *s)
+{
+	const size_t len = rs_rope_len(r);
+
+	assert(index <= len);
+
+	if (n > len - index)
+		n = len - index;
+
+	rs_clear(s);
+	rs_resize(s, n);
+
+	if (RS_LIKELY(n != 0))
+		rs_rope_copy(r->root, index, n, rs_data(s));
+}
+
+RS_API void rs_rope_flatten(const rs_rope *r, rapidstring *s)
+{
+	rs_rope_substr(r, 0, rs_rope_len(r), s);
+}
+
+RS_API rs_rope_node *rs_rope_leaf(const char *input, size_t n)
+{
+	rs_rope_node *t = (rs_rope_node *)RS_MALLOC(sizeof(rs_rope_node));
+
+	assert(n <= RS_ROPE_LEAF);
+
+	t->len = n;
+	t->height = 1;
+	rs_init_w_n(&t->u.leaf, input, n);
+
+	return t;
+}
+
+RS_API rs_rope_node *rs_rope_build(const char *input, size_t n)
+{
+	rs_rope_node *t;
+	size_t half;
+
+	assert(n != 0);
+
+	if (n <= RS_ROPE_LEAF)
+		return rs_rope_leaf(input, n);
+
+	/* Halving the number of full leaves keeps both sides balanced. */
+	half = (n + RS_ROPE_LEAF - 1) / RS_ROPE_LEAF / 2 * RS_ROPE_LEAF;
+
+	t = (rs_rope_node *)RS_MALLOC(sizeof(rs_rope_node));
+	RS_ROPE_LEFT(t) = rs_rope_build(input, half);
+	RS_ROPE_RIGHT(t) = rs_rope_build(input + half, n - half);
+	rs_rope_update(t);
+
+	return t;
+}
+
+RS_API void rs_rope_free_node(rs_rope_node *t)
+{
+	if (t == NULL)
+		return;
+
+	if (RS_ROPE_IS_LEAF(t)) {
+		rs_free(&t->u.leaf);
+	} else {
+		rs_rope_free_node(RS_ROPE_LEFT(t));
+		rs_rope_free_node(RS_ROPE_RIGHT(t));
+	}
+
+	RS_FREE(t);
+}
+
+RS_API void rs_rope_update(rs_rope_node *t)
+{
+	const rs_rope_node *l = RS_ROPE_LEFT(t);
+	const rs_rope_node *r = RS_ROPE_RIGHT(t);
+
+	t->len = l->len + r->len;
+	t->height = (l->height > r->height ? l->height : r->height) + 1;
+}
+
+RS_API rs_rope_node *rs_rope_rotate_left(rs_rope_node *t)
+{
+	rs_rope_node *r = RS_ROPE_RIGHT(t);
+
+	assert(!RS_ROPE_IS_LEAF(r));
+
+	RS_ROPE_RIGHT(t) = RS_ROPE_LEFT(r);
+	rs_rope_update(t);
+	RS_ROPE_LEFT(r) = t;
+	rs_rope_update(r);
+
+	return r;
+}
+
+RS_API rs_rope_node *rs_rope_rotate_right(rs_rope_node *t)
+{
+	rs_rope_node *l = RS_ROPE_LEFT(t);
+
+	assert(!RS_ROPE_IS_LEAF(l));
+
+	RS_ROPE_LEFT(t) = RS_ROPE_RIGHT(l);
+	rs_rope_update(t);
+	RS_ROPE_RIGHT(l) = t;
+	rs_rope_update(l);
+
+	return l;
+}
+
+RS_API rs_rope_node *rs_rope_join3(rs_rope_node *l, rs_rope_node *mid,
+				   rs_rope_node *r)
+{
+	if (l->height > r->height + 1)
+		return rs_rope_join_right(l, mid, r);
+
+	if (r->height > l->height + 1)
+		return rs_rope_join_left(l, mid, r);
+
+	RS_ROPE_LEFT(mid) = l;
+	RS_ROPE_RIGHT(mid) = r;
+	rs_rope_update(mid);
+
+	return mid;
+}
+
+RS_API rs_rope_node *rs_rope_join_right(rs_rope_node *l, rs_rope_node *mid,
+					rs_rope_node *r)
+{
+	rs_rope_node *c = RS_ROPE_RIGHT(l);
+
+	if (c->height <= r->height + 1) {
+		RS_ROPE_LEFT(mid) = c;
+		RS_ROPE_RIGHT(mid) = r;
+		rs_rope_update(mid);
+
+		if (mid->height > RS_ROPE_LEFT(l)->height + 1)
+			mid = rs_rope_rotate_right(mid);
+	} else {
+		mid = rs_rope_join_right(c, mid, r);
+	}
+
+	RS_ROPE_RIGHT(l) = mid;
+	rs_rope_update(l);
+
+	if (mid->height > RS_ROPE_LEFT(l)->height + 1)
+		return rs_rope_rotate_left(l);
+
+	return l;
+}
+
+RS_API rs_rope_node *rs_rope_join_left(rs_rope_node *l, rs_rope_node *mid,
+				       rs_rope_node *r)
+{
+	rs_rope_node *c = RS_ROPE_LEFT(r);
+
+	if (c->height <= l->height + 1) {
+		RS_ROPE_LEFT(mid) = l;
+		RS_ROPE_RIGHT(mid) = c;
+		rs_rope_update(mid);
+
+		if (mid->height > RS_ROPE_RIGHT(r)->height + 1)
+			mid = rs_rope_rotate_left(mid);
+	} else {
+		mid = rs_rope_join_left(l, mid, c);
+	}
+
+	RS_ROPE_LEFT(r) = mid;
+	rs_rope_update(r);
+
+	if (mid->height > RS_ROPE_RIGHT(r)->height + 1)
+		return rs_rope_rotate_right(r);
+
+	return r;
+}
+
+RS_API rs_rope_node *rs_rope_join(rs_rope_node *l, rs_rope_node *r)
+{
+	if (l == NULL)
+		return r;
+
+	if (r == NULL)
+		return l;
+
+	if (RS_ROPE_IS_LEAF(l) && RS_ROPE_IS_LEAF(r) &&
+	    l->len + r->len <= RS_ROPE_LEAF) {
+		rs_cat_rs(&l->u.leaf, &r->u.leaf);
+		l->len += r->len;
+		rs_rope_free_node(r);
+
+		return l;
+	}
+
+	return rs_rope_join3(
+		l, (rs_rope_node *)RS_MALLOC(sizeof(rs_rope_node)), r);
+}
+
+RS_API void rs_rope_split_node(rs_rope_node *t, size_t index,
+			       rs_rope_node **l, rs_rope_node **r)
+{
+	rs_rope_node *left;
+	rs_rope_node *right;
+	rs_rope_node *part;
+
+	if (t == NULL) {
+		*l = NULL;
+		*r = NULL;
+	} else if (RS_ROPE_IS_LEAF(t)) {
+		if (index == 0) {
+			*l = NULL;
+			*r = t;
+		} else if (index >= t->len) {
+			*l = t;
+			*r = NULL;
+		} else {
+			*r = rs_rope_leaf(rs_data_c(&t->u.leaf) + index,
+					  t->len - index);
+			rs_resize(&t->u.leaf, index);
+			t->len = index;
+			*l = t;
+		}
+	} else {
+		left = RS_ROPE_LEFT(t);
+		right = RS_ROPE_RIGHT(t);
+
+		if (index < left->len) {
+			rs_rope_split_node(left, index, l, &part);
+			*r = part != NULL ? rs_rope_join3(part, t, right) :
+					    right;
+		} else if (index > left->len) {
+			rs_rope_split_node(right, index - left->len, &part, r);
+			*l = part != NULL ? rs_rope_join3(left, t, part) :
+					    left;
+		} else {
+			*l = left;
+			*r = right;
+			part = NULL;
+		}
+
+		/* The node is only reused if a part is left to join. */
+		if (part == NULL)
+			RS_FREE(t);
+	}
+}
+
+RS_API void rs_rope_copy(const rs_rope_node *t, size_t index, size_t n,
+			 char *out)
+{
+	while (!RS_ROPE_IS_LEAF(t)) {
+		const size_t left_len = RS_ROPE_LEFT(t)->len;
+
+		if (index + n <= left_len) {
+			t = RS_ROPE_LEFT(t);
+		} else if (index >= left_len) {
+			index -= left_len;
+			t = RS_ROPE_RIGHT(t);
+		} else {
+			rs_rope_copy(RS_ROPE_LEFT(t), index, left_len - index,
+				     out);
+			out += left_len - index;
+			n -= left_len - index;
+			index = 0;
+			t = RS_ROPE_RIGHT(t);
+		}
+	}
+
+	memcpy(out, rs_data_c(&t->u.leaf) + index, n);
+}
+
+/*
+ * ===============================================================
+ *
+ *                             NUMBER
+ *
+ * ===============================================================
+ */
+
+RS_API void rs_cat_u64(rapidstring *s, uint64_t n)
+{
+	const size_t len = rs_u64_len(n);
+	const size_t size = rs_len(s);
+
+	rs_u64_write(rs_cat_reserve(s, len), n, len);
+	rs_resize(s, size + len);
+}
+
+RS_API void rs_cat_i64(rapidstring *s, int64_t n)
+{
+	/* Negated as unsigned to handle the smallest value. */
+	const uint64_t abs = n < 0 ? (uint64_t)0 - (uint64_t)n : (uint64_t)n;
+	const size_t sign = n < 0;
+	const size_t len = rs_u64_len(abs) + sign;
+	const size_t size = rs_len(s);
+	char *buffer = rs_cat_reserve(s, len);
+
+	if (sign)
+		*buffer = '-';
+
+	rs_u64_write(buffer + sign, abs, len - sign);
+	rs_resize(s, size + len);
+}
+
+RS_API void rs_cat_hex(rapidstring *s, uint64_t n)
+{
+	rs_cat_hex_digits(s, n, "0123456789abcdef");
+}
+
+RS_API void rs_cat_hex_upper(rapidstring *s, uint64_t n)
+{
+	rs_cat_hex_digits(s, n, "0123456789ABCDEF");
+}
+
+RS_API void rs_cat_double(rapidstring *s, double n)
+{
+	char buffer[RS_DTOA_MAX];
+
+	rs_cat_n(s, buffer, rs_dtoa(buffer, n));
+}
+
+RS_API size_t rs_u64_len(uint64_t n)
+{
+	size_t len = 1;
+
+	for (;;) {
+		if (n < 10)
+			return len;
+		if (n < 100)
+			return len + 1;
+		if (n < 1000)
+			return len + 2;
+		if (n < 10000)
+			return len + 3;
+
+		n /= 10000;
+		len += 4;
+	}
+}
+
+RS_API void rs_u64_write(char *buffer, uint64_t n, size_t len)
+{
+	static const char pairs[] = "00010203040506070809"
+				    "10111213141516171819"
+				    "20212223242526272829"
+				    "30313233343536373839"
+				    "40414243444546474849"
+				    "50515253545556575859"
+				    "60616263646566676869"
+				    "70717273747576777879"
+				    "80818283848586878889"
+				    "90919293949596979899";
+	char *p = buffer + len;
+
+	assert(buffer != NULL);
+	assert(rs_u64_len(n) == len);
+
+	/* Two digits at a time halves the amount of divisions. */
+	while (n >= 100) {
+		const size_t i = (size_t)(n % 100) * 2;
+
+		n /= 100;
+		*--p = pairs[i + 1];
+		*--p = pairs[i];
+	}
+
+	if (n >= 10) {
+		const size_t i = (size_t)n * 2;
+
+		*--p = pairs[i + 1];
+		*--p = pairs[i];
+	} else {
+		*--p = (char)('0' + n);
+	}
+}
+
+RS_API void rs_cat_hex_digits(rapidstring *s, uint64_t n, const char *digits)
+{
+	const size_t size = rs_len(s);
+	size_t len = 1;
+	uint64_t rest = n >> 4;
+	char *p;
+
+	while (rest != 0) {
+		rest >>= 4;
+		len++;
+	}
+
+	p = rs_cat_reserve(s, len) + len;
+
+	do {
+		*--p = digits[n & 0xF];
+		n >>= 4;
+	} while (n != 0);
+
+	rs_resize(s, size + len);
+}
+
+RS_API size_t rs_dtoa(char *buffer, double n)
+{
+	uint64_t bits;
+	size_t sign;
+	int k;
+	int len;
+
+	assert(buffer != NULL);
+
+	memcpy(&bits, &n, sizeof(bits));
+	sign = (size_t)(bits >> 63);
+
+	if (RS_UNLIKELY((bits & UINT64_C(0x7FF0000000000000)) ==
+			UINT64_C(0x7FF0000000000000))) {
+		if (bits & UINT64_C(0x000FFFFFFFFFFFFF)) {
+			memcpy(buffer, "nan", 3);
+			return 3;
+		}
+
+		if (sign) {
+			memcpy(buffer, "-inf", 4);
+			return 4;
+		}
+
+		memcpy(buffer, "inf", 3);
+		return 3;
+	}
+
+	if (sign)
+		*buffer = '-';
+
+	if (RS_UNLIKELY((bits << 1) == 0)) {
+		buffer[sign] = '0';
+		return sign + 1;
+	}
+
+	len = rs_grisu2(buffer + sign, sign ? -n : n, &k);
+
+	return sign + rs_dtoa_format(buffer + sign, len, k);
+}
+
+RS_API int rs_grisu2(char *buffer, double n, int *k)
+{
+	const uint64_t hidden = UINT64_C(0x0010000000000000);
+	rs_diy_fp v;
+	rs_diy_fp plus;
+	rs_diy_fp minus;
+	rs_diy_fp c;
+	uint64_t bits;
+	int biased;
+
+	assert(n > 0);
+
+	memcpy(&bits, &n, sizeof(bits));
+	biased = (int)(bits >> 52);
+	v.f = bits & (hidden - 1);
+
+	if (RS_LIKELY(biased != 0)) {
+		v.f += hidden;
+		v.e = biased - 1075;
+	} else {
+		v.e = -1074;
+	}
+
+	/* The boundaries are halfway to the neighbouring doubles. */
+	plus.f = (v.f << 1) + 1;
+	plus.e = v.e - 1;
+
+	while (!(plus.f & (hidden << 1))) {
+		plus.f <<= 1;
+		plus.e--;
+	}
+
+	plus.f <<= 10;
+	plus.e -= 10;
+
+	/* The lower neighbour of a power of two is twice as close. */
+	if (v.f == hidden) {
+		minus.f = (v.f << 2) - 1;
+		minus.e = v.e - 2;
+	} else {
+		minus.f = (v.f << 1) - 1;
+		minus.e = v.e - 1;
+	}
+
+	minus.f <<= minus.e - plus.e;
+	minus.e = plus.e;
+
+	while (!(v.f & ((uint64_t)1 << 63))) {
+		v.f <<= 1;
+		v.e--;
+	}
+
+	c = rs_cached_power(plus.e, k);
+	v = rs_diy_mul(v, c);
+	plus = rs_diy_mul(plus, c);
+	minus = rs_diy_mul(minus, c);
+
+	/* Shrinks the boundaries by the error of the multiplications. */
+	minus.f++;
+	plus.f--;
+
+	return rs_grisu_digits(v, plus, plus.f - minus.f, buffer, k);
+}
+
+RS_API size_t rs_dtoa_format(char *buffer, int len, int k)
+{
+	/* Position of the decimal point relative to the first digit. */
+	const int point = len + k;
+	int e;
+	char *p;
+
+	if (len <= point && point <= 21) {
+		memset(buffer + len, '0', (size_t)k);
+		return (size_t)point;
+	}
+
+	if (0 < point && point <= 21) {
+		memmove(buffer + point + 1, buffer + point, (size_t)-k);
+		buffer[point] = '.';
+		return (size_t)len + 1;
+	}
+
+	if (-6 < point && point <= 0) {
+		memmove(buffer + 2 - point, buffer, (size_t)len);
+		buffer[0] = '0';
+		buffer[1] = '.';
+		memset(buffer + 2, '0', (size_t)-point);
+		return (size_t)(len + 2 - point);
+	}
+
+	e = point - 1;
+
+	if (len == 1) {
+		p = buffer + 1;
+	} else {
+		memmove(buffer + 2, buffer + 1, (size_t)len - 1);
+		buffer[1] = '.';
+		p = buffer + len + 1;
+	}
+
+	*p++ = 'e';
+	*p++ = e < 0 ? '-' : '+';
+	e = e < 0 ? -e : e;
+	rs_u64_write(p, (uint64_t)e, rs_u64_len((uint64_t)e));
+
+	return (size_t)(p - buffer) + rs_u64_len((uint64_t)e);
+}
+
+RS_API rs_diy_fp rs_diy_mul(rs_diy_fp x, rs_diy_fp y)
+{
+	const uint64_t m32 = 0xFFFFFFFF;
+	const uint64_t a = x.f >> 32;
+	const uint64_t b = x.f & m32;
+	const uint64_t c = y.f >> 32;
+	const uint64_t d = y.f & m32;
+	const uint64_t ac = a * c;
+	const uint64_t bc = b * c;
+	const uint64_t ad = a * d;
+	const uint64_t bd = b * d;
+	uint64_t mid = (bd >> 32) + (ad & m32) + (bc & m32);
+	rs_diy_fp r;
+
+	/* Rounds the discarded low half. */
+	mid += (uint64_t)1 << 31;
+
+	r.f = ac + (ad >> 32) + (bc >> 32) + (mid >> 32);
+	r.e = x.e + y.e + 64;
+
+	return r;
+}
+
+RS_API rs_diy_fp rs_cached_power(int e, int *k)
+{
+	/* Normalized powers of ten from 10^-348 to 10^340, in steps of 8. */
+	static const uint64_t pow_f[] = {
+		UINT64_C(0xFA8FD5A0081C0288), UINT64_C(0xBAAEE17FA23EBF76),
+		UINT64_C(0x8B16FB203055AC76), UINT64_C(0xCF42894A5DCE35EA),
+		UINT64_C(0x9A6BB0AA55653B2D), UINT64_C(0xE61ACF033D1A45DF),
+		UINT64_C(0xAB70FE17C79AC6CA), UINT64_C(0xFF77B1FCBEBCDC4F),
+		UINT64_C(0xBE5691EF416BD60C), UINT64_C(0x8DD01FAD907FFC3C),
+		UINT64_C(0xD3515C2831559A83), UINT64_C(0x9D71AC8FADA6C9B5),
+		UINT64_C(0xEA9C227723EE8BCB), UINT64_C(0xAECC49914078536D),
+		UINT64_C(0x823C12795DB6CE57), UINT64_C(0xC21094364DFB5637),
+		UINT64_C(0x9096EA6F3848984F), UINT64_C(0xD77485CB25823AC7),
+		UINT64_C(0xA086CFCD97BF97F4), UINT64_C(0xEF340A98172AACE5),
+		UINT64_C(0xB23867FB2A35B28E), UINT64_C(0x84C8D4DFD2C63F3B),
+		UINT64_C(0xC5DD44271AD3CDBA), UINT64_C(0x936B9FCEBB25C996),
+		UINT64_C(0xDBAC6C247D62A584), UINT64_C(0xA3AB66580D5FDAF6),
+		UINT64_C(0xF3E2F893DEC3F126), UINT64_C(0xB5B5ADA8AAFF80B8),
+		UINT64_C(0x87625F056C7C4A8B), UINT64_C(0xC9BCFF6034C13053),
+		UINT64_C(0x964E858C91BA2655), UINT64_C(0xDFF9772470297EBD),
+		UINT64_C(0xA6DFBD9FB8E5B88F), UINT64_C(0xF8A95FCF88747D94),
+		UINT64_C(0xB94470938FA89BCF), UINT64_C(0x8A08F0F8BF0F156B),
+		UINT64_C(0xCDB02555653131B6), UINT64_C(0x993FE2C6D07B7FAC),
+		UINT64_C(0xE45C10C42A2B3B06), UINT64_C(0xAA242499697392D3),
+		UINT64_C(0xFD87B5F28300CA0E), UINT64_C(0xBCE5086492111AEB),
+		UINT64_C(0x8CBCCC096F5088CC), UINT64_C(0xD1B71758E219652C),
+		UINT64_C(0x9C40000000000000), UINT64_C(0xE8D4A51000000000),
+		UINT64_C(0xAD78EBC5AC620000), UINT64_C(0x813F3978F8940984),
+		UINT64_C(0xC097CE7BC90715B3), UINT64_C(0x8F7E32CE7BEA5C70),
+		UINT64_C(0xD5D238A4ABE98068), UINT64_C(0x9F4F2726179A2245),
+		UINT64_C(0xED63A231D4C4FB27), UINT64_C(0xB0DE65388CC8ADA8),
+		UINT64_C(0x83C7088E1AAB65DB), UINT64_C(0xC45D1DF942711D9A),
+		UINT64_C(0x924D692CA61BE758), UINT64_C(0xDA01EE641A708DEA),
+		UINT64_C(0xA26DA3999AEF774A), UINT64_C(0xF209787BB47D6B85),
+		UINT64_C(0xB454E4A179DD1877), UINT64_C(0x865B86925B9BC5C2),
+		UINT64_C(0xC83553C5C8965D3D), UINT64_C(0x952AB45CFA97A0B3),
+		UINT64_C(0xDE469FBD99A05FE3), UINT64_C(0xA59BC234DB398C25),
+		UINT64_C(0xF6C69A72A3989F5C), UINT64_C(0xB7DCBF5354E9BECE),
+		UINT64_C(0x88FCF317F22241E2), UINT64_C(0xCC20CE9BD35C78A5),
+		UINT64_C(0x98165AF37B2153DF), UINT64_C(0xE2A0B5DC971F303A),
+		UINT64_C(0xA8D9D1535CE3B396), UINT64_C(0xFB9B7CD9A4A7443C),
+		UINT64_C(0xBB764C4CA7A44410), UINT64_C(0x8BAB8EEFB6409C1A),
+		UINT64_C(0xD01FEF10A657842C), UINT64_C(0x9B10A4E5E9913129),
+		UINT64_C(0xE7109BFBA19C0C9D), UINT64_C(0xAC2820D9623BF429),
+		UINT64_C(0x80444B5E7AA7CF85), UINT64_C(0xBF21E44003ACDD2D),
+		UINT64_C(0x8E679C2F5E44FF8F), UINT64_C(0xD433179D9C8CB841),
+		UINT64_C(0x9E19DB92B4E31BA9), UINT64_C(0xEB96BF6EBADF77D9),
+		UINT64_C(0xAF87023B9BF0EE6B)
+	};
+	static const short pow_e[] = {
+		-1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034,
+		-1007, -980, -954, -927, -901, -874, -847, -821,
+		-794, -768, -741, -715, -688, -661, -635, -608,
+		-582, -555, -529, -502, -475, -449, -422, -396,
+		-369, -343, -316, -289, -263, -236, -210, -183,
+		-157, -130, -103, -77, -50, -24, 3, 30,
+		56, 83, 109, 136, 162, 189, 216, 242,
+		269, 295, 322, 348, 375, 402, 428, 455,
+		481, 508, 534, 561, 588, 614, 641, 667,
+		694, 720, 747, 774, 800, 827, 853, 880,
+		907, 933, 960, 986, 1013, 1039, 1066
+	};
+	/* Smallest power of ten bringing the exponent to at least -60. */
+	const double dk = (-61 - e) * 0.30102999566398114 + 347;
+	int ik = (int)dk;
+	size_t i;
+	rs_diy_fp r;
+
+	if (dk - ik > 0)
+		ik++;
+
+	i = (size_t)(ik >> 3) + 1;
+	*k = 348 - (int)(i << 3);
+	r.f = pow_f[i];
+	r.e = pow_e[i];
+
+	return r;
+}
+
+RS_API void rs_grisu_round(char *buffer, int len, uint64_t delta,
+			   uint64_t rest, uint64_t ten_kappa, uint64_t wp_w)
+{
+	while (rest < wp_w && delta - rest >= ten_kappa &&
+	       (rest + ten_kappa < wp_w ||
+		wp_w - rest > rest + ten_kappa - wp_w)) {
+		buffer[len - 1]--;
+		rest += ten_kappa;
+	}
+}
+
+RS_API int rs_grisu_digits(rs_diy_fp w, rs_diy_fp mp, uint64_t delta,
+			   char *buffer, int *k)
+{
+	static const uint64_t pow10[] = {
+		UINT64_C(1),
+		UINT64_C(10),
+		UINT64_C(100),
+		UINT64_C(1000),
+		UINT64_C(10000),
+		UINT64_C(100000),
+		UINT64_C(1000000),
+		UINT64_C(10000000),
+		UINT64_C(100000000),
+		UINT64_C(1000000000),
+		UINT64_C(10000000000),
+		UINT64_C(100000000000),
+		UINT64_C(1000000000000),
+		UINT64_C(10000000000000),
+		UINT64_C(100000000000000),
+		UINT64_C(1000000000000000),
+		UINT64_C(10000000000000000),
+		UINT64_C(100000000000000000),
+		UINT64_C(1000000000000000000),
+		UINT64_C(10000000000000000000)
+	};
+	const int shift = -mp.e;
+	const uint64_t one = (uint64_t)1 << shift;
+	const uint64_t wp_w = mp.f - w.f;
+	uint64_t p1 = mp.f >> shift;
+	uint64_t p2 = mp.f & (one - 1);
+	int kappa = (int)rs_u64_len(p1);
+	int len = 0;
+
+	/* Digits of the integral part. */
+	while (kappa > 0) {
+		const uint64_t d = p1 / pow10[kappa - 1];
+		uint64_t rest;
+
+		p1 %= pow10[kappa - 1];
+
+		if (d != 0 || len != 0)
+			buffer[len++] = (char)('0' + d);
+
+		kappa--;
+		rest = (p1 << shift) + p2;
+
+		if (rest <= delta) {
+			*k += kappa;
+			rs_grisu_round(buffer, len, delta, rest,
+				       pow10[kappa] << shift, wp_w);
+			return len;
+		}
+	}
+
+	/* Digits of the fractional part. */
+	for (;;) {
+		uint64_t d;
+
+		p2 *= 10;
+		delta *= 10;
+		d = p2 >> shift;
+
+		if (d != 0 || len != 0)
+			buffer[len++] = (char)('0' + d);
+
+		p2 &= one - 1;
+		kappa--;
+
+		if (p2 < delta) {
+			*k += kappa;
+			rs_grisu_round(buffer, len, delta, p2, one,
+				       -kappa < 20 ? wp_w * pow10[-kappa] : 0);
+			return len;
+		}
+	}
+}
+
+/* Whether a character is a decimal digit, independently of the locale. */
+#define RS_IS_DIGIT(c) ((unsigned char)((c) - '0') < 10)
+
+RS_API size_t rs_to_u64(const rapidstring *s, uint64_t *out)
+{
+	return rs_to_u64_n(rs_data_c(s), rs_len(s), out);
+}
+
+RS_API size_t rs_to_u64_n(const char *input, size_t n, uint64_t *out)
+{
+	size_t i = 0;
+	size_t len;
+	uint64_t v = 0;
+
+	assert(input != NULL || n == 0);
+	assert(out != NULL);
+
+	/* Leading zeros do not count towards the maximal number of digits. */
+	while (i < n && input[i] == '0')
+		i++;
+
+	len = rs_parse_digits(input + i, n - i, &v, 19);
+
+	if (RS_UNLIKELY(i + len == 0))
+		return 0;
+
+	i += len;
+
+	if (RS_UNLIKELY(i < n && RS_IS_DIGIT(input[i]))) {
+		const unsigned int d = (unsigned int)(input[i] - '0');
+
+		if (v > (UINT64_MAX - d) / 10 ||
+		    (i + 1 < n && RS_IS_DIGIT(input[i + 1])))
+			return 0;
+
+		v = v * 10 + d;
+		i++;
+	}
+
+	*out = v;
+
+	return i;
+}
+
+RS_API size_t rs_to_u64_v(rs_view input, uint64_t *out)
+{
+	return rs_to_u64_n(input.data, input.size, out);
+}
+
+RS_API size_t rs_to_i64(const rapidstring *s, int64_t *out)
+{
+	return rs_to_i64_n(rs_data_c(s), rs_len(s), out);
+}
+
+RS_API size_t rs_to_i64_n(const char *input, size_t n, int64_t *out)
+{
+	const size_t sign = n > 0 && (input[0] == '-' || input[0] == '+');
+	const uint64_t max = (uint64_t)INT64_MAX;
+	uint64_t v;
+	size_t len;
+
+	assert(out != NULL);
+
+	len = rs_to_u64_n(input + sign, n - sign, &v);
+
+	if (RS_UNLIKELY(len == 0))
+		return 0;
+
+	if (sign && input[0] == '-') {
+		if (RS_UNLIKELY(v > max + 1))
+			return 0;
+
+		/* Negated in two steps to handle the smallest value. */
+		*out = v == 0 ? 0 : -(int64_t)(v - 1) - 1;
+	} else {
+		if (RS_UNLIKELY(v > max))
+			return 0;
+
+		*out = (int64_t)v;
+	}
+
+	return sign + len;
+}
+
+RS_API size_t rs_to_i64_v(rs_view input, int64_t *out)
+{
+	return rs_to_i64_n(input.data, input.size, out);
+}
+
+RS_API size_t rs_to_double(const rapidstring *s, double *out)
+{
+	return rs_to_double_n(rs_data_c(s), rs_len(s), out);
+}
+
+RS_API size_t rs_to_double_n(const char *input, size_t n, double *out)
+{
+	/* Every power of ten which is exactly representable. */
+	static const double pow10[] = {
+		1e0,  1e1,  1e2,  1e3,	1e4,  1e5,  1e6,  1e7,
+		1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+		1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+	size_t i = 0;
+	size_t start;
+	size_t len;
+	size_t digits;
+	uint64_t m = 0;
+	long e = 0;
+	unsigned char neg = 0;
+	double v;
+
+	assert(input != NULL || n == 0);
+	assert(out != NULL);
+
+	if (i < n && (input[i] == '-' || input[i] == '+')) {
+		neg = input[i] == '-';
+		i++;
+	}
+
+	if (RS_UNLIKELY(n - i >= 3 && !RS_IS_DIGIT(input[i]))) {
+		uint64_t bits = 0;
+
+		if (memcmp(input + i, "inf", 3) == 0)
+			bits = UINT64_C(0x7FF0000000000000);
+		else if (memcmp(input + i, "nan", 3) == 0)
+			bits = UINT64_C(0x7FF8000000000000);
+
+		if (bits != 0) {
+			memcpy(&v, &bits, sizeof(v));
+			*out = neg ? -v : v;
+			return i + 3;
+		}
+	}
+
+	start = i;
+
+	while (i < n && input[i] == '0')
+		i++;
+
+	/* Digits past the nineteenth only raise the exponent. */
+	len = rs_parse_digits(input + i, n - i, &m, 19);
+	i += len;
+	digits = len;
+
+	while (i < n && RS_IS_DIGIT(input[i])) {
+		i++;
+		digits++;
+		e++;
+	}
+
+	if (i < n && input[i] == '.') {
+		const size_t frac = ++i;
+
+		if (digits == 0) {
+			while (i < n && input[i] == '0')
+				i++;
+		}
+
+		len = rs_parse_digits(input + i, n - i, &m,
+				      digits < 19 ? 19 - digits : 0);
+		i += len;
+		digits += len;
+		e -= (long)(i - frac);
+
+		while (i < n && RS_IS_DIGIT(input[i])) {
+			i++;
+			digits++;
+		}
+
+		/* A lone point is not a number. */
+		if (RS_UNLIKELY(i == frac && frac - 1 == start))
+			return 0;
+	} else if (RS_UNLIKELY(i == start)) {
+		return 0;
+	}
+
+	if (i < n && (input[i] == 'e' || input[i] == 'E')) {
+		size_t j = i + 1;
+		const unsigned char neg_e = j < n && input[j] == '-';
+		long x = 0;
+
+		if (j < n && (input[j] == '-' || input[j] == '+'))
+			j++;
+
+		/* The exponent is only consumed if it has digits. */
+		if (j < n && RS_IS_DIGIT(input[j])) {
+			for (; j < n && RS_IS_DIGIT(input[j]); j++) {
+				if (x < 100000)
+					x = x * 10 + (input[j] - '0');
+			}
+
+			e += neg_e ? -x : x;
+			i = j;
+		}
+	}
+
+	/*
+	 * Both the significand and the power of ten are exact, so a single
+	 * multiplication or division rounds correctly.
+	 */
+	if (m == 0) {
+		v = 0;
+	} else if (RS_LIKELY(digits <= 19 && m <= UINT64_C(1) << 53 &&
+			     e >= -22 && e <= 22)) {
+		v = e < 0 ? (double)m / pow10[-e] : (double)m * pow10[e];
+	} else {
+		*out = rs_to_double_slow(input, i);
+		return i;
+	}
+
+	*out = neg ? -v : v;
+
+	return i;
+}
+
+RS_API size_t rs_to_double_v(rs_view input, double *out)
+{
+	return rs_to_double_n(input.data, input.size, out);
+}
+
+RS_API unsigned char rs_is_eight_digits(uint64_t w)
+{
+	/* Digits are 0x30 to 0x39, the only ones below 0x40 after adding 6. */
+	return ((w & UINT64_C(0xF0F0F0F0F0F0F0F0)) |
+		(((w + UINT64_C(0x0606060606060606)) &
+		  UINT64_C(0xF0F0F0F0F0F0F0F0)) >>
+		 4)) == UINT64_C(0x3333333333333333);
+}
+
+RS_API uint64_t rs_parse_eight_digits(uint64_t w)
+{
+	const uint64_t mask = UINT64_C(0x000000FF000000FF);
+	const uint64_t mul1 = UINT64_C(0x000F424000000064);
+	const uint64_t mul2 = UINT64_C(0x0000271000000001);
+
+	/* Combines pairs of digits, then pairs of pairs, and so on. */
+	w -= UINT64_C(0x3030303030303030);
+	w = (w * 10) + (w >> 8);
+	w = (((w & mask) * mul1) + (((w >> 16) & mask) * mul2)) >> 32;
+
+	return w;
+}
+
+RS_API size_t rs_parse_digits(const char *input, size_t n, uint64_t *v,
+			      size_t max)
+{
+	uint64_t acc = *v;
+	size_t i = 0;
+
+	if (n > max)
+		n = max;
+
+#ifndef RS_BIG_ENDIAN
+	while (i + 8 <= n) {
+		const uint64_t w = rs_read64(input + i);
+
+		if (!rs_is_eight_digits(w))
+			break;
+
+		acc = acc * 100000000 + rs_parse_eight_digits(w);
+		i += 8;
+	}
+#endif
+
+	for (; i < n && RS_IS_DIGIT(input[i]); i++)
+		acc = acc * 10 + (uint64_t)(input[i] - '0');
+
+	*v = acc;
+
+	return i;
+}
+
+RS_API double rs_to_double_slow(const char *input, size_t n)
+{
+	const char *point = localeconv()->decimal_point;
+	const char *dot = (const char *)memchr(input, '.', n);
+	rapidstring tmp;
+	double v;
+
+	/*
+	 * The copy is null terminated, and its decimal point is replaced by
+	 * the one of the current locale which strtod() expects. The latter may
+	 * be several characters long.
+	 */
+	if (dot == NULL || strcmp(point, ".") == 0) {
+		rs_init_w_n(&tmp, input, n);
+	} else {
+		const size_t before = (size_t)(dot - input);
+
+		rs_init_w_n(&tmp, input, before);
+		rs_cat(&tmp, point);
+		rs_cat_n(&tmp, dot + 1, n - before - 1);
+	}
+
+	v = strtod(rs_data_c(&tmp), NULL);
+	rs_free(&tmp);
+
+	return v;
+}
+
+/*
+ * ===============================================================
+ *
+ *                              SPLIT
+ *
+ * ===============================================================
+ */
+
+RS_API void rs_split_init(rs_split_iter *it, const rapidstring *s,
+			  const char *sep)
+{
+	assert(sep != NULL);
+
+	rs_split_init_n(it, s, sep, strlen(sep));
+}
+
+RS_API void rs_split_init_n(rs_split_iter *it, const rapidstring *s,
+			    const char *sep, size_t n)
+{
+	assert(sep != NULL);
+	assert(n > 0);
+
+	/* A single character is searched for without comparing needles. */
+	if (n == 1) {
+		rs_split_init_char(it, s, *sep);
+	} else {
+		rs_split_init_mode(it, s, RS_SPLIT_STR);
+		it->sep = sep;
+		it->sep_len = n;
+	}
+}
+
+RS_API void rs_split_init_char(rs_split_iter *it, const rapidstring *s,
+			       char c)
+{
+	rs_split_init_mode(it, s, RS_SPLIT_CHAR);
+	it->c = c;
+	it->sep_len = 1;
+}
+
+RS_API void rs_split_init_any(rs_split_iter *it, const rapidstring *s,
+			      const char *set)
+{
+	assert(set != NULL);
+
+	rs_split_init_any_n(it, s, set, strlen(set));
+}
+
+RS_API void rs_split_init_any_n(rs_split_iter *it, const rapidstring *s,
+				const char *set, size_t n)
+{
+	assert(set != NULL || n == 0);
+
+	rs_split_init_mode(it, s, RS_SPLIT_ANY);
+	it->sep = set;
+	it->sep_len = n;
+}
+
+RS_API void rs_split_limit(rs_split_iter *it, size_t n)
+{
+	assert(it != NULL);
+
+	it->limit = n;
+}
+
+RS_API void rs_split_skip_empty(rs_split_iter *it)
+{
+	assert(it != NULL);
+
+	it->skip_empty = 1;
+}
+
+RS_API unsigned char rs_split_next(rs_split_iter *it, rs_view *field)
+{
+	assert(it != NULL);
+	assert(field != NULL);
+
+	while (!it->done) {
+		size_t i;
+
+		if (RS_UNLIKELY(it->limit == 1))
+			i = RS_NPOS;
+		else if (it->mode == RS_SPLIT_CHAR)
+			i = rs_memchr(it->data, it->size, it->c);
+		else if (it->mode == RS_SPLIT_ANY)
+			i = rs_memchr_any(it->data, it->size, it->sep,
+					  it->sep_len);
+		else
+			i = rs_memmem(it->data, it->size, it->sep, it->sep_len);
+
+		field->data = it->data;
+
+		if (i == RS_NPOS) {
+			field->size = it->size;
+			it->done = 1;
+		} else {
+			/* Only one character of a set separates two fields. */
+			const size_t sep_len =
+				it->mode == RS_SPLIT_ANY ? 1 : it->sep_len;
+
+			field->size = i;
+			it->data += i + sep_len;
+			it->size -= i + sep_len;
+		}
+
+		if (RS_LIKELY(field->size != 0 || !it->skip_empty)) {
+			if (it->limit != 0)
+				it->limit--;
+
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+RS_API void rs_split_init_mode(rs_split_iter *it, const rapidstring *s,
+			       unsigned char mode)
+{
+	assert(it != NULL);
+
+	it->data = rs_data_c(s);
+	it->size = rs_len(s);
+	it->sep = NULL;
+	it->sep_len = 0;
+	it->limit = 0;
+	it->c = '\0';
+	it->mode = mode;
+	it->skip_empty = 0;
+	it->done = 0;
+}
+
+RS_API size_t rs_memchr_any(const char *buffer, size_t len, const char *set,
+			    size_t n)
+{
+	size_t i = 0;
+
+	if (RS_UNLIKELY(n == 0))
+		return RS_NPOS;
+
+	if (n == 1)
+		return rs_memchr(buffer, len, *set);
+
+#ifdef RS_SIMD
+	if (RS_LIKELY(len >= RS_VEC_SIZE)) {
+		unsigned int mask;
+
+		for (; i + RS_VEC_SIZE <= len; i += RS_VEC_SIZE) {
+			RS_VEC_IN_SET(RS_VEC_LOAD(buffer + i), set, n, mask);
+
+			if (mask != 0)
+				return i + rs_ctz(mask);
+		}
+
+		if (i == len)
+			return RS_NPOS;
+
+		/* Fall through to the scalar loop for the last characters. */
+	}
+#endif
+
+	for (; i < len; i++)
+		if (memchr(set, buffer[i], n) != NULL)
+			return i;
+
+	return RS_NPOS;
+}
+
+/*
+ * ===============================================================
+ *
+ *                              CASE
+ *
+ * ===============================================================
+ */
+
+/* Converts an uppercase ASCII letter to lowercase. */
+#define RS_LOWER(c)                                                 \
+	((int)((unsigned char)(c) |                                 \
+	       (((unsigned int)((unsigned char)(c) - 'A') < 26) << 5)))
+
+#define RS_WORD_ONES UINT64_C(0x0101010101010101)
+
+RS_API void rs_to_lower(rapidstring *s)
+{
+	rs_thaw(s);
+
+#ifdef RS_SIMD
+	/* The remaining capacity is never a letter. */
+	if (RS_STACK_VEC && RS_STACK_LIKELY(rs_is_stack(s))) {
+		rs_memcase((char *)s, sizeof(rapidstring), 'A', 'Z');
+		return;
+	}
+#endif
+
+	rs_memcase(rs_data(s), rs_len(s), 'A', 'Z');
+}
+
+RS_API void rs_to_upper(rapidstring *s)
+{
+	rs_thaw(s);
+
+#ifdef RS_SIMD
+	if (RS_STACK_VEC && RS_STACK_LIKELY(rs_is_stack(s))) {
+		rs_memcase((char *)s, sizeof(rapidstring), 'a', 'z');
+		return;
+	}
+#endif
+
+	rs_memcase(rs_data(s), rs_len(s), 'a', 'z');
+}
+
+RS_API int rs_cmp_icase(const rapidstring *s, const char *input)
+{
+	assert(input != NULL);
+
+	return rs_cmp_icase_n(s, input, strlen(input));
+}
+
+RS_API int rs_cmp_icase_n(const rapidstring *s, const char *input, size_t n)
+{
+	const size_t len = rs_len(s);
+	int cmp;
+
+	assert(input != NULL);
+
+	cmp = rs_memcmp_icase(rs_data_c(s), input, len < n ? len : n);
+
+	if (cmp != 0)
+		return cmp;
+
+	return (len > n) - (len < n);
+}
+
+RS_API int rs_cmp_icase_rs(const rapidstring *s, const rapidstring *input)
+{
+	return rs_cmp_icase_n(s, rs_data_c(input), rs_len(input));
+}
+
+RS_API int rs_cmp_icase_v(const rapidstring *s, rs_view input)
+{
+	return rs_cmp_icase_n(s, input.data, input.size);
+}
+
+RS_API unsigned char rs_eq_icase(const rapidstring *s, const char *input)
+{
+	assert(input != NULL);
+
+	return rs_eq_icase_n(s, input, strlen(input));
+}
+
+RS_API unsigned char rs_eq_icase_n(const rapidstring *s, const char *input,
+				   size_t n)
+{
+	assert(input != NULL);
+
+	return rs_len(s) == n && rs_memcmp_icase(rs_data_c(s), input, n) == 0;
+}
+
+RS_API unsigned char rs_eq_icase_rs(const rapidstring *s,
+				    const rapidstring *input)
+{
+#ifdef RS_SIMD
+	if (RS_STACK_VEC && RS_STACK_LIKELY(RS_BOTH_STACK(s, input))) {
+		const char *a = (const char *)s;
+		const char *b = (const char *)input;
+		unsigned int mask = 0;
+		size_t i;
+
+		/* Equal remaining capacities imply equal lengths. */
+		if (s->stack.left != input->stack.left)
+			return 0;
+
+		for (i = 0; i < sizeof(rapidstring); i += RS_VEC_SIZE) {
+			const rs_vec x = RS_VEC_LOAD(a + i);
+			const rs_vec y = RS_VEC_LOAD(b + i);
+
+			mask |= RS_VEC_MASK(RS_VEC_EQ(RS_VEC_CASE(x, 'A', 'Z'),
+						      RS_VEC_CASE(y, 'A', 'Z')))
+				<< i;
+		}
+
+		return (~mask & RS_LOW_MASK(rs_stack_len(s))) == 0;
+	}
+#endif
+
+	return rs_eq_icase_n(s, rs_data_c(input), rs_len(input));
+}
+
+RS_API unsigned char rs_eq_icase_v(const rapidstring *s, rs_view input)
+{
+	return rs_eq_icase_n(s, input.data, input.size);
+}
+
+RS_API uint64_t rs_hash_icase(const rapidstring *s)
+{
+#ifdef RS_SIMD
+	if (RS_STACK_VEC && RS_STACK_LIKELY(rs_is_stack(s)))
+		return rs_hash_stack(s, 0, 1);
+#endif
+
+	return rs_hash_fold_n(rs_data_c(s), rs_len(s), 0, 1);
+}
+
+RS_API uint64_t rs_hash_icase_n(const char *input, size_t n)
+{
+	return rs_hash_fold_n(input, n, 0, 1);
+}
+
+RS_API void rs_memcase(char *buffer, size_t n, char first, char last)
+{
+	size_t i = 0;
+
+#ifdef RS_SIMD
+	if (RS_LIKELY(n >= RS_VEC_SIZE)) {
+		for (; i + RS_VEC_SIZE <= n; i += RS_VEC_SIZE) {
+			const rs_vec v = RS_VEC_LOAD(buffer + i);
+
+			RS_VEC_STORE(buffer + i, RS_VEC_CASE(v, first, last));
+		}
+
+		if (i != n) {
+			/*
+			 * Overlap the last vector with the previous one, the
+			 * converted characters are out of the range and are
+			 * not toggled twice.
+			 */
+			const rs_vec v = RS_VEC_LOAD(buffer + n - RS_VEC_SIZE);
+
+			RS_VEC_STORE(buffer + n - RS_VEC_SIZE,
+				     RS_VEC_CASE(v, first, last));
+		}
+
+		return;
+	}
+#endif
+
+	for (; i < n; i++)
+		if (buffer[i] >= first && buffer[i] <= last)
+			buffer[i] ^= 0x20;
+}
+
+RS_API int rs_memcmp_icase(const char *a, const char *b, size_t n)
+{
+	size_t i = 0;
+
+#ifdef RS_SIMD
+	for (; i + RS_VEC_SIZE <= n; i += RS_VEC_SIZE) {
+		const rs_vec x = RS_VEC_CASE(RS_VEC_LOAD(a + i), 'A', 'Z');
+		const rs_vec y = RS_VEC_CASE(RS_VEC_LOAD(b + i), 'A', 'Z');
+		const unsigned int mask = RS_VEC_MASK(RS_VEC_EQ(x, y)) ^
+					  RS_VEC_FULL;
+
+		if (mask != 0) {
+			i += rs_ctz(mask);
+
+			return RS_LOWER(a[i]) - RS_LOWER(b[i]);
+		}
+	}
+#else
+	for (; i + 8 <= n; i += 8)
+		if (rs_fold64(rs_read64(a + i)) != rs_fold64(rs_read64(b + i)))
+			break;
+#endif
+
+	for (; i < n; i++)
+		if (RS_LOWER(a[i]) != RS_LOWER(b[i]))
+			return RS_LOWER(a[i]) - RS_LOWER(b[i]);
+
+	return 0;
+}
+
+RS_API uint64_t rs_fold64(uint64_t w)
+{
+	const uint64_t high = RS_WORD_ONES * 0x80;
+	const uint64_t low = w & ~high;
+
+	/* The high bit of each byte is set from 'A' and from past 'Z'. */
+	const uint64_t from_a = low + RS_WORD_ONES * (0x80 - 'A');
+	const uint64_t past_z = low + RS_WORD_ONES * (0x80 - 'Z' - 1);
+	const uint64_t upper = (from_a ^ past_z) & ~w & high;
+
+	return w | (upper >> 2);
+}
+
+/*
+ * ===============================================================
+ *
+ *                              UTF-8
+ *
+ * ===============================================================
+ */
+
+#define RS_WORD_HIGH (RS_WORD_ONES * 0x80)
+
+/* Checks whether a character is a continuation of a sequence. */
+#define RS_UTF8_CONT(c) (((c)&0xC0) == 0x80)
+
+#ifdef RS_SIMD
+/*
+ * Accumulates the errors of the vector of characters at p, whose previous
+ * three characters must be readable. The characters are offset by 0x80 so
+ * that the signed comparisons order them as unsigned.
+ */
+#define RS_UTF8_ERROR(p, err)                                                \
+	do {                                                                 \
+		const rs_vec rs_o_ = RS_VEC_SET1(-128);                      \
+		const rs_vec rs_u_ = RS_VEC_XOR(RS_VEC_LOAD(p), rs_o_);      \
+		const rs_vec rs_u1_ =                                        \
+			RS_VEC_XOR(RS_VEC_LOAD((p)-1), rs_o_);               \
+		const rs_vec rs_u2_ =                                        \
+			RS_VEC_XOR(RS_VEC_LOAD((p)-2), rs_o_);               \
+		const rs_vec rs_u3_ =                                        \
+			RS_VEC_XOR(RS_VEC_LOAD((p)-3), rs_o_);               \
+		/* Continuations are 0x80 to 0xBF. */                        \
+		const rs_vec rs_cont_ =                                      \
+			RS_VEC_AND(RS_VEC_GT(rs_u_, RS_VEC_SET1(-1)),        \
+				   RS_VEC_GT(RS_VEC_SET1(0x40), rs_u_));     \
+		/* They follow 0xC0, 0xE0 and 0xF0 leads by 1, 2 and 3. */   \
+		const rs_vec rs_need_ = RS_VEC_OR(                           \
+			RS_VEC_OR(RS_VEC_GT(rs_u1_, RS_VEC_SET1(0x3F)),      \
+				  RS_VEC_GT(rs_u2_, RS_VEC_SET1(0x5F))),     \
+			RS_VEC_GT(rs_u3_, RS_VEC_SET1(0x6F)));               \
+		err = RS_VEC_OR(err, RS_VEC_XOR(rs_cont_, rs_need_));        \
+		/* Leads of 0xC0, 0xC1 and from 0xF5 are never valid. */     \
+		err = RS_VEC_OR(err, RS_VEC_GT(rs_u_, RS_VEC_SET1(0x74)));   \
+		err = RS_VEC_OR(                                             \
+			err,                                                 \
+			RS_VEC_AND(RS_VEC_GT(rs_u_, RS_VEC_SET1(0x3F)),      \
+				   RS_VEC_GT(RS_VEC_SET1(0x42), rs_u_)));    \
+		/* Overlong after 0xE0 and 0xF0, surrogates after 0xED. */   \
+		err = RS_VEC_OR(                                             \
+			err,                                                 \
+			RS_VEC_AND(RS_VEC_EQ(rs_u1_, RS_VEC_SET1(0x60)),     \
+				   RS_VEC_GT(RS_VEC_SET1(0x20), rs_u_)));    \
+		err = RS_VEC_OR(                                             \
+			err,                                                 \
+			RS_VEC_AND(RS_VEC_EQ(rs_u1_, RS_VEC_SET1(0x6D)),     \
+				   RS_VEC_GT(rs_u_, RS_VEC_SET1(0x1F))));    \
+		err = RS_VEC_OR(                                             \
+			err,                                                 \
+			RS_VEC_AND(RS_VEC_EQ(rs_u1_, RS_VEC_SET1(0x70)),     \
+				   RS_VEC_GT(RS_VEC_SET1(0x10), rs_u_)));    \
+		/* Past U+10FFFF after 0xF4. */                              \
+		err = RS_VEC_OR(                                             \
+			err,                                                 \
+			RS_VEC_AND(RS_VEC_EQ(rs_u1_, RS_VEC_SET1(0x74)),     \
+				   RS_VEC_GT(rs_u_, RS_VEC_SET1(0x0F))));    \
+	} while (0)
+
+/* Checks whether a sequence is cut short before p. */
+#define RS_UTF8_CUT(p)                                      \
+	(((const unsigned char *)(p))[-1] >= 0xC0 ||        \
+	 ((const unsigned char *)(p))[-2] >= 0xE0 ||        \
+	 ((const unsigned char *)(p))[-3] >= 0xF0)
+#endif
+
+RS_API unsigned char rs_utf8_valid(const rapidstring *s)
+{
+	if (rs_is_stack(s))
+		return rs_utf8_valid_n(s->stack.buffer, rs_stack_len(s));
+
+	if (s->heap.mode & RS_HEAP_MODE_UTF8)
+		return 1;
+
+	return rs_utf8_valid_n(s->heap.buffer, rs_heap_len(s));
+}
+
+RS_API unsigned char rs_utf8_validate(rapidstring *s)
+{
+	const unsigned char valid = rs_utf8_valid(s);
+
+	if (valid && rs_is_heap(s))
+		s->heap.mode |= RS_HEAP_MODE_UTF8;
+
+	return valid;
+}
+
+RS_API void rs_utf8_forget(rapidstring *s)
+{
+	if (rs_is_heap(s))
+		s->heap.mode &= (unsigned char)~RS_HEAP_MODE_UTF8;
+}
+
+RS_API unsigned char rs_utf8_valid_n(const char *input, size_t n)
+{
+#ifdef RS_SIMD
+	/* The characters are padded by three before and zeros after. */
+	char pad[RS_VEC_SIZE + 3] = { 0 };
+	rs_vec err = RS_VEC_SET1(0);
+	size_t i = 0;
+
+	assert(input != NULL || n == 0);
+
+	if (n >= RS_VEC_SIZE) {
+		memcpy(pad + 3, input, RS_VEC_SIZE);
+		RS_UTF8_ERROR(pad + 3, err);
+
+		for (i = RS_VEC_SIZE; i + 2 * RS_VEC_SIZE <= n;
+		     i += 2 * RS_VEC_SIZE) {
+			const rs_vec a = RS_VEC_LOAD(input + i);
+			const rs_vec b = RS_VEC_LOAD(input + i + RS_VEC_SIZE);
+
+			if (RS_VEC_MASK(RS_VEC_OR(a, b)) == 0) {
+				if (RS_UTF8_CUT(input + i))
+					return 0;
+
+				continue;
+			}
+
+			RS_UTF8_ERROR(input + i, err);
+			RS_UTF8_ERROR(input + i + RS_VEC_SIZE, err);
+		}
+
+		for (; i + RS_VEC_SIZE <= n; i += RS_VEC_SIZE)
+			RS_UTF8_ERROR(input + i, err);
+
+		memcpy(pad, input + i - 3, 3);
+	}
+
+	/* The zeros after the last characters catch a cut sequence. */
+	if (n != 0)
+		memcpy(pad + 3, input + i, n - i);
+	memset(pad + 3 + n - i, 0, RS_VEC_SIZE - (n - i));
+	RS_UTF8_ERROR(pad + 3, err);
+
+	return RS_VEC_MASK(err) == 0;
+#else
+	const unsigned char *p = (const unsigned char *)input;
+	const unsigned char *end = p + n;
+
+	assert(input != NULL || n == 0);
+
+	while (p != end) {
+		const size_t left = (size_t)(end - p);
+
+		if (*p < 0x80) {
+			/* Skip words of ASCII characters. */
+			if (left >= 8 &&
+			    !(rs_read64((const char *)p) & RS_WORD_HIGH))
+				p += 8;
+			else
+				p++;
+		} else if (*p < 0xC2) {
+			return 0;
+		} else if (*p < 0xE0) {
+			if (left < 2 || !RS_UTF8_CONT(p[1]))
+				return 0;
+
+			p += 2;
+		} else if (*p < 0xF0) {
+			if (left < 3 || !RS_UTF8_CONT(p[1]) ||
+			    !RS_UTF8_CONT(p[2]) ||
+			    (*p == 0xE0 && p[1] < 0xA0) ||
+			    (*p == 0xED && p[1] > 0x9F))
+				return 0;
+
+			p += 3;
+		} else if (*p < 0xF5) {
+			if (left < 4 || !RS_UTF8_CONT(p[1]) ||
+			    !RS_UTF8_CONT(p[2]) || !RS_UTF8_CONT(p[3]) ||
+			    (*p == 0xF0 && p[1] < 0x90) ||
+			    (*p == 0xF4 && p[1] > 0x8F))
+				return 0;
+
+			p += 4;
+		} else {
+			return 0;
+		}
+	}
+
+	return 1;
+#endif
+}
+
+RS_API unsigned char rs_utf8_valid_v(rs_view input)
+{
+	return rs_utf8_valid_n(input.data, input.size);
+}
+
+RS_API size_t rs_utf8_len(const rapidstring *s)
+{
+#ifdef RS_SIMD
+	if (RS_STACK_VEC && RS_STACK_LIKELY(rs_is_stack(s))) {
+		const char *p = (const char *)s;
+		const size_t len = rs_stack_len(s);
+		unsigned int mask = 0;
+		size_t i;
+
+		for (i = 0; i < sizeof(rapidstring); i += RS_VEC_SIZE) {
+			const rs_vec v = RS_VEC_LOAD(p + i);
+
+			mask |= RS_VEC_MASK(RS_VEC_GT(RS_VEC_SET1(-64), v))
+				<< i;
+		}
+
+		return len - rs_popcount(mask & RS_LOW_MASK(len));
+	}
+#endif
+
+	return rs_utf8_len_n(rs_data_c(s), rs_len(s));
+}
+
+RS_API size_t rs_utf8_len_n(const char *input, size_t n)
+{
+	size_t count = n;
+	size_t i = 0;
+
+	assert(input != NULL || n == 0);
+
+#ifdef RS_SIMD
+	while (i + RS_VEC_SIZE <= n) {
+		unsigned char sums[RS_VEC_SIZE];
+		rs_vec acc = RS_VEC_SET1(0);
+		size_t j;
+
+		/* Count the continuations of each lane before they overflow. */
+		for (j = 0; j < 255 && i + RS_VEC_SIZE <= n;
+		     j++, i += RS_VEC_SIZE) {
+			const rs_vec v = RS_VEC_LOAD(input + i);
+
+			acc = RS_VEC_ADD(
+				acc, RS_VEC_AND(RS_VEC_GT(RS_VEC_SET1(-64), v),
+						RS_VEC_SET1(1)));
+		}
+
+		RS_VEC_STORE((char *)sums, acc);
+
+		for (j = 0; j < RS_VEC_SIZE; j++)
+			count -= sums[j];
+	}
+#else
+	for (; i + 8 <= n; i += 8) {
+		const uint64_t w = rs_read64(input + i);
+		const uint64_t cont = w & ~(w << 1) & RS_WORD_HIGH;
+
+		/* Sums the continuation bits of every byte in the top one. */
+		count -= (size_t)(((cont >> 7) * RS_WORD_ONES) >> 56);
+	}
+#endif
+
+	for (; i < n; i++)
+		count -= RS_UTF8_CONT((unsigned char)input[i]);
+
+	return count;
+}
+
+RS_API unsigned char rs_is_ascii(const rapidstring *s)
+{
+#ifdef RS_SIMD
+	if (RS_STACK_VEC && RS_STACK_LIKELY(rs_is_stack(s))) {
+		const char *p = (const char *)s;
+		unsigned int mask = 0;
+		size_t i;
+
+		for (i = 0; i < sizeof(rapidstring); i += RS_VEC_SIZE)
+			mask |= RS_VEC_MASK(RS_VEC_LOAD(p + i)) << i;
+
+		return (mask & RS_LOW_MASK(rs_stack_len(s))) == 0;
+	}
+#endif
+
+	return rs_is_ascii_n(rs_data_c(s), rs_len(s));
+}
+
+RS_API unsigned char rs_is_ascii_n(const char *input, size_t n)
+{
+	uint64_t high = 0;
+	size_t i = 0;
+
+	assert(input != NULL || n == 0);
+
+#ifdef RS_SIMD
+	for (; i + 2 * RS_VEC_SIZE <= n; i += 2 * RS_VEC_SIZE)
+		if (RS_VEC_MASK(RS_VEC_OR(RS_VEC_LOAD(input + i),
+					  RS_VEC_LOAD(input + i +
+						      RS_VEC_SIZE))) != 0)
+			return 0;
+#endif
+
+	for (; i + 8 <= n; i += 8)
+		high |= rs_read64(input + i);
+
+	for (; i < n; i++)
+		high |= (unsigned char)input[i];
+
+	return !(high & RS_WORD_HIGH);
+}
+
+/*
+ * ===============================================================
+ *
+ *                            ENCODING
+ *
+ * ===============================================================
+ */
+
+/* Length of the base64 encoding of n characters. */
+#define RS_BASE64_LEN(n) (((n) + 2) / 3 * 4)
+
+#ifdef RS_SIMD
+/* Converts a vector of values below 16 to lowercase hexadecimal digits. */
+#define RS_VEC_HEX(v)                                                     \
+	RS_VEC_ADD(RS_VEC_ADD(v, RS_VEC_SET1('0')),                       \
+		   RS_VEC_AND(RS_VEC_GT(v, RS_VEC_SET1(9)),               \
+			      RS_VEC_SET1('a' - '0' - 10)))
+
+/*
+ * Converts a vector of hexadecimal digits to their values, clearing the
+ * lanes of valid that are not digits.
+ */
+#define RS_VEC_UNHEX(c, v, valid)                                           \
+	do {                                                                \
+		const rs_vec rs_l_ = RS_VEC_OR(c, RS_VEC_SET1(0x20));       \
+		const rs_vec rs_d_ =                                        \
+			RS_VEC_AND(RS_VEC_GT(c, RS_VEC_SET1('0' - 1)),      \
+				   RS_VEC_GT(RS_VEC_SET1('9' + 1), c));     \
+		const rs_vec rs_a_ =                                        \
+			RS_VEC_AND(RS_VEC_GT(rs_l_, RS_VEC_SET1('a' - 1)),  \
+				   RS_VEC_GT(RS_VEC_SET1('f' + 1), rs_l_)); \
+		valid = RS_VEC_AND(valid, RS_VEC_OR(rs_d_, rs_a_));         \
+		v = RS_VEC_OR(                                              \
+			RS_VEC_AND(rs_d_, RS_VEC_ADD(c, RS_VEC_SET1(-'0'))), \
+			RS_VEC_AND(rs_a_, RS_VEC_ADD(rs_l_,                 \
+						     RS_VEC_SET1(10 - 'a')))); \
+	} while (0)
+#endif
+
+#ifdef RS_VEC_SHUFFLE
+/* Characters of base64 each lane of a vector encodes or decodes to. */
+#define RS_BASE64_LANE (12)
+
+/*
+ * Encodes the first 12 characters of each lane of v as 16 base64 digits. The
+ * 6 bit values are moved into their bytes with multiplications, then offset
+ * by the alphabet range they fall into.
+ */
+#define RS_VEC_BASE64(v, out)                                                \
+	do {                                                                 \
+		const rs_vec rs_in_ = RS_VEC_SHUFFLE(                         \
+			v, RS_VEC_LANE16(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, \
+					 10, 9, 11, 10));                    \
+		const rs_vec rs_i_ = RS_VEC_OR(                              \
+			RS_VEC_MULHI16(RS_VEC_AND(rs_in_,                    \
+						  RS_VEC_SET32(0x0FC0FC00)), \
+				       RS_VEC_SET32(0x04000040)),            \
+			RS_VEC_MULLO16(RS_VEC_AND(rs_in_,                    \
+						  RS_VEC_SET32(0x003F03F0)), \
+				       RS_VEC_SET32(0x01000010)));           \
+		const rs_vec rs_r_ = RS_VEC_OR(                              \
+			RS_VEC_SUBS(rs_i_, RS_VEC_SET1(51)),                 \
+			RS_VEC_AND(RS_VEC_GT(RS_VEC_SET1(26), rs_i_),        \
+				   RS_VEC_SET1(13)));                        \
+		out = RS_VEC_ADD(                                            \
+			rs_i_,                                               \
+			RS_VEC_SHUFFLE(                                      \
+				RS_VEC_LANE16('a' - 26, '0' - 52, '0' - 52,  \
+					      '0' - 52, '0' - 52, '0' - 52,  \
+					      '0' - 52, '0' - 52, '0' - 52,  \
+					      '0' - 52, '0' - 52, '+' - 62,  \
+					      '/' - 63, 'A', 0, 0),          \
+				rs_r_));                                     \
+	} while (0)
+
+/*
+ * Decodes the 16 base64 digits of each lane of c into its first 12
+ * characters. The lanes of err that are not digits become non zero.
+ */
+#define RS_VEC_UNBASE64(c, out, err)                                         \
+	do {                                                                 \
+		const rs_vec rs_hi_ =                                        \
+			RS_VEC_AND(RS_VEC_SRL64(c, 4), RS_VEC_SET1(0x0F));   \
+		const rs_vec rs_v_ = RS_VEC_ADD(                             \
+			c, RS_VEC_SHUFFLE(                                   \
+				   RS_VEC_LANE16(0, 16, 19, 4, -65, -65, -71, \
+						 -71, 0, 0, 0, 0, 0, 0, 0,   \
+						 0),                         \
+				   RS_VEC_ADD(RS_VEC_EQ(c, RS_VEC_SET1('/')), \
+					      rs_hi_)));                     \
+		err = RS_VEC_OR(                                             \
+			err,                                                 \
+			RS_VEC_AND(                                          \
+				RS_VEC_SHUFFLE(                              \
+					RS_VEC_LANE16(0x15, 0x11, 0x11, 0x11, \
+						      0x11, 0x11, 0x11, 0x11, \
+						      0x11, 0x11, 0x13, 0x1A, \
+						      0x1B, 0x1B, 0x1B, 0x1A), \
+					RS_VEC_AND(c, RS_VEC_SET1(0x0F))),   \
+				RS_VEC_SHUFFLE(                              \
+					RS_VEC_LANE16(0x10, 0x10, 0x01, 0x02, \
+						      0x04, 0x08, 0x04, 0x08, \
+						      0x10, 0x10, 0x10, 0x10, \
+						      0x10, 0x10, 0x10, 0x10), \
+					rs_hi_)));                           \
+		out = RS_VEC_SHUFFLE(                                        \
+			RS_VEC_MADD16(RS_VEC_MADD8(rs_v_,                    \
+						   RS_VEC_SET32(0x01400140)), \
+				      RS_VEC_SET32(0x00011000)),             \
+			RS_VEC_LANE16(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, \
+				      -1, -1, -1, -1));                      \
+	} while (0)
+#endif
+
+RS_API void rs_cat_base64_n(rapidstring *s, const char *input, size_t n)
+{
+	const size_t len = rs_len(s);
+	const size_t out = RS_BASE64_LEN(n);
+
+	assert(input != NULL);
+
+	rs_base64_encode(rs_cat_reserve(s, out), input, n);
+	rs_resize(s, len + out);
+}
+
+RS_API void rs_cat_base64_v(rapidstring *s, rs_view input)
+{
+	rs_cat_base64_n(s, input.data, input.size);
+}
+
+RS_API unsigned char rs_decode_base64_n(rapidstring *s, const char *input,
+					size_t n)
+{
+	const size_t len = rs_len(s);
+	size_t out;
+
+	assert(input != NULL);
+
+	/* Padding only completes the last group of four characters. */
+	if (n % 4 == 0 && n != 0 && input[n - 1] == '=')
+		n -= input[n - 2] == '=' ? 2 : 1;
+
+	if (n % 4 == 1)
+		return 0;
+
+	out = n / 4 * 3 + (n % 4 != 0 ? n % 4 - 1 : 0);
+
+	if (!rs_base64_decode(rs_cat_reserve(s, out), input, n)) {
+		/* Restore the terminator overwritten by the output. */
+		rs_resize(s, len);
+
+		return 0;
+	}
+
+	rs_resize(s, len + out);
+
+	return 1;
+}
+
+RS_API unsigned char rs_decode_base64_v(rapidstring *s, rs_view input)
+{
+	return rs_decode_base64_n(s, input.data, input.size);
+}
+
+RS_API void rs_cat_hex_n(rapidstring *s, const char *input, size_t n)
+{
+	const size_t len = rs_len(s);
+
+	assert(input != NULL);
+
+	rs_hex_encode(rs_cat_reserve(s, n * 2), input, n);
+	rs_resize(s, len + n * 2);
+}
+
+RS_API void rs_cat_hex_v(rapidstring *s, rs_view input)
+{
+	rs_cat_hex_n(s, input.data, input.size);
+}
+
+RS_API unsigned char rs_decode_hex_n(rapidstring *s, const char *input,
+				     size_t n)
+{
+	const size_t len = rs_len(s);
+
+	assert(input != NULL);
+
+	if (n % 2 != 0)
+		return 0;
+
+	if (!rs_hex_decode(rs_cat_reserve(s, n / 2), input, n / 2)) {
+		/* Restore the terminator overwritten by the output. */
+		rs_resize(s, len);
+
+		return 0;
+	}
+
+	rs_resize(s, len + n / 2);
+
+	return 1;
+}
+
+RS_API unsigned char rs_decode_hex_v(rapidstring *s, rs_view input)
+{
+	return rs_decode_hex_n(s, input.data, input.size);
+}
+
+RS_API void rs_base64_encode(char *buffer, const char *input, size_t n)
+{
+	static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+				       "abcdefghijklmnopqrstuvwxyz"
+				       "0123456789+/";
+	const unsigned char *p = (const unsigned char *)input;
+	size_t i = 0;
+
+#ifdef RS_VEC_SHUFFLE
+	/* Each lane loads four characters past the ones it encodes. */
+	for (; i + RS_VEC_SIZE / 4 * 3 + 4 <= n;
+	     i += RS_VEC_SIZE / 4 * 3, buffer += RS_VEC_SIZE) {
+		const rs_vec v = RS_VEC_LOAD_LANES(input + i, RS_BASE64_LANE);
+		rs_vec out;
+
+		RS_VEC_BASE64(v, out);
+		RS_VEC_STORE(buffer, out);
+	}
+#endif
+
+	for (; i + 3 <= n; i += 3, buffer += 4) {
+		const unsigned long w = (unsigned long)p[i] << 16 |
+					(unsigned long)p[i + 1] << 8 | p[i + 2];
+
+		buffer[0] = alphabet[w >> 18];
+		buffer[1] = alphabet[(w >> 12) & 0x3F];
+		buffer[2] = alphabet[(w >> 6) & 0x3F];
+		buffer[3] = alphabet[w & 0x3F];
+	}
+
+	if (i != n) {
+		const unsigned long w =
+			(unsigned long)p[i] << 16 |
+			(i + 1 != n ? (unsigned long)p[i + 1] << 8 : 0);
+
+		buffer[0] = alphabet[w >> 18];
+		buffer[1] = alphabet[(w >> 12) & 0x3F];
+		buffer[2] = i + 1 != n ? alphabet[(w >> 6) & 0x3F] : '=';
+		buffer[3] = '=';
+	}
+}
+
+RS_API unsigned char rs_base64_decode(char *buffer, const char *input,
+				      size_t n)
+{
+	/* Values of the ASCII characters, 0xFF for those outside the set. */
+	static const unsigned char values[128] = {
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
+		0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B,
+		0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,
+		0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+		0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16,
+		0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20,
+		0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+		0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30,
+		0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+	};
+	const unsigned char *p = (const unsigned char *)input;
+	unsigned char err = 0;
+	unsigned long w = 0;
+	size_t i = 0;
+
+#ifdef RS_VEC_SHUFFLE
+	rs_vec verr = RS_VEC_SET1(0);
+
+	/* Each lane stores four characters past the ones it decodes. */
+	for (; i + RS_VEC_SIZE + 8 <= n;
+	     i += RS_VEC_SIZE, buffer += RS_VEC_SIZE / 4 * 3) {
+		rs_vec out;
+
+		RS_VEC_UNBASE64(RS_VEC_LOAD(input + i), out, verr);
+		RS_VEC_STORE_LANES(buffer, RS_BASE64_LANE, out);
+	}
+
+	if (RS_VEC_MASK(RS_VEC_EQ(verr, RS_VEC_SET1(0))) != RS_VEC_FULL)
+		return 0;
+#endif
+
+	/* Characters outside of ASCII set the high bit of the error. */
+#define RS_BASE64_VALUE(c) (values[(c)&0x7F] | ((c)&0x80))
+
+	for (; i + 4 <= n; i += 4, buffer += 3) {
+		const unsigned char a = RS_BASE64_VALUE(p[i]);
+		const unsigned char b = RS_BASE64_VALUE(p[i + 1]);
+		const unsigned char c = RS_BASE64_VALUE(p[i + 2]);
+		const unsigned char d = RS_BASE64_VALUE(p[i + 3]);
+
+		err |= a | b | c | d;
+		w = (unsigned long)a << 18 | (unsigned long)b << 12 |
+		    (unsigned long)c << 6 | d;
+
+		buffer[0] = (char)(w >> 16);
+		buffer[1] = (char)(w >> 8);
+		buffer[2] = (char)w;
+	}
+
+	if (i != n) {
+		const unsigned char a = RS_BASE64_VALUE(p[i]);
+		const unsigned char b = RS_BASE64_VALUE(p[i + 1]);
+		const unsigned char c =
+			i + 2 != n ? RS_BASE64_VALUE(p[i + 2]) : 0;
+
+		err |= a | b | c;
+		w = (unsigned long)a << 18 | (unsigned long)b << 12 |
+		    (unsigned long)c << 6;
+
+		buffer[0] = (char)(w >> 16);
+
+		if (i + 2 != n)
+			buffer[1] = (char)(w >> 8);
+	}
+
+#undef RS_BASE64_VALUE
+
+	return !(err & 0x80);
+}
+
+RS_API void rs_hex_encode(char *buffer, const char *input, size_t n)
+{
+	static const char digits[] = "0123456789abcdef";
+	size_t i = 0;
+
+#ifdef RS_SIMD
+	for (; i + RS_VEC_SIZE <= n; i += RS_VEC_SIZE) {
+		const rs_vec v = RS_VEC_LOAD(input + i);
+		const rs_vec high = RS_VEC_HEX(
+			RS_VEC_AND(RS_VEC_SRL64(v, 4), RS_VEC_SET1(0x0F)));
+		const rs_vec low = RS_VEC_HEX(RS_VEC_AND(v, RS_VEC_SET1(0x0F)));
+
+		RS_VEC_STORE(buffer + i * 2, RS_VEC_ZIPLO(high, low));
+		RS_VEC_STORE(buffer + i * 2 + RS_VEC_SIZE,
+			     RS_VEC_ZIPHI(high, low));
+	}
+#endif
+
+	for (; i < n; i++) {
+		const unsigned char c = (unsigned char)input[i];
+
+		buffer[i * 2] = digits[c >> 4];
+		buffer[i * 2 + 1] = digits[c & 0x0F];
+	}
+}
+
+RS_API unsigned char rs_hex_decode(char *buffer, const char *input, size_t n)
+{
+	size_t i = 0;
+
+#ifdef RS_SIMD
+	for (; i + RS_VEC_SIZE <= n; i += RS_VEC_SIZE) {
+		const rs_vec a = RS_VEC_LOAD(input + i * 2);
+		const rs_vec b = RS_VEC_LOAD(input + i * 2 + RS_VEC_SIZE);
+		rs_vec valid = RS_VEC_SET1(-1);
+		rs_vec x;
+		rs_vec y;
+
+		RS_VEC_UNHEX(a, x, valid);
+		RS_VEC_UNHEX(b, y, valid);
+
+		if (RS_VEC_MASK(valid) != RS_VEC_FULL)
+			return 0;
+
+		/* Each even digit is shifted over the odd digit after it. */
+		x = RS_VEC_OR(RS_VEC_SLL64(x, 4), RS_VEC_SRL64(x, 8));
+		y = RS_VEC_OR(RS_VEC_SLL64(y, 4), RS_VEC_SRL64(y, 8));
+
+		RS_VEC_STORE(buffer + i, RS_VEC_PACK16(x, y));
+	}
+#endif
+
+	for (; i < n; i++) {
+		const int high = rs_hex_value(input[i * 2]);
+		const int low = rs_hex_value(input[i * 2 + 1]);
+
+		if ((high | low) < 0)
+			return 0;
+
+		buffer[i] = (char)(high << 4 | low);
+	}
+
+	return 1;
+}
+
+RS_API int rs_hex_value(char c)
+{
+	const int lower = (unsigned char)c | 0x20;
+
+	if (c >= '0' && c <= '9')
+		return c - '0';
+
+	return lower >= 'a' && lower <= 'f' ? lower - 'a' + 10 : -1;
+}
+
+/*
+ * ===============================================================
+ *
+ *                              TRIM
+ *
+ * ===============================================================
+ */
+
+RS_API void rs_trim(rapidstring *s, const char *set)
+{
+	assert(set != NULL);
+
+	rs_trim_n(s, set, strlen(set));
+}
+
+RS_API void rs_trim_n(rapidstring *s, const char *set, size_t n)
+{
+	rs_rtrim_n(s, set, n);
+	rs_ltrim_n(s, set, n);
+}
+
+RS_API void rs_ltrim(rapidstring *s, const char *set)
+{
+	assert(set != NULL);
+
+	rs_ltrim_n(s, set, strlen(set));
+}
+
+RS_API void rs_ltrim_n(rapidstring *s, const char *set, size_t n)
+{
+	size_t span;
+
+	assert(set != NULL);
+
+	span = rs_memspan(rs_data_c(s), rs_len(s), set, n);
+
+	if (span == 0)
+		return;
+
+	rs_thaw(s);
+
+	if (RS_HEAP_LIKELY(rs_is_heap(s)))
+		rs_heap_skip(s, span);
+	else
+		rs_stack_erase(s, 0, span);
+}
+
+RS_API void rs_rtrim(rapidstring *s, const char *set)
+{
+	assert(set != NULL);
+
+	rs_rtrim_n(s, set, strlen(set));
+}
+
+RS_API void rs_rtrim_n(rapidstring *s, const char *set, size_t n)
+{
+	const size_t len = rs_len(s);
+	size_t span;
+
+	assert(set != NULL);
+
+	span = rs_memrspan(rs_data_c(s), len, set, n);
+
+	if (span == 0)
+		return;
+
+	rs_thaw(s);
+
+	if (RS_HEAP_LIKELY(rs_is_heap(s)))
+		rs_heap_resize(s, len - span);
+	else
+		rs_stack_resize(s, len - span);
+}
+
+RS_API rs_view rs_view_trim_n(rs_view v, const char *set, size_t n)
+{
+	size_t span;
+
+	assert(set != NULL);
+
+	span = rs_memrspan(v.data, v.size, set, n);
+	v.size -= span;
+
+	span = rs_memspan(v.data, v.size, set, n);
+	v.data += span;
+	v.size -= span;
+
+	return v;
+}
+
+RS_API size_t rs_memspan(const char *buffer, size_t len, const char *set,
+			 size_t n)
+{
+	size_t i = 0;
+
+	if (RS_UNLIKELY(n == 0))
+		return 0;
+
+#ifdef RS_SIMD
+	for (; i + RS_VEC_SIZE <= len; i += RS_VEC_SIZE) {
+		unsigned int mask;
+
+		RS_VEC_IN_SET(RS_VEC_LOAD(buffer + i), set, n, mask);
+		mask ^= RS_VEC_FULL;
+
+		if (mask != 0)
+			return i + rs_ctz(mask);
+	}
+#endif
+
+	for (; i < len; i++)
+		if (memchr(set, buffer[i], n) == NULL)
+			return i;
+
+	return len;
+}
+
+RS_API size_t rs_memrspan(const char *buffer, size_t len, const char *set,
+			  size_t n)
+{
+	size_t i = len;
+
+	if (RS_UNLIKELY(n == 0))
+		return 0;
+
+#ifdef RS_SIMD
+	for (; i >= RS_VEC_SIZE; i -= RS_VEC_SIZE) {
+		unsigned int mask;
+
+		RS_VEC_IN_SET(RS_VEC_LOAD(buffer + i - RS_VEC_SIZE), set, n,
+			      mask);
+		mask ^= RS_VEC_FULL;
+
+		if (mask != 0)
+			return len - (i - RS_VEC_SIZE + rs_bsr(mask) + 1);
+	}
+#endif
+
+	for (; i > 0; i--)
+		if (memchr(set, buffer[i - 1], n) == NULL)
+			return len - i;
+
+	return len;
+}
+
+/*
+ * ===============================================================
+ *
+ *                           GAP BUFFER
+ *
+ * ===============================================================
+ */
+
+#define RS_GAP_SIZE(g) ((g)->capacity - (g)->before - (g)->after)
+#define RS_GAP_AFTER(g) ((g)->buffer + (g)->capacity - (g)->after)
+
+RS_API void rs_gap_init(rs_gap *g)
+{
+	assert(g != NULL);
+
+	g->buffer = NULL;
+	g->before = 0;
+	g->after = 0;
+	g->capacity = 0;
+}
+
+RS_API void rs_gap_init_w(rs_gap *g, const char *input)
 {
 	assert(input != NULL);
 
-	rs_init_w_n(s, input, strlen(input));
+	rs_gap_init_w_n(g, input, strlen(input));
 }
 
-RS_API void rs_init_w_n(rapidstring *s, const char *input, size_t n)
+RS_API void rs_gap_init_w_n(rs_gap *g, const char *input, size_t n)
 {
-	rs_init(s);
-	rs_cpy_n(s, input, n);
+	rs_gap_init(g);
+	rs_gap_insert_n(g, input, n);
 }
 
-RS_API void rs_init_w_cap(rapidstring *s, size_t n)
+RS_API void rs_gap_init_w_rs(rs_gap *g, const rapidstring *input)
 {
-	if (RS_HEAP_LIKELY(n > RS_STACK_CAPACITY)) {
-		rs_heap_init(s, n);
-		rs_heap_resize(s, 0);
-	} else {
-		rs_init(s);
+	rs_gap_init_w_n(g, rs_data_c(input), rs_len(input));
+}
+
+RS_API void rs_gap_free(rs_gap *g)
+{
+	assert(g != NULL);
+
+	RS_FREE(g->buffer);
+}
+
+RS_API size_t rs_gap_len(const rs_gap *g)
+{
+	assert(g != NULL);
+
+	return g->before + g->after;
+}
+
+RS_API size_t rs_gap_cursor(const rs_gap *g)
+{
+	assert(g != NULL);
+
+	return g->before;
+}
+
+RS_API char rs_gap_at(const rs_gap *g, size_t i)
+{
+	assert(i < rs_gap_len(g));
+
+	if (i < g->before)
+		return g->buffer[i];
+
+	return g->buffer[i + RS_GAP_SIZE(g)];
+}
+
+RS_API void rs_gap_move(rs_gap *g, size_t index)
+{
+	assert(index <= rs_gap_len(g));
+
+	/* The characters passed over are moved to the other side of the gap. */
+	if (index < g->before) {
+		const size_t n = g->before - index;
+
+		memmove(RS_GAP_AFTER(g) - n, g->buffer + index, n);
+		g->after += n;
+	} else if (index > g->before) {
+		const size_t n = index - g->before;
+
+		memmove(g->buffer + g->before, RS_GAP_AFTER(g), n);
+		g->after -= n;
 	}
+
+	g->before = index;
 }
 
-RS_API void rs_init_w_rs(rapidstring *s, const rapidstring *input)
+RS_API void rs_gap_insert(rs_gap *g, const char *input)
 {
-	RS_DATA_SIZE(rs_init_w_n, s, input);
+	assert(input != NULL);
+
+	rs_gap_insert_n(g, input, strlen(input));
 }
 
-RS_API void rs_free(rapidstring *s)
+RS_API void rs_gap_insert_n(rs_gap *g, const char *input, size_t n)
 {
-	RS_ASSERT_RS(s);
+	assert(input != NULL);
 
-	if (RS_HEAP_LIKELY(rs_is_heap(s)))
-		RS_FREE(s->heap.buffer);
+	if (RS_UNLIKELY(n == 0))
+		return;
+
+	if (RS_UNLIKELY(RS_GAP_SIZE(g) < n))
+		rs_gap_grow(g, n);
+
+	memcpy(g->buffer + g->before, input, n);
+	g->before += n;
+}
+
+RS_API void rs_gap_erase_before(rs_gap *g, size_t n)
+{
+	assert(n <= g->before);
+
+	g->before -= n;
+}
+
+RS_API void rs_gap_erase_after(rs_gap *g, size_t n)
+{
+	assert(n <= g->after);
+
+	g->after -= n;
+}
+
+RS_API void rs_gap_materialize(const rs_gap *g, rapidstring *s)
+{
+	const size_t len = rs_gap_len(g);
+	char *p = rs_cpy_reserve(s, len);
+
+	if (RS_LIKELY(len != 0)) {
+		memcpy(p, g->buffer, g->before);
+		memcpy(p + g->before, RS_GAP_AFTER(g), g->after);
+	}
+
+	rs_resize(s, len);
+}
+
+RS_API void rs_gap_grow(rs_gap *g, size_t n)
+{
+	const size_t capacity = (rs_gap_len(g) + n) * RS_GROWTH_FACTOR;
+	const size_t after = g->after;
+
+	g->buffer = (char *)RS_REALLOC(g->buffer, capacity);
+
+	/* The characters after the gap are moved to the end of the buffer. */
+	memmove(g->buffer + capacity - after,
+		g->buffer + g->capacity - after, after);
+	g->capacity = capacity;
 }
 
 /*
  * ===============================================================
  *
- *                             COPYING
+ *                              TABLE
  *
  * ===============================================================
  */
 
-RS_API void rs_stack_cpy_n(rapidstring *s, const char *input, size_t n)
+/* Number of strings of a table when first used. */
+#define RS_TABLE_MIN (16)
+
+#define RS_TABLE_OFFSET(t, i)                               \
+	((t)->large ? (size_t)((const int64_t *)(t)->offsets)[i] : \
+		      (size_t)((const int32_t *)(t)->offsets)[i])
+
+RS_API void rs_table_init(rs_table *t)
+{
+	assert(t != NULL);
+
+	t->offsets = NULL;
+	t->data = NULL;
+	t->size = 0;
+	t->capacity = 0;
+	t->data_capacity = 0;
+	t->large = 0;
+}
+
+RS_API void rs_table_init_large(rs_table *t)
+{
+	rs_table_init(t);
+	t->large = 1;
+}
+
+RS_API void rs_table_free(rs_table *t)
+{
+	assert(t != NULL);
+
+	RS_FREE(t->offsets);
+	RS_FREE(t->data);
+}
+
+RS_API void rs_table_reserve(rs_table *t, size_t n, size_t bytes)
+{
+	assert(t != NULL);
+
+	if (n > t->capacity) {
+		const size_t width = t->large ? sizeof(int64_t) :
+						sizeof(int32_t);
+		const unsigned char empty = t->capacity == 0;
+
+		t->offsets = RS_REALLOC(t->offsets, (n + 1) * width);
+		t->capacity = n;
+
+		if (empty) {
+			if (t->large)
+				((int64_t *)t->offsets)[0] = 0;
+			else
+				((int32_t *)t->offsets)[0] = 0;
+		}
+	}
+
+	if (bytes > t->data_capacity) {
+		t->data = (char *)RS_REALLOC(t->data, bytes);
+		t->data_capacity = bytes;
+	}
+}
+
+RS_API void rs_table_clear(rs_table *t)
+{
+	assert(t != NULL);
+
+	t->size = 0;
+}
+
+RS_API size_t rs_table_size(const rs_table *t)
+{
+	assert(t != NULL);
+
+	return t->size;
+}
+
+RS_API size_t rs_table_bytes(const rs_table *t)
+{
+	assert(t != NULL);
+
+	return t->capacity != 0 ? RS_TABLE_OFFSET(t, t->size) : 0;
+}
+
+RS_API void rs_table_push(rs_table *t, const char *input)
 {
-	assert(rs_is_stack(s));
 	assert(input != NULL);
-	assert(RS_STACK_CAPACITY >= n);
 
-	memcpy(s->stack.buffer, input, n);
-	rs_stack_resize(s, n);
+	rs_table_push_n(t, input, strlen(input));
 }
 
-RS_API void rs_heap_cpy_n(rapidstring *s, const char *input, size_t n)
+RS_API void rs_table_push_n(rs_table *t, const char *input, size_t n)
 {
-	assert(rs_is_heap(s));
+	const size_t bytes = rs_table_bytes(t);
+	const size_t end = bytes + n;
+
 	assert(input != NULL);
-	assert(s->heap.capacity >= n);
 
-	memcpy(s->heap.buffer, input, n);
-	rs_heap_resize(s, n);
+	if (RS_UNLIKELY(t->size == t->capacity))
+		rs_table_reserve(t,
+				 t->capacity != 0 ?
+					 t->capacity * RS_GROWTH_FACTOR :
+					 RS_TABLE_MIN,
+				 0);
+
+	/* Empty strings allocate too, so the characters are never `NULL`. */
+	if (RS_UNLIKELY(end > t->data_capacity || t->data == NULL))
+		rs_table_reserve(t, 0, (end + RS_TABLE_MIN) * RS_GROWTH_FACTOR);
+
+	if (RS_UNLIKELY(!t->large && end > RS_TABLE_SMALL_MAX))
+		rs_table_widen(t);
+
+	memcpy(t->data + bytes, input, n);
+
+	if (t->large)
+		((int64_t *)t->offsets)[++t->size] = (int64_t)end;
+	else
+		((int32_t *)t->offsets)[++t->size] = (int32_t)end;
+}
+
+RS_API void rs_table_push_rs(rs_table *t, const rapidstring *input)
+{
+	RS_DATA_SIZE(rs_table_push_n, t, input);
+}
+
+RS_API void rs_table_push_v(rs_table *t, rs_view input)
+{
+	rs_table_push_n(t, input.data, input.size);
+}
+
+RS_API rs_view rs_table_at(const rs_table *t, size_t i)
+{
+	size_t begin;
+
+	assert(i < rs_table_size(t));
+
+	begin = RS_TABLE_OFFSET(t, i);
+
+	return rs_view_n(t->data + begin, RS_TABLE_OFFSET(t, i + 1) - begin);
+}
+
+RS_API const void *rs_table_offsets(const rs_table *t)
+{
+	/* Arrow expects a single zero offset for an empty array. */
+	static const int64_t zero = 0;
+
+	assert(t != NULL);
+
+	return t->capacity != 0 ? t->offsets : (const void *)&zero;
+}
+
+RS_API const char *rs_table_data(const rs_table *t)
+{
+	assert(t != NULL);
+
+	return t->data != NULL ? t->data : "";
+}
+
+RS_API unsigned char rs_table_is_large(const rs_table *t)
+{
+	assert(t != NULL);
+
+	return t->large;
+}
+
+RS_API void rs_table_widen(rs_table *t)
+{
+	assert(!t->large);
+
+	if (t->capacity != 0) {
+		const int32_t *small = (const int32_t *)t->offsets;
+		int64_t *large = (int64_t *)RS_MALLOC((t->capacity + 1) *
+						      sizeof(int64_t));
+		size_t i;
+
+		for (i = 0; i <= t->size; i++)
+			large[i] = small[i];
+
+		RS_FREE(t->offsets);
+		t->offsets = large;
+	}
+
+	t->large = 1;
+}
+
+/*
+ * ===============================================================
+ *
+ *                              SORT
+ *
+ * ===============================================================
+ */
+
+/* Number of entries under which an insertion sort is used. */
+#define RS_SORT_INSERTION (16)
+
+/* Number of entries from which the pivot is the median of three medians. */
+#define RS_SORT_NINTHER (128)
+
+#define RS_SORT_SWAP(a, b)                     \
+	do {                                   \
+		const rs_sort_entry rs_t_ = a; \
+		a = b;                         \
+		b = rs_t_;                     \
+	} while (0)
+
+RS_API void rs_sort(rapidstring *strings, size_t n)
+{
+	rs_sort_entry *e;
+
+	assert(strings != NULL || n == 0);
+
+	if (n < 2)
+		return;
+
+	e = (rs_sort_entry *)RS_MALLOC(n * sizeof(rs_sort_entry));
+
+	rs_sort_fill(strings, e, 0, n);
+	rs_sort_entries(e, n, 0);
+	rs_sort_permute(strings, e, n);
+
+	RS_FREE(e);
+}
+
+RS_API uint64_t rs_bswap64(uint64_t w)
+{
+#if RS_GCC_VERSION > 40300
+	return __builtin_bswap64(w);
+#elif defined(_MSC_VER)
+	return _byteswap_uint64(w);
+#else
+	const uint64_t bytes = UINT64_C(0x00FF00FF00FF00FF);
+	const uint64_t words = UINT64_C(0x0000FFFF0000FFFF);
+
+	w = ((w & bytes) << 8) | ((w >> 8) & bytes);
+	w = ((w & words) << 16) | ((w >> 16) & words);
+
+	return (w << 32) | (w >> 32);
+#endif
+}
+
+RS_API uint64_t rs_sort_key(const char *input, size_t n)
+{
+	uint64_t w;
+
+	if (RS_LIKELY(n >= 8)) {
+		w = rs_read64(input);
+	} else {
+		char buffer[8] = { 0 };
+
+		memcpy(buffer, input, n);
+		w = rs_read64(buffer);
+	}
+
+#ifdef RS_BIG_ENDIAN
+	return w;
+#else
+	return rs_bswap64(w);
+#endif
 }
 
-RS_API void rs_cpy(rapidstring *s, const char *input)
+RS_API uint64_t rs_sort_stack_key(const rapidstring *s)
 {
-	assert(input != NULL);
+	const size_t len = rs_stack_len(s);
 
-	rs_cpy_n(s, input, strlen(input));
+	/* The union is always large enough to be read past the string. */
+#ifdef RS_BIG_ENDIAN
+	const uint64_t w = rs_read64(s->stack.buffer);
+#else
+	const uint64_t w = rs_bswap64(rs_read64(s->stack.buffer));
+#endif
+
+	return len >= 8 ? w : w & ~(~(uint64_t)0 >> (len * 8));
 }
 
-RS_API void rs_cpy_n(rapidstring *s, const char *input, size_t n)
+RS_API void rs_sort_fill(const rapidstring *strings, rs_sort_entry *e,
+			 size_t begin, size_t end)
 {
-	if (RS_HEAP_LIKELY(rs_is_heap(s))) {
-		rs_grow_heap(s, n);
-		rs_heap_cpy_n(s, input, n);
-	} else if (RS_HEAP_LIKELY(n > RS_STACK_CAPACITY)) {
-		rs_heap_init_g(s, n);
-		rs_heap_cpy_n(s, input, n);
-	} else {
-		rs_stack_cpy_n(s, input, n);
+	size_t i;
+
+	for (i = begin; i < end; i++) {
+		const rapidstring *s = strings + i;
+
+		if (RS_HEAP_LIKELY(rs_is_heap(s))) {
+			e[i].data = s->heap.buffer;
+			e[i].len = rs_heap_len(s);
+			e[i].key = rs_sort_key(e[i].data, e[i].len);
+		} else {
+			e[i].data = s->stack.buffer;
+			e[i].len = rs_stack_len(s);
+			e[i].key = rs_sort_stack_key(s);
+		}
+
+		e[i].index = i;
 	}
 }
 
-RS_API void rs_cpy_rs(rapidstring *s, const rapidstring *input)
+RS_API void rs_sort_entries(rs_sort_entry *e, size_t n, size_t depth)
 {
-	RS_DATA_SIZE(rs_cpy_n, s, input);
+	rs_sort_intro(e, n, depth, rs_sort_budget(n));
 }
 
-/*
- * ===============================================================
- *
- *                            CAPACITY
- *
- * ===============================================================
- */
-
-RS_API unsigned char rs_empty(const rapidstring *s)
+RS_API void rs_sort_intro(rs_sort_entry *e, size_t n, size_t depth,
+			  size_t budget)
 {
-	return rs_len(s) == 0;
+	size_t i;
+
+	while (n > RS_SORT_INSERTION) {
+		size_t lt;
+		size_t gt;
+		size_t eq;
+		size_t done;
+
+		if (RS_UNLIKELY(budget == 0)) {
+			rs_sort_heap(e, n, depth);
+			return;
+		}
+
+		budget--;
+		rs_sort_partition(e, n, &lt, &gt);
+		eq = gt - lt;
+
+		/* Only parts of at most half the entries are recursed on. */
+		if (lt >= eq && lt >= n - gt) {
+			rs_sort_intro(e + gt, n - gt, depth, budget);
+			done = rs_sort_deepen(e + lt, eq, depth);
+			rs_sort_entries(e + lt + done, eq - done, depth + 8);
+			n = lt;
+		} else if (n - gt >= eq) {
+			rs_sort_intro(e, lt, depth, budget);
+			done = rs_sort_deepen(e + lt, eq, depth);
+			rs_sort_entries(e + lt + done, eq - done, depth + 8);
+			e += gt;
+			n -= gt;
+		} else {
+			rs_sort_intro(e, lt, depth, budget);
+			rs_sort_intro(e + gt, n - gt, depth, budget);
+
+			e += lt;
+			n = eq;
+			done = rs_sort_deepen(e, n, depth);
+			e += done;
+			n -= done;
+			depth += 8;
+			budget = rs_sort_budget(n);
+		}
+	}
+
+	for (i = 1; i < n; i++) {
+		const rs_sort_entry t = e[i];
+		size_t j = i;
+
+		for (; j > 0 && rs_sort_less(&t, e + j - 1, depth); j--)
+			e[j] = e[j - 1];
+
+		e[j] = t;
+	}
 }
 
-RS_API size_t rs_stack_len(const rapidstring *s)
+RS_API size_t rs_sort_budget(size_t n)
 {
-	assert(rs_is_stack(s));
+	size_t budget = 0;
+
+	for (; n > 1; n >>= 1)
+		budget += 2;
 
-	return RS_STACK_CAPACITY - s->stack.left;
+	return budget;
 }
 
-RS_API size_t rs_heap_len(const rapidstring *s)
+RS_API void rs_sort_heap(rs_sort_entry *e, size_t n, size_t depth)
 {
-	assert(rs_is_heap(s));
+	size_t i;
 
-	return s->heap.size;
+	for (i = n / 2; i > 0; i--)
+		rs_sort_sift(e, i - 1, n, depth);
+
+	for (i = n; i > 1; i--) {
+		RS_SORT_SWAP(e[0], e[i - 1]);
+		rs_sort_sift(e, 0, i - 1, depth);
+	}
 }
 
-RS_API size_t rs_len(const rapidstring *s)
+RS_API void rs_sort_sift(rs_sort_entry *e, size_t i, size_t n, size_t depth)
 {
-	return rs_is_heap(s) ? rs_heap_len(s) : rs_stack_len(s);
+	const rs_sort_entry t = e[i];
+	size_t child;
+
+	while ((child = 2 * i + 1) < n) {
+		if (child + 1 < n &&
+		    rs_sort_less(e + child, e + child + 1, depth))
+			child++;
+
+		if (!rs_sort_less(&t, e + child, depth))
+			break;
+
+		e[i] = e[child];
+		i = child;
+	}
+
+	e[i] = t;
 }
 
-RS_API size_t rs_cap(const rapidstring *s)
+RS_API uint64_t rs_sort_median(uint64_t a, uint64_t b, uint64_t c)
 {
-	return rs_is_heap(s) ? s->heap.capacity : RS_STACK_CAPACITY;
+	return a < b ? (b < c ? b : (a < c ? c : a)) :
+		       (a < c ? a : (b < c ? c : b));
 }
 
-RS_API void rs_reserve(rapidstring *s, size_t n)
+RS_API void rs_sort_partition(rs_sort_entry *e, size_t n, size_t *lt,
+			      size_t *gt)
 {
-	if (RS_HEAP_LIKELY(rs_is_heap(s))) {
-		if (RS_LIKELY(s->heap.capacity < n))
-			rs_realloc(s, n);
+	const size_t m = n / 2;
+	uint64_t pivot;
+	size_t l = 0;
+	size_t g = n;
+	size_t i = 0;
+
+	assert(n > 0);
+
+	if (n >= RS_SORT_NINTHER) {
+		/* Spreading the samples resists inputs built against them. */
+		const size_t k = n / 8;
+
+		pivot = rs_sort_median(
+			rs_sort_median(e[0].key, e[k].key, e[2 * k].key),
+			rs_sort_median(e[m - k].key, e[m].key, e[m + k].key),
+			rs_sort_median(e[n - 1 - 2 * k].key, e[n - 1 - k].key,
+				       e[n - 1].key));
 	} else {
-		rs_stack_to_heap(s, n);
+		pivot = rs_sort_median(e[0].key, e[m].key, e[n - 1].key);
+	}
+
+	while (i < g) {
+		if (e[i].key < pivot) {
+			RS_SORT_SWAP(e[l], e[i]);
+			l++;
+			i++;
+		} else if (e[i].key > pivot) {
+			g--;
+			RS_SORT_SWAP(e[i], e[g]);
+		} else {
+			i++;
+		}
 	}
+
+	*lt = l;
+	*gt = g;
 }
 
-RS_API void rs_shrink_to_fit(rapidstring *s)
+RS_API size_t rs_sort_deepen(rs_sort_entry *e, size_t n, size_t depth)
 {
-	if (RS_LIKELY(rs_is_heap(s)))
-		rs_realloc(s, rs_heap_len(s));
+	size_t done = 0;
+	size_t i;
+
+	/*
+	 * Strings ending within the equal keys come first, ordered by length,
+	 * which can only take eight values.
+	 */
+	for (i = 0; i < n; i++) {
+		if (e[i].len <= depth + 8) {
+			RS_SORT_SWAP(e[done], e[i]);
+			done++;
+		}
+	}
+
+	for (i = 1; i < done; i++) {
+		const rs_sort_entry t = e[i];
+		size_t j = i;
+
+		for (; j > 0 && e[j - 1].len > t.len; j--)
+			e[j] = e[j - 1];
+
+		e[j] = t;
+	}
+
+	for (i = done; i < n; i++)
+		e[i].key = rs_sort_key(e[i].data + depth + 8,
+				       e[i].len - depth - 8);
+
+	return done;
 }
 
-RS_API unsigned char rs_is_heap(const rapidstring *s)
+RS_API unsigned char rs_sort_less(const rs_sort_entry *a,
+				  const rs_sort_entry *b, size_t depth)
 {
-	RS_ASSERT_RS(s);
+	size_t n;
+	int cmp;
 
-	return s->heap.flag == RS_HEAP_FLAG;
+	if (a->key != b->key)
+		return a->key < b->key;
+
+	/* A string ending within the key is a prefix of the other string. */
+	if (a->len <= depth + 8 || b->len <= depth + 8)
+		return a->len < b->len;
+
+	n = (a->len < b->len ? a->len : b->len) - depth - 8;
+	cmp = rs_memcmp(a->data + depth + 8, b->data + depth + 8, n);
+
+	return cmp != 0 ? cmp < 0 : a->len < b->len;
 }
 
-RS_API unsigned char rs_is_stack(const rapidstring *s)
+RS_API void rs_sort_permute(rapidstring *strings, const rs_sort_entry *e,
+			    size_t n)
 {
-	return !rs_is_heap(s);
+	rapidstring *sorted =
+		(rapidstring *)RS_MALLOC(n * sizeof(rapidstring));
+	size_t i;
+
+	/* Gathering lets the random reads proceed in parallel. */
+	for (i = 0; i < n; i++)
+		sorted[i] = strings[e[i].index];
+
+	memcpy(strings, sorted, n * sizeof(rapidstring));
+	RS_FREE(sorted);
 }
 
 /*
  * ===============================================================
  *
- *                            MODIFIERS
+ *                          PARALLEL SORT
  *
  * ===============================================================
  */
 
-RS_API char *rs_data(rapidstring *s)
-{
-	RS_ASSERT_RS(s);
+#ifdef RS_PARALLEL
+
+#ifdef _WIN32
+#define RS_MUTEX_INIT(m) InitializeCriticalSection(m)
+#define RS_MUTEX_FREE(m) DeleteCriticalSection(m)
+#define RS_MUTEX_LOCK(m) EnterCriticalSection(m)
+#define RS_MUTEX_UNLOCK(m) LeaveCriticalSection(m)
+#define RS_THREAD_CREATE(t, f, arg) \
+	((*(t) = CreateThread(NULL, 0, f, arg, 0, NULL)) != NULL)
+#define RS_THREAD_JOIN(t) \
+	(WaitForSingleObject(t, INFINITE), CloseHandle(t))
+#define RS_THREAD_YIELD() SwitchToThread()
+#define RS_THREAD_RETURN (0)
+#else
+#define RS_MUTEX_INIT(m) pthread_mutex_init(m, NULL)
+#define RS_MUTEX_FREE(m) pthread_mutex_destroy(m)
+#define RS_MUTEX_LOCK(m) pthread_mutex_lock(m)
+#define RS_MUTEX_UNLOCK(m) pthread_mutex_unlock(m)
+#define RS_THREAD_CREATE(t, f, arg) (pthread_create(t, NULL, f, arg) == 0)
+#define RS_THREAD_JOIN(t) pthread_join(t, NULL)
+#define RS_THREAD_YIELD() sched_yield()
+#define RS_THREAD_RETURN (NULL)
+#endif
 
-	return rs_is_heap(s) ? s->heap.buffer : s->stack.buffer;
-}
+/* Steps of a parallel sort, each run by every thread on its own range. */
+#define RS_PARALLEL_FILL (0)
+#define RS_PARALLEL_COUNT (1)
+#define RS_PARALLEL_SCATTER (2)
+#define RS_PARALLEL_SORT (3)
+#define RS_PARALLEL_GATHER (4)
+#define RS_PARALLEL_COPY (5)
 
-RS_API const char *rs_data_c(const rapidstring *s)
-{
-	return rs_data((rapidstring *)s);
-}
+/* Number of sampled keys per bucket. */
+#define RS_PARALLEL_OVERSAMPLE (16)
 
-RS_API void rs_stack_cat_n(rapidstring *s, const char *input, size_t n)
+/* Size of an element of the entries, which also hold the gathered strings. */
+#define RS_PARALLEL_SLOT                               \
+	(sizeof(rs_sort_entry) > sizeof(rapidstring) ? \
+		 sizeof(rs_sort_entry) :               \
+		 sizeof(rapidstring))
+
+/* Initial capacity of a task deque. */
+#define RS_PARALLEL_MIN_TASKS (64)
+
+RS_API void rs_parallel_sort(rapidstring *strings, size_t n,
+			     unsigned int threads)
 {
-	const size_t stack_len = rs_stack_len(s);
+	rs_parallel p;
+	rs_parallel_worker *workers;
+	size_t pos = 0;
+	size_t b;
+	unsigned int i;
 
-	assert(input != NULL);
-	assert(RS_STACK_CAPACITY >= rs_stack_len(s) + n);
+	assert(strings != NULL || n == 0);
 
-	memcpy(s->stack.buffer + stack_len, input, n);
-	rs_stack_resize(s, stack_len + n);
-}
+	if (threads < 2 || n < RS_PARALLEL_MIN) {
+		rs_sort(strings, n);
+		return;
+	}
 
-RS_API void rs_heap_cat_n(rapidstring *s, const char *input, size_t n)
-{
-	RS_ASSERT_RS(s);
-	assert(input != NULL);
-	assert(s->heap.capacity >= s->heap.size + n);
+	workers = (rs_parallel_worker *)RS_MALLOC(
+		threads * sizeof(rs_parallel_worker));
 
-	memcpy(s->heap.buffer + rs_heap_len(s), input, n);
-	rs_heap_resize(s, rs_heap_len(s) + n);
-}
+	for (i = 0; i < threads; i++) {
+		workers[i].p = &p;
+		workers[i].id = i;
+	}
 
-RS_API void rs_cat(rapidstring *s, const char *input)
-{
-	assert(input != NULL);
+	p.strings = strings;
+	p.n = n;
+	p.threads = threads;
+	p.workers = workers;
+	p.counts = NULL;
+	p.pending = 0;
+	p.e = (rs_sort_entry *)RS_MALLOC(n * RS_PARALLEL_SLOT);
+	rs_parallel_run(&p, RS_PARALLEL_FILL);
+
+	rs_parallel_sample(&p);
+	p.counts = (size_t *)RS_MALLOC(threads * p.buckets * sizeof(size_t));
+	memset(p.counts, 0, threads * p.buckets * sizeof(size_t));
+	rs_parallel_run(&p, RS_PARALLEL_COUNT);
+
+	/* Each thread writes a bucket after the previous threads. */
+	for (b = 0; b < p.buckets; b++) {
+		for (i = 0; i < threads; i++) {
+			size_t *count = p.counts + i * p.buckets + b;
+			const size_t size = *count;
+
+			*count = pos;
+			pos += size;
+		}
+	}
 
-	rs_cat_n(s, input, strlen(input));
-}
+	p.out = (rs_sort_entry *)RS_MALLOC(n * sizeof(rs_sort_entry));
+	rs_parallel_run(&p, RS_PARALLEL_SCATTER);
 
-RS_API void rs_cat_n(rapidstring *s, const char *input, size_t n)
-{
-	if (RS_HEAP_LIKELY(rs_is_heap(s))) {
-		rs_grow_heap(s, rs_heap_len(s) + n);
-		rs_heap_cat_n(s, input, n);
-	} else if (RS_HEAP_LIKELY(s->stack.left < n)) {
-		rs_stack_to_heap_g(s, n);
-		rs_heap_cat_n(s, input, n);
-	} else {
-		rs_stack_cat_n(s, input, n);
+	p.deques = (rs_sort_deque *)RS_MALLOC(threads * sizeof(rs_sort_deque));
+
+	for (i = 0; i < threads; i++) {
+		RS_MUTEX_INIT(&p.deques[i].lock);
+		p.deques[i].tasks = NULL;
+		p.deques[i].head = 0;
+		p.deques[i].tail = 0;
+		p.deques[i].capacity = 0;
 	}
-}
 
-RS_API void rs_cat_rs(rapidstring *s, const rapidstring *input)
-{
-	RS_DATA_SIZE(rs_cat_n, s, input);
-}
+	/*
+	 * The last thread ended each bucket, which starts where the previous
+	 * one ends.
+	 */
+	for (b = 0, pos = 0; b < p.buckets; b++) {
+		const size_t end = p.counts[(threads - 1) * p.buckets + b];
+		const size_t size = end - pos;
 
-RS_API void rs_steal(rapidstring *s, char *buffer, size_t cap, size_t size)
-{
-	assert(buffer != NULL);
-	assert(cap > size);
-	assert(cap >= 1);
+		rs_parallel_push(&p, (unsigned int)(b % threads), p.out + pos,
+				 size, 0, rs_sort_budget(size));
+		pos = end;
+	}
 
-	s->heap.flag = RS_HEAP_FLAG;
-	s->heap.buffer = buffer;
-	s->heap.capacity = cap - 1;
-	rs_heap_resize(s, size);
+	rs_parallel_run(&p, RS_PARALLEL_SORT);
+
+	for (i = 0; i < threads; i++) {
+		RS_MUTEX_FREE(&p.deques[i].lock);
+		RS_FREE(p.deques[i].tasks);
+	}
+
+	/* The entries in the order of the strings are no longer needed. */
+	p.sorted = (rapidstring *)(void *)p.e;
+	rs_parallel_run(&p, RS_PARALLEL_GATHER);
+	rs_parallel_run(&p, RS_PARALLEL_COPY);
+
+	RS_FREE(p.e);
+	RS_FREE(p.deques);
+	RS_FREE(p.out);
+	RS_FREE(p.counts);
+	RS_FREE(p.splitters);
+	RS_FREE(workers);
 }
 
-RS_API void rs_stack_erase(rapidstring *s, size_t index, size_t n)
+RS_API void rs_parallel_run(rs_parallel *p, unsigned int step)
 {
-	const size_t total = index + n;
-	const size_t stack_len = rs_stack_len(s);
+	unsigned int i;
 
-	assert(rs_is_stack(s));
-	assert(index <= stack_len);
-	assert(n <= stack_len - index);
+	p->step = step;
 
-	memmove(s->stack.buffer + index, s->stack.buffer + total,
-		stack_len - total + 1);
-	s->stack.left += (unsigned char)(n);
-}
+	for (i = 1; i < p->threads; i++) {
+		rs_parallel_worker *w = p->workers + i;
 
-RS_API void rs_heap_erase(rapidstring *s, size_t index, size_t n)
-{
-	const size_t total = index + n;
-	const size_t heap_len = rs_heap_len(s);
+		w->started =
+			RS_THREAD_CREATE(&w->handle, rs_parallel_thread, w);
 
-	assert(rs_is_heap(s));
-	assert(index <= heap_len);
-	assert(n <= heap_len - index);
+		/* The calling thread works for a thread it cannot create. */
+		if (RS_UNLIKELY(!w->started))
+			rs_parallel_step(p, i);
+	}
 
-	memmove(s->heap.buffer + index, s->heap.buffer + total,
-		heap_len - total + 1);
-	s->heap.size -= n;
-}
+	rs_parallel_step(p, 0);
 
-RS_API void rs_erase(rapidstring *s, size_t index, size_t n)
-{
-	if (RS_HEAP_LIKELY(rs_is_heap(s)))
-		rs_heap_erase(s, index, n);
-	else
-		rs_stack_erase(s, index, n);
+	for (i = 1; i < p->threads; i++)
+		if (RS_LIKELY(p->workers[i].started))
+			RS_THREAD_JOIN(p->workers[i].handle);
 }
 
-RS_API void rs_stack_clear(rapidstring *s)
+RS_API RS_THREAD_RESULT rs_parallel_thread(void *arg)
 {
-	rs_stack_resize(s, 0);
-}
+	const rs_parallel_worker *w = (const rs_parallel_worker *)arg;
 
-RS_API void rs_heap_clear(rapidstring *s)
-{
-	rs_heap_resize(s, 0);
-}
+	rs_parallel_step(w->p, w->id);
 
-RS_API void rs_clear(rapidstring *s)
-{
-	if (RS_HEAP_LIKELY(rs_is_heap(s)))
-		rs_heap_clear(s);
-	else
-		rs_stack_clear(s);
+#ifdef RS_POOL
+	/* The buffers kept by the thread would leak once it exits. */
+	rs_pool_flush();
+#endif
+
+	return RS_THREAD_RETURN;
 }
 
-RS_API void rs_stack_resize(rapidstring *s, size_t n)
+RS_API void rs_parallel_step(rs_parallel *p, unsigned int id)
 {
-	assert(RS_STACK_CAPACITY >= n);
+	const size_t share = p->n / p->threads;
+	const size_t begin = share * id;
+	const size_t end = id + 1 == p->threads ? p->n : begin + share;
+	size_t i;
+
+	switch (p->step) {
+	case RS_PARALLEL_FILL:
+		rs_sort_fill(p->strings, p->e, begin, end);
+		break;
+	case RS_PARALLEL_COUNT: {
+		size_t *counts = p->counts + id * p->buckets;
+
+		for (i = begin; i < end; i++)
+			counts[rs_parallel_bucket(p, p->e[i].key)]++;
+
+		break;
+	}
+	case RS_PARALLEL_SCATTER: {
+		size_t *counts = p->counts + id * p->buckets;
 
-	s->stack.buffer[n] = '\0';
-	s->stack.left = (unsigned char)(RS_STACK_CAPACITY - n);
+		for (i = begin; i < end; i++)
+			p->out[counts[rs_parallel_bucket(p, p->e[i].key)]++] =
+				p->e[i];
+
+		break;
+	}
+	case RS_PARALLEL_SORT:
+		rs_parallel_work(p, id);
+		break;
+	case RS_PARALLEL_GATHER:
+		for (i = begin; i < end; i++)
+			p->sorted[i] = p->strings[p->out[i].index];
+
+		break;
+	default:
+		memcpy(p->strings + begin, p->sorted + begin,
+		       (end - begin) * sizeof(rapidstring));
+		break;
+	}
 }
 
-RS_API void rs_heap_resize(rapidstring *s, size_t n)
+RS_API void rs_parallel_sample(rs_parallel *p)
 {
-	assert(rs_is_heap(s));
-	assert(s->heap.capacity >= n);
+	const size_t buckets = (size_t)p->threads * RS_PARALLEL_BUCKETS;
+	size_t count = buckets * RS_PARALLEL_OVERSAMPLE;
+	size_t step;
+	size_t i;
+	uint64_t *samples;
 
-	s->heap.buffer[n] = '\0';
-	s->heap.size = n;
-}
+	if (count > p->n)
+		count = p->n;
 
-RS_API void rs_resize(rapidstring *s, size_t n)
-{
-	if (RS_HEAP_LIKELY(n > RS_STACK_CAPACITY)) {
-		if (RS_HEAP_LIKELY(rs_is_heap(s)))
-			rs_reserve(s, n);
-		else
-			rs_stack_to_heap(s, n);
+	step = p->n / count;
+	samples = (uint64_t *)RS_MALLOC(count * sizeof(uint64_t));
 
-		rs_heap_resize(s, n);
-	} else {
-		rs_stack_resize(s, n);
+	for (i = 0; i < count; i++)
+		samples[i] = p->e[i * step].key;
+
+	qsort(samples, count, sizeof(uint64_t), rs_parallel_key_cmp);
+
+	p->splitters = (uint64_t *)RS_MALLOC(buckets * sizeof(uint64_t));
+	p->splitter_count = 0;
+
+	/* Frequent keys are sampled repeatedly but split only once. */
+	for (i = 1; i < buckets; i++) {
+		const uint64_t key = samples[i * count / buckets];
+
+		if (p->splitter_count == 0 ||
+		    p->splitters[p->splitter_count - 1] != key)
+			p->splitters[p->splitter_count++] = key;
 	}
+
+	p->buckets = p->splitter_count * 2 + 1;
+	RS_FREE(samples);
 }
 
-RS_API void rs_resize_w(rapidstring *s, size_t n, char c)
+RS_API size_t rs_parallel_bucket(const rs_parallel *p, uint64_t key)
 {
-	const size_t sz = rs_len(s);
+	size_t low = 0;
+	size_t high = p->splitter_count;
 
-	rs_resize(s, n);
+	while (low < high) {
+		const size_t mid = low + (high - low) / 2;
 
-	if (RS_LIKELY(sz < n)) {
-		const size_t diff = n - sz;
-		memset(rs_data(s) + sz, c, diff);
+		if (p->splitters[mid] < key)
+			low = mid + 1;
+		else
+			high = mid;
 	}
-}
 
-/*
- * ===============================================================
- *
- *                         HEAP OPERATIONS
- *
- * ===============================================================
- */
+	if (low < p->splitter_count && p->splitters[low] == key)
+		return low * 2 + 1;
 
-RS_API void rs_heap_init(rapidstring *s, size_t n)
-{
-	s->heap.buffer = (char *)RS_MALLOC(n + 1);
-	s->heap.capacity = n;
-	s->heap.flag = RS_HEAP_FLAG;
+	return low * 2;
 }
 
-RS_API void rs_heap_init_g(rapidstring *s, size_t n)
+RS_API void rs_parallel_work(rs_parallel *p, unsigned int id)
 {
-	rs_heap_init(s, n * RS_GROWTH_FACTOR);
+	rs_sort_task task;
+
+	for (;;) {
+		if (rs_parallel_pop(p, id, &task)) {
+			rs_sort_entry *e = task.e;
+			size_t n = task.n;
+			size_t depth = task.depth;
+			size_t budget = task.budget;
+
+			/* The smaller and greater keys are left to steal. */
+			while (n > RS_PARALLEL_GRAIN && budget != 0) {
+				size_t lt;
+				size_t gt;
+				size_t done;
+
+				budget--;
+				rs_sort_partition(e, n, &lt, &gt);
+				rs_parallel_push(p, id, e, lt, depth, budget);
+				rs_parallel_push(p, id, e + gt, n - gt, depth,
+						 budget);
+
+				e += lt;
+				n = gt - lt;
+				done = rs_sort_deepen(e, n, depth);
+				e += done;
+				n -= done;
+				depth += 8;
+				budget = rs_sort_budget(n);
+			}
+
+			rs_sort_intro(e, n, depth, budget);
+			RS_ATOMIC_ADD(&p->pending, -1);
+		} else if (RS_ATOMIC_ADD(&p->pending, 0) == 0) {
+			/* Tasks are only pushed by unfinished tasks. */
+			break;
+		} else {
+			RS_THREAD_YIELD();
+		}
+	}
 }
 
-RS_API void rs_stack_to_heap(rapidstring *s, size_t n)
+RS_API void rs_parallel_push(rs_parallel *p, unsigned int id,
+			     rs_sort_entry *e, size_t n, size_t depth,
+			     size_t budget)
 {
-	const size_t stack_len = rs_stack_len(s);
+	rs_sort_deque *d = p->deques + id;
+
+	if (n < 2)
+		return;
+
+	RS_ATOMIC_ADD(&p->pending, 1);
+	RS_MUTEX_LOCK(&d->lock);
+
+	if (RS_UNLIKELY(d->tail == d->capacity)) {
+		if (d->head != 0) {
+			memmove(d->tasks, d->tasks + d->head,
+				(d->tail - d->head) * sizeof(rs_sort_task));
+			d->tail -= d->head;
+			d->head = 0;
+		} else {
+			d->capacity = d->capacity != 0 ?
+					      d->capacity * RS_GROWTH_FACTOR :
+					      RS_PARALLEL_MIN_TASKS;
+			d->tasks = (rs_sort_task *)RS_REALLOC(
+				d->tasks, d->capacity * sizeof(rs_sort_task));
+		}
+	}
 
-	char tmp[RS_STACK_CAPACITY];
-	memcpy(tmp, s->stack.buffer, stack_len);
+	d->tasks[d->tail].e = e;
+	d->tasks[d->tail].n = n;
+	d->tasks[d->tail].depth = depth;
+	d->tasks[d->tail].budget = budget;
+	d->tail++;
 
-	rs_heap_init(s, stack_len + n);
-	rs_heap_cpy_n(s, tmp, stack_len);
+	RS_MUTEX_UNLOCK(&d->lock);
 }
 
-RS_API void rs_stack_to_heap_g(rapidstring *s, size_t n)
+RS_API unsigned char rs_parallel_pop(rs_parallel *p, unsigned int id,
+				     rs_sort_task *task)
 {
-	rs_stack_to_heap(s, n * RS_GROWTH_FACTOR);
-}
+	unsigned int i;
 
-RS_API void rs_realloc(rapidstring *s, size_t n)
-{
-	s->heap.buffer = (char *)RS_REALLOC(s->heap.buffer, n + 1);
-	s->heap.capacity = n;
+	for (i = 0; i < p->threads; i++) {
+		rs_sort_deque *d = p->deques + (id + i) % p->threads;
+		unsigned char found = 0;
+
+		RS_MUTEX_LOCK(&d->lock);
+
+		/* Thieves take the oldest tasks, which are the largest. */
+		if (d->head != d->tail) {
+			*task = i == 0 ? d->tasks[--d->tail] :
+					 d->tasks[d->head++];
+			found = 1;
+
+			if (d->head == d->tail) {
+				d->head = 0;
+				d->tail = 0;
+			}
+		}
+
+		RS_MUTEX_UNLOCK(&d->lock);
+
+		if (found)
+			return 1;
+	}
+
+	return 0;
 }
 
-RS_API void rs_grow_heap(rapidstring *s, size_t n)
+RS_API int rs_parallel_key_cmp(const void *a, const void *b)
 {
-	if (RS_UNLIKELY(s->heap.capacity < n))
-		rs_realloc(s, n * RS_GROWTH_FACTOR);
+	const uint64_t x = *(const uint64_t *)a;
+	const uint64_t y = *(const uint64_t *)b;
+
+	return (x > y) - (x < y);
 }
 
+#endif /* RS_PARALLEL */
+
 #endif /* !RAPIDSTRING_H_962AB5F800398A34 */
@@ -0,0 +1,106 @@
+#include "utility.hpp"
+#include <cstddef>
+
+/* Theme: The Lord of the Rings. */
+
+TEST_CASE("allocator construction")
+{
+	const std::string first{ "One does not simply walk into Mordor." };
+
+	counter c{};
+	const rs_allocator a{ count_alloc, count_realloc, count_free, &c };
+
+	rapidstring s;
+	rs_init_w_alloc(&s, &a);
+
+	REQUIRE(rs_is_heap(&s));
+	REQUIRE(rs_get_alloc(&s) == &a);
+	REQUIRE(rs_cap(&s) == RS_STACK_CAPACITY);
+	REQUIRE(c.allocs == 1);
+	VALIDATE_RS(&s, std::string{});
+
+	rs_cpy(&s, first.data());
+
+	VALIDATE_RS(&s, first);
+	REQUIRE(c.reallocs == 1);
+
+	rs_free(&s);
+
+	REQUIRE(c.deallocs == 1);
+	REQUIRE(c.bytes == 0);
+}
+
+TEST_CASE("allocator growth")
+{
+	const std::string first{ "Even the smallest person " };
+	const std::string second{ "can change the course of the future." };
+
+	counter c{};
+	const rs_allocator a{ count_alloc, count_realloc, count_free, &c };
+
+	rapidstring s;
+	rs_init_w_cap_alloc(&s, 1, &a);
+
+	rs_cat(&s, first.data());
+	rs_cat(&s, second.data());
+
+	VALIDATE_RS(&s, first + second);
+	REQUIRE(rs_get_alloc(&s) == &a);
+
+	rs_shrink_to_fit(&s);
+
+	VALIDATE_RS(&s, first + second);
+	REQUIRE(rs_cap(&s) == first.size() + second.size());
+
+	rs_resize(&s, 3);
+
+	VALIDATE_RS(&s, first.substr(0, 3));
+	REQUIRE(rs_is_heap(&s));
+
+	rs_free(&s);
+
+	REQUIRE(c.allocs == 1);
+	REQUIRE(c.deallocs == 1);
+	REQUIRE(c.bytes == 0);
+}
+
+TEST_CASE("allocator without reallocation")
+{
+	const std::string first{ "All we have to decide is what to do with the "
+				 "time that is given to us." };
+
+	counter c{};
+	const rs_allocator a{ count_alloc, nullptr, count_free, &c };
+
+	rapidstring s;
+	rs_init_w_alloc(&s, &a);
+
+	rs_cpy(&s, first.data());
+
+	VALIDATE_RS(&s, first);
+	REQUIRE(c.allocs == 2);
+	REQUIRE(c.deallocs == 1);
+
+	rs_free(&s);
+
+	REQUIRE(c.deallocs == 2);
+	REQUIRE(c.bytes == 0);
+}
+
+TEST_CASE("default allocator")
+{
+	const std::string first{ "Fly, you fools!" };
+	const std::string second{ "Not all those who wander are lost." };
+
+	rapidstring s;
+	rs_init_w(&s, first.data());
+
+	REQUIRE(rs_get_alloc(&s) == nullptr);
+
+	rs_cpy(&s, second.data());
+
+	REQUIRE(rs_get_alloc(&s) == nullptr);
+	VALIDATE_RS(&s, second);
+
+	rs_free(&s);
+}
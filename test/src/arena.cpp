@@ -0,0 +1,105 @@
+#include "utility.hpp"
+#include <cstddef>
+
+/* Theme: Star Wars. */
+
+TEST_CASE("arena construction")
+{
+	const std::string first{ "Do. Or do not. There is no try." };
+
+	rs_arena a;
+	rs_arena_init(&a, 1024);
+
+	rapidstring s;
+	rs_init_w_alloc(&s, rs_arena_alloc(&a));
+	rs_cpy(&s, first.data());
+
+	VALIDATE_RS(&s, first);
+	REQUIRE(rs_get_alloc(&s) == rs_arena_alloc(&a));
+
+	rs_free(&s);
+	rs_arena_free(&a);
+}
+
+TEST_CASE("arena in place growth")
+{
+	const std::string first{ "I find your lack of faith disturbing." };
+
+	rs_arena a;
+	rs_arena_init(&a, 1024);
+
+	rapidstring s;
+	rs_init_w_alloc(&s, rs_arena_alloc(&a));
+
+	const char *buffer = rs_data_c(&s);
+	std::string cmp;
+
+	for (int i = 0; i < 10; i++) {
+		rs_cat(&s, first.data());
+		cmp += first;
+	}
+
+	VALIDATE_RS(&s, cmp);
+	REQUIRE(rs_data_c(&s) == buffer);
+
+	rs_free(&s);
+	rs_arena_free(&a);
+}
+
+TEST_CASE("arena multiple strings")
+{
+	const std::string first{
+		"Help me, Obi-Wan Kenobi. You're my only hope."
+	};
+	const std::string second{ "It's a trap!" };
+
+	rs_arena a;
+	rs_arena_init(&a, 64);
+
+	rapidstring s1, s2;
+	rs_init_w_alloc(&s1, rs_arena_alloc(&a));
+	rs_init_w_alloc(&s2, rs_arena_alloc(&a));
+
+	rs_cpy(&s1, second.data());
+	rs_cpy(&s2, second.data());
+
+	for (int i = 0; i < 5; i++) {
+		rs_cat(&s1, first.data());
+		rs_cat(&s2, second.data());
+	}
+
+	std::string cmp1{ second }, cmp2{ second };
+
+	for (int i = 0; i < 5; i++) {
+		cmp1 += first;
+		cmp2 += second;
+	}
+
+	VALIDATE_RS(&s1, cmp1);
+	VALIDATE_RS(&s2, cmp2);
+
+	rs_arena_free(&a);
+}
+
+TEST_CASE("arena reset")
+{
+	const std::string first{ "Never tell me the odds!" };
+
+	rs_arena a;
+	rs_arena_init(&a, 256);
+
+	for (int i = 0; i < 100; i++) {
+		rapidstring s;
+		rs_init_w_alloc(&s, rs_arena_alloc(&a));
+		rs_cpy(&s, first.data());
+
+		VALIDATE_RS(&s, first);
+
+		rs_arena_reset(&a);
+	}
+
+	REQUIRE(a.head != nullptr);
+	REQUIRE(a.head->next == nullptr);
+
+	rs_arena_free(&a);
+}
@@ -0,0 +1,207 @@
+#include "utility.hpp"
+#include <cstddef>
+
+/* Theme: Ghostbusters. */
+
+static std::string lower(std::string str)
+{
+	for (auto &c : str)
+		if (c >= 'A' && c <= 'Z')
+			c = static_cast<char>(c + ('a' - 'A'));
+
+	return str;
+}
+
+static std::string upper(std::string str)
+{
+	for (auto &c : str)
+		if (c >= 'a' && c <= 'z')
+			c = static_cast<char>(c - ('a' - 'A'));
+
+	return str;
+}
+
+static int sign(int i)
+{
+	return (i > 0) - (i < 0);
+}
+
+static void validate_icase(const std::string &first, const std::string &second)
+{
+	rapidstring s1;
+	rapidstring s2;
+	rs_init_w_n(&s1, first.data(), first.size());
+	rs_init_w_n(&s2, second.data(), second.size());
+
+	const auto expected = sign(lower(first).compare(lower(second)));
+	const auto equal = lower(first) == lower(second);
+
+	REQUIRE(sign(rs_cmp_icase_rs(&s1, &s2)) == expected);
+	REQUIRE(sign(rs_cmp_icase_n(&s1, second.data(), second.size())) ==
+		expected);
+	REQUIRE(rs_eq_icase_rs(&s1, &s2) == equal);
+	REQUIRE(rs_eq_icase_n(&s1, second.data(), second.size()) == equal);
+
+	if (equal)
+		REQUIRE(rs_hash_icase(&s1) == rs_hash_icase(&s2));
+
+	rs_free(&s1);
+	rs_free(&s2);
+}
+
+TEST_CASE("case conversion stack")
+{
+	const std::string first{ "Who ya gonna call?" };
+
+	rapidstring s;
+	rs_init_w(&s, first.data());
+
+	rs_to_upper(&s);
+	VALIDATE_RS(&s, upper(first));
+
+	rs_to_lower(&s);
+	VALIDATE_RS(&s, lower(first));
+
+	rs_free(&s);
+}
+
+TEST_CASE("case conversion heap")
+{
+	const std::string first{
+		"There is no Dana, there is only ZUUL. Don't cross the streams!"
+	};
+
+	rapidstring s;
+	rs_init_w(&s, first.data());
+
+	rs_to_lower(&s);
+	VALIDATE_RS(&s, lower(first));
+
+	rs_to_upper(&s);
+	VALIDATE_RS(&s, upper(first));
+
+	rs_free(&s);
+}
+
+TEST_CASE("case conversion lengths")
+{
+	std::string first;
+
+	for (std::size_t i = 0; i < 100; i++) {
+		/* Cover every byte, including those outside of ASCII. */
+		first.push_back(static_cast<char>(i * 37 + 11));
+
+		rapidstring s;
+		rs_init_w_n(&s, first.data(), first.size());
+
+		rs_to_lower(&s);
+		VALIDATE_RS(&s, lower(first));
+
+		rs_to_upper(&s);
+		VALIDATE_RS(&s, upper(first));
+
+		rs_free(&s);
+	}
+}
+
+TEST_CASE("case conversion shared")
+{
+	const std::string first{ "Ray, when someone asks you if you're a god" };
+
+	rapidstring s1;
+	rapidstring s2;
+	rs_init_w(&s1, first.data());
+	rs_freeze(&s1);
+	rs_init_w_rs(&s2, &s1);
+
+	rs_to_upper(&s2);
+
+	VALIDATE_RS(&s1, first);
+	VALIDATE_RS(&s2, upper(first));
+
+	rs_free(&s1);
+	rs_free(&s2);
+}
+
+TEST_CASE("case insensitive compare")
+{
+	const std::string first{ "Venkman" };
+	const std::string second{ "Content-Type: text/html; charset=UTF-8" };
+
+	validate_icase(first, "VENKMAN");
+	validate_icase(first, "venkman");
+	validate_icase(first, "venkmaN!");
+	validate_icase(first, "VENK");
+	validate_icase(first, "Stantz");
+	validate_icase(first, "[enkman");
+	validate_icase(second, "content-type: TEXT/HTML; CHARSET=utf-8");
+	validate_icase(second, "content-type: TEXT/HTML; CHARSET=utf-7");
+	validate_icase(second, "CONTENT-TYPE");
+	validate_icase("", "");
+	validate_icase("", "Spengler");
+	validate_icase("@[`{", "@[`{");
+	validate_icase("@", "`");
+	validate_icase("[", "{");
+
+	rapidstring s;
+	rs_init_w(&s, first.data());
+
+	REQUIRE(rs_eq_icase(&s, "vEnKmAn"));
+	REQUIRE(!rs_eq_icase(&s, "vEnKmA"));
+	REQUIRE(rs_eq_icase_v(&s, rs_view_n("VENKMAN", 7)));
+	REQUIRE(rs_cmp_icase(&s, "VENKMAN") == 0);
+	REQUIRE(rs_cmp_icase(&s, "Zeddemore") < 0);
+	REQUIRE(rs_cmp_icase_v(&s, rs_view_n("barrett", 7)) > 0);
+
+	rs_free(&s);
+}
+
+TEST_CASE("case insensitive compare lengths")
+{
+	std::string first;
+	std::string second;
+
+	for (std::size_t i = 0; i < 100; i++) {
+		const auto c = static_cast<char>('a' + i % 26);
+
+		first.push_back(c);
+		second.push_back(static_cast<char>(c - ('a' - 'A')));
+
+		validate_icase(first, second);
+
+		/* Change a single character at every position. */
+		for (std::size_t j = 0; j <= i; j++) {
+			auto third = second;
+			third[j] = '_';
+
+			validate_icase(first, third);
+		}
+	}
+}
+
+TEST_CASE("case insensitive hash")
+{
+	std::string first;
+
+	for (std::size_t i = 0; i < 200; i++) {
+		first.push_back(static_cast<char>(i * 37 + 11));
+
+		rapidstring s1;
+		rapidstring s2;
+		rs_init_w_n(&s1, first.data(), first.size());
+		rs_init_w_n(&s2, first.data(), first.size());
+		rs_to_lower(&s2);
+
+		const auto hash = rs_hash(&s2);
+
+		REQUIRE(rs_hash_icase(&s1) == hash);
+		REQUIRE(rs_hash_icase(&s2) == hash);
+		REQUIRE(rs_hash_icase_n(first.data(), first.size()) == hash);
+
+		rs_to_upper(&s1);
+		REQUIRE(rs_hash_icase(&s1) == hash);
+
+		rs_free(&s1);
+		rs_free(&s2);
+	}
+}
@@ -0,0 +1,123 @@
+#include "utility.hpp"
+#include <cstddef>
+
+/* Theme: Harry Potter. */
+
+static int sign(int i)
+{
+	return (i > 0) - (i < 0);
+}
+
+static void validate_cmp(const std::string &first, const std::string &second)
+{
+	rapidstring s1;
+	rapidstring s2;
+	rs_init_w_n(&s1, first.data(), first.size());
+	rs_init_w_n(&s2, second.data(), second.size());
+
+	const auto expected = sign(first.compare(second));
+
+	REQUIRE(sign(rs_cmp_rs(&s1, &s2)) == expected);
+	REQUIRE(sign(rs_cmp_n(&s1, second.data(), second.size())) == expected);
+	REQUIRE(rs_eq_rs(&s1, &s2) == (first == second));
+	REQUIRE(rs_eq_n(&s1, second.data(), second.size()) ==
+		(first == second));
+	REQUIRE(rs_starts_with_rs(&s1, &s2) ==
+		(first.compare(0, second.size(), second) == 0));
+	REQUIRE(rs_ends_with_rs(&s1, &s2) ==
+		(first.size() >= second.size() &&
+		 first.compare(first.size() - second.size(), second.size(),
+			       second) == 0));
+
+	rs_free(&s1);
+	rs_free(&s2);
+}
+
+TEST_CASE("compare stack")
+{
+	const std::string first{ "Mischief managed." };
+
+	rapidstring s;
+	rs_init_w(&s, first.data());
+
+	REQUIRE(rs_eq(&s, first.data()));
+	REQUIRE(!rs_eq(&s, "Mischief managed"));
+	REQUIRE(rs_cmp(&s, first.data()) == 0);
+	REQUIRE(rs_cmp(&s, "Mischief") > 0);
+	REQUIRE(rs_cmp(&s, "Mischief managed!") > 0);
+	REQUIRE(rs_cmp(&s, "Nox") < 0);
+	REQUIRE(rs_starts_with(&s, "Mischief"));
+	REQUIRE(rs_starts_with(&s, ""));
+	REQUIRE(!rs_starts_with(&s, "Lumos"));
+	REQUIRE(rs_ends_with(&s, "managed."));
+	REQUIRE(rs_ends_with(&s, ""));
+	REQUIRE(!rs_ends_with(&s, "I solemnly swear that I am up to no good."));
+
+	rs_free(&s);
+}
+
+TEST_CASE("compare heap")
+{
+	const std::string first{ "It does not do to dwell on dreams and forget "
+				 "to live." };
+
+	rapidstring s;
+	rs_init_w(&s, first.data());
+
+	REQUIRE(rs_eq(&s, first.data()));
+	REQUIRE(!rs_eq(&s, "It does not do to dwell on dreams and forget "
+			   "to live!"));
+	REQUIRE(rs_cmp(&s, "It does not do to dwell on dreams") > 0);
+	REQUIRE(rs_starts_with(&s, "It does not do to dwell on dreams"));
+	REQUIRE(rs_ends_with(&s, "and forget to live."));
+
+	rs_free(&s);
+}
+
+TEST_CASE("compare stack with garbage")
+{
+	const std::string first{ "Always." };
+
+	rapidstring s1;
+	rapidstring s2;
+	rs_init_w(&s1, "Always, said Snape.");
+	rs_init_w(&s2, "Always? asked Dumbledore.");
+
+	/* Characters past the null terminator must not be compared. */
+	rs_resize(&s1, first.size());
+	rs_resize(&s2, first.size());
+	s1.stack.buffer[first.size() - 1] = '.';
+	s2.stack.buffer[first.size() - 1] = '.';
+
+	REQUIRE(rs_eq_rs(&s1, &s2));
+	REQUIRE(rs_cmp_rs(&s1, &s2) == 0);
+
+	rs_free(&s1);
+	rs_free(&s2);
+}
+
+TEST_CASE("compare lengths")
+{
+	const std::string alphabet{ "abcdefghijklmnopqrstuvwxyz" };
+	std::string first;
+
+	for (std::size_t i = 0; i < 100; i++)
+		first += alphabet[i % alphabet.size()];
+
+	for (std::size_t i = 0; i <= first.size(); i++) {
+		const auto prefix = first.substr(0, i);
+
+		validate_cmp(first, prefix);
+		validate_cmp(prefix, first);
+		validate_cmp(prefix, prefix);
+
+		if (i < first.size()) {
+			auto changed = prefix + first[i];
+			changed[i] = '\xFF';
+
+			validate_cmp(prefix + first[i], changed);
+			validate_cmp(changed, prefix + first[i]);
+			validate_cmp(first.substr(i), first.substr(i / 2));
+		}
+	}
+}
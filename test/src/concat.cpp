@@ -77,3 +77,186 @@ TEST_CASE("String concatenation")
 	rs_free(&s1);
 	rs_free(&s2);
 }
+
+TEST_CASE("Gather concatenation")
+{
+	const std::string first{ "Mornings are for coffee " };
+	const std::string second{ "and contemplation." };
+	const std::string third{ " Nobody normal ever accomplished anything "
+				 "meaningful in this world." };
+
+	const rs_view pieces[]{ rs_view_n(first.data(), first.size()),
+				rs_view_n(second.data(), second.size()),
+				rs_view_n(third.data(), third.size()) };
+
+	rapidstring s;
+	rs_init(&s);
+
+	rs_cat_many(&s, pieces, 0);
+
+	VALIDATE_RS(&s, std::string{});
+
+	rs_cat_many(&s, pieces, 1);
+
+	VALIDATE_RS(&s, first);
+	REQUIRE(rs_is_stack(&s));
+
+	rs_cat_many(&s, pieces, 3);
+
+	VALIDATE_RS(&s, first + first + second + third);
+
+	rs_free(&s);
+}
+
+TEST_CASE("Gather concatenation allocation")
+{
+	const std::string first{ "You shut your mouth " };
+	const std::string second{ "or I'll shut it for you." };
+
+	const rs_view pieces[]{ rs_view_n(first.data(), first.size()),
+				rs_view_n(second.data(), second.size()) };
+
+	rapidstring s;
+	rs_init_w_many(&s, pieces, 2);
+
+	VALIDATE_RS(&s, first + second);
+	REQUIRE(rs_cap(&s) == first.size() + second.size());
+
+	rs_reserve(&s, rs_len(&s) * 3);
+
+	const char *const buffer{ rs_data(&s) };
+
+	rs_cat_many(&s, pieces, 2);
+
+	VALIDATE_RS(&s, first + second + first + second);
+	REQUIRE(rs_data(&s) == buffer);
+
+	rs_free(&s);
+}
+
+TEST_CASE("Gather string concatenation")
+{
+	const std::string first{ "She will not be able to " };
+	const std::string second{ "hide from the " };
+	const std::string third{ "Upside Down forever." };
+
+	rapidstring s1;
+	rs_init_w(&s1, first.data());
+
+	rapidstring s2;
+	rs_init_w(&s2, second.data());
+
+	rapidstring s3;
+	rs_init_w(&s3, third.data());
+
+	const rapidstring *const pieces[]{ &s1, &s2, &s3 };
+
+	rapidstring s;
+	rs_init_w_many_rs(&s, pieces, 3);
+
+	VALIDATE_RS(&s, first + second + third);
+
+	rs_cat_many_rs(&s, pieces + 1, 2);
+
+	VALIDATE_RS(&s, first + second + third + second + third);
+
+	rs_free(&s);
+	rs_free(&s1);
+	rs_free(&s2);
+	rs_free(&s3);
+}
+
+TEST_CASE("Join")
+{
+	const std::string first{ "usr" };
+	const std::string second{ "local" };
+	const std::string third{ "hawkins" };
+
+	const rs_view pieces[]{ rs_view_n(first.data(), first.size()),
+				rs_view_n(second.data(), second.size()),
+				rs_view_n(third.data(), third.size()) };
+
+	rapidstring s;
+	rs_init_w(&s, "Will Byers");
+
+	rs_join(&s, pieces, 3, "/");
+
+	VALIDATE_RS(&s, first + "/" + second + "/" + third);
+	REQUIRE(rs_is_stack(&s));
+
+	rs_join(&s, pieces, 1, "/");
+
+	VALIDATE_RS(&s, first);
+
+	rs_join(&s, pieces, 0, "/");
+
+	VALIDATE_RS(&s, std::string{});
+
+	rs_free(&s);
+}
+
+TEST_CASE("Join allocation")
+{
+	const std::string first{ "Mouth-breather" };
+	const std::string sep{ ", you're a real " };
+
+	const rs_view pieces[]{ rs_view_n(first.data(), first.size()),
+				rs_view_n(first.data(), first.size()),
+				rs_view_n(first.data(), first.size()) };
+	const std::string expected{ first + sep + first + sep + first };
+
+	rapidstring s;
+	rs_init(&s);
+
+	rs_join_n(&s, pieces, 3, sep.data(), sep.size());
+
+	VALIDATE_RS(&s, expected);
+	REQUIRE(rs_cap(&s) == expected.size());
+
+	const char *const buffer{ rs_data(&s) };
+
+	rs_join_n(&s, pieces, 2, sep.data(), sep.size());
+
+	VALIDATE_RS(&s, first + sep + first);
+	REQUIRE(rs_data(&s) == buffer);
+
+	rs_free(&s);
+}
+
+TEST_CASE("String join")
+{
+	const std::string first{ "Eleven" };
+	const std::string second{ "Mike Wheeler" };
+	const std::string third{ "Dustin Henderson" };
+
+	rapidstring s1;
+	rs_init_w(&s1, first.data());
+
+	rapidstring s2;
+	rs_init_w(&s2, second.data());
+
+	rapidstring s3;
+	rs_init_w(&s3, third.data());
+
+	const rapidstring *const pieces[]{ &s1, &s2, &s3 };
+
+	rapidstring s;
+	rs_init(&s);
+
+	rs_join_rs(&s, pieces, 3, " & ");
+
+	VALIDATE_RS(&s, first + " & " + second + " & " + third);
+
+	rs_join_rs_n(&s, pieces, 2, ", and", 2);
+
+	VALIDATE_RS(&s, first + ", " + second);
+
+	rs_join_rs_n(&s, pieces, 3, "", 0);
+
+	VALIDATE_RS(&s, first + second + third);
+
+	rs_free(&s);
+	rs_free(&s1);
+	rs_free(&s2);
+	rs_free(&s3);
+}
@@ -0,0 +1,220 @@
+#include "utility.hpp"
+#include <cstddef>
+
+/* Theme: Mission: Impossible. */
+
+static std::string binary(std::size_t n)
+{
+	std::string str;
+
+	for (std::size_t i = 0; i < n; i++)
+		str.push_back(static_cast<char>(i * 73 + 29));
+
+	return str;
+}
+
+/* Bit at a time reference of RFC 4648. */
+static std::string base64(const std::string &input)
+{
+	static const char alphabet[]{ "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+				      "abcdefghijklmnopqrstuvwxyz"
+				      "0123456789+/" };
+	std::string str;
+	std::size_t bits = 0;
+	unsigned int value = 0;
+
+	for (const auto c : input) {
+		const auto byte = static_cast<unsigned char>(c);
+
+		for (int i = 7; i >= 0; i--) {
+			value = value << 1 | ((byte >> i) & 1);
+
+			if (++bits % 6 == 0) {
+				str.push_back(alphabet[value]);
+				value = 0;
+			}
+		}
+	}
+
+	if (bits % 6 != 0)
+		str.push_back(alphabet[value << (6 - bits % 6)]);
+
+	while (str.size() % 4 != 0)
+		str.push_back('=');
+
+	return str;
+}
+
+TEST_CASE("base64 encoding")
+{
+	const std::string first{ "This message will self-destruct: " };
+	const std::string pairs[][2]{ { "", "" },
+				      { "f", "Zg==" },
+				      { "fo", "Zm8=" },
+				      { "foo", "Zm9v" },
+				      { "foob", "Zm9vYg==" },
+				      { "fooba", "Zm9vYmE=" },
+				      { "foobar", "Zm9vYmFy" } };
+
+	for (const auto &pair : pairs) {
+		rapidstring s;
+		rs_init_w(&s, first.data());
+
+		rs_cat_base64_n(&s, pair[0].data(), pair[0].size());
+		VALIDATE_RS(&s, first + pair[1]);
+
+		rs_cpy(&s, first.data());
+
+		REQUIRE(rs_decode_base64_v(
+			&s, rs_view_n(pair[1].data(), pair[1].size())));
+		VALIDATE_RS(&s, first + pair[0]);
+
+		rs_free(&s);
+	}
+}
+
+TEST_CASE("base64 round trip")
+{
+	for (std::size_t i = 0; i < 200; i++) {
+		const auto input = binary(i);
+
+		rapidstring s1;
+		rapidstring s2;
+		rs_init(&s1);
+		rs_init(&s2);
+
+		rs_cat_base64_v(&s1, rs_view_n(input.data(), input.size()));
+		VALIDATE_RS(&s1, base64(input));
+
+		REQUIRE(rs_decode_base64_n(&s2, rs_data_c(&s1), rs_len(&s1)));
+		VALIDATE_RS(&s2, input);
+
+		/* The padding may be left out. */
+		std::string unpadded{ rs_data_c(&s1), rs_len(&s1) };
+		unpadded.erase(unpadded.find_last_not_of('=') + 1);
+
+		rs_cpy(&s2, "");
+		REQUIRE(rs_decode_base64_n(&s2, unpadded.data(),
+					   unpadded.size()));
+		VALIDATE_RS(&s2, input);
+
+		rs_free(&s1);
+		rs_free(&s2);
+	}
+}
+
+TEST_CASE("base64 invalid")
+{
+	const std::string first{ "Ethan Hunt" };
+	const char *const invalid[]{ "Z",	  "Zg=",      "Z===",
+				     "====",	  "Zg==Zg==", "Zm9v!mFy",
+				     "Zm9v\xC2mFy", "Zm 9v",    "Zm9vY" };
+
+	for (const auto *input : invalid) {
+		rapidstring s;
+		rs_init_w(&s, first.data());
+
+		REQUIRE(!rs_decode_base64_n(&s, input, strlen(input)));
+		VALIDATE_RS(&s, first);
+
+		rs_free(&s);
+	}
+}
+
+TEST_CASE("base64 invalid long")
+{
+	const std::string first{ "Ethan Hunt" };
+	const char invalid[]{ '!', '-', '_', ' ', '.', ':', '@',
+			      '[', '`', '{', '\x7F', '\x80', '\xAB', '\xFF' };
+
+	rapidstring s;
+	rs_init_w(&s, first.data());
+
+	/* Each invalid digit at every position. */
+	for (std::size_t i = 0; i < 100; i++) {
+		for (const auto c : invalid) {
+			std::string input{ base64(binary(75)) };
+			input[i] = c;
+
+			REQUIRE(!rs_decode_base64_n(&s, input.data(),
+						    input.size()));
+			VALIDATE_RS(&s, first);
+		}
+	}
+
+	rs_free(&s);
+}
+
+TEST_CASE("hex encoding")
+{
+	const std::string first{ "Your mission, should you choose to accept it" };
+	const std::string input{ "\x10\x01\x7F\x80\xAB\xFF" };
+
+	rapidstring s;
+	rs_init_w(&s, first.data());
+
+	rs_cat_hex_n(&s, input.data(), input.size());
+	VALIDATE_RS(&s, first + "10017f80abff");
+
+	rs_cpy(&s, "");
+
+	REQUIRE(rs_decode_hex_v(&s, rs_view_n("10017F80aBfF", 12)));
+	VALIDATE_RS(&s, input);
+
+	rs_free(&s);
+}
+
+TEST_CASE("hex round trip")
+{
+	static const char digits[]{ "0123456789abcdef" };
+
+	for (std::size_t i = 0; i < 200; i++) {
+		const auto input = binary(i);
+		std::string expected;
+
+		for (const auto c : input) {
+			expected.push_back(digits[(c >> 4) & 0xF]);
+			expected.push_back(digits[c & 0xF]);
+		}
+
+		rapidstring s1;
+		rapidstring s2;
+		rs_init(&s1);
+		rs_init(&s2);
+
+		rs_cat_hex_v(&s1, rs_view_n(input.data(), input.size()));
+		VALIDATE_RS(&s1, expected);
+
+		REQUIRE(rs_decode_hex_n(&s2, rs_data_c(&s1), rs_len(&s1)));
+		VALIDATE_RS(&s2, input);
+
+		rs_free(&s1);
+		rs_free(&s2);
+	}
+}
+
+TEST_CASE("hex invalid")
+{
+	const std::string first{ "IMF" };
+	const char invalid[]{ 'g', 'G', '/', ':', '@', '`', ' ', '\x80', '\xC6' };
+
+	rapidstring s;
+	rs_init_w(&s, first.data());
+
+	REQUIRE(!rs_decode_hex_n(&s, "abc", 3));
+	VALIDATE_RS(&s, first);
+
+	/* Each invalid digit at every position. */
+	for (std::size_t i = 0; i < 100; i++) {
+		for (const auto c : invalid) {
+			std::string input(100, 'e');
+			input[i] = c;
+
+			REQUIRE(!rs_decode_hex_n(&s, input.data(),
+						 input.size()));
+			VALIDATE_RS(&s, first);
+		}
+	}
+
+	rs_free(&s);
+}
@@ -0,0 +1,127 @@
+#include "utility.hpp"
+#include <cstddef>
+#include <cstdlib>
+
+/* Theme: The Lion King. */
+
+#define VALIDATE_GAP(g, cmp)                              \
+	do {                                              \
+		const std::string gap_str = cmp;          \
+		rapidstring flat;                         \
+		rs_init(&flat);                           \
+		rs_gap_materialize(g, &flat);             \
+		REQUIRE(rs_gap_len(g) == gap_str.size()); \
+		VALIDATE_RS(&flat, gap_str);              \
+		rs_free(&flat);                           \
+	} while (0)
+
+TEST_CASE("gap construction")
+{
+	const std::string first{ "Hakuna Matata" };
+	const std::string second{ "It means no worries for the rest of your "
+				  "days." };
+
+	rs_gap g1;
+	rs_gap_init(&g1);
+	VALIDATE_GAP(&g1, std::string{});
+	REQUIRE(rs_gap_cursor(&g1) == 0);
+
+	rs_gap g2;
+	rs_gap_init_w(&g2, first.data());
+	VALIDATE_GAP(&g2, first);
+	REQUIRE(rs_gap_cursor(&g2) == first.size());
+
+	rapidstring s;
+	rs_init_w(&s, second.data());
+
+	rs_gap g3;
+	rs_gap_init_w_rs(&g3, &s);
+	VALIDATE_GAP(&g3, second);
+
+	for (std::size_t i = 0; i < second.size(); i++)
+		REQUIRE(rs_gap_at(&g3, i) == second[i]);
+
+	rs_free(&s);
+	rs_gap_free(&g1);
+	rs_gap_free(&g2);
+	rs_gap_free(&g3);
+}
+
+TEST_CASE("gap cursor editing")
+{
+	rs_gap g;
+	rs_gap_init_w(&g, "Remember who you are.");
+
+	rs_gap_move(&g, 9);
+	REQUIRE(rs_gap_cursor(&g) == 9);
+	rs_gap_erase_after(&g, 3);
+	rs_gap_insert(&g, "what");
+	VALIDATE_GAP(&g, std::string{ "Remember what you are." });
+	REQUIRE(rs_gap_at(&g, 12) == 't');
+	REQUIRE(rs_gap_at(&g, 13) == ' ');
+
+	rs_gap_move(&g, rs_gap_len(&g) - 1);
+	rs_gap_erase_before(&g, 3);
+	rs_gap_insert_n(&g, "were", 4);
+	VALIDATE_GAP(&g, std::string{ "Remember what you were." });
+
+	rs_gap_move(&g, 0);
+	rs_gap_insert(&g, "Simba, ");
+	VALIDATE_GAP(&g, std::string{ "Simba, Remember what you were." });
+	REQUIRE(rs_gap_cursor(&g) == 7);
+
+	rs_gap_erase_after(&g, 1);
+	rs_gap_insert(&g, "r");
+	rs_gap_move(&g, rs_gap_len(&g));
+	rs_gap_insert_n(&g, "", 0);
+	VALIDATE_GAP(&g, std::string{ "Simba, remember what you were." });
+
+	rs_gap_free(&g);
+}
+
+TEST_CASE("gap random editing")
+{
+	const std::string first{ "Oh yes, the past can hurt. " };
+
+	rs_gap g;
+	rs_gap_init(&g);
+
+	std::string cmp;
+	std::size_t cursor = 0;
+
+	std::srand(1);
+
+	for (int i = 0; i < 2000; i++) {
+		const auto op = std::rand() % 4;
+		const auto n = static_cast<std::size_t>(std::rand()) %
+			       (first.size() + 1);
+
+		if (op == 0) {
+			cursor = static_cast<std::size_t>(std::rand()) %
+				 (cmp.size() + 1);
+			rs_gap_move(&g, cursor);
+		} else if (op == 1) {
+			const auto k = n < cursor ? n : cursor;
+
+			rs_gap_erase_before(&g, k);
+			cmp.erase(cursor - k, k);
+			cursor -= k;
+		} else if (op == 2) {
+			const auto k = n < cmp.size() - cursor ? n
+							      : cmp.size() - cursor;
+
+			rs_gap_erase_after(&g, k);
+			cmp.erase(cursor, k);
+		} else {
+			rs_gap_insert_n(&g, first.data(), n);
+			cmp.insert(cursor, first.data(), n);
+			cursor += n;
+		}
+
+		REQUIRE(rs_gap_cursor(&g) == cursor);
+	}
+
+	VALIDATE_GAP(&g, cmp);
+
+	rs_gap_free(&g);
+}
@@ -0,0 +1,87 @@
+#include "utility.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <set>
+
+/* Theme: Back to the Future. */
+
+TEST_CASE("hash stack and heap")
+{
+	const std::string first{ "Great Scott!" };
+
+	rapidstring s1{};
+	rapidstring s2;
+	rs_init_w(&s1, first.data());
+	rs_init_w_cap(&s2, 100);
+	rs_cpy(&s2, first.data());
+
+	REQUIRE(rs_is_stack(&s1));
+	REQUIRE(rs_is_heap(&s2));
+	REQUIRE(rs_hash(&s1) == rs_hash(&s2));
+	REQUIRE(rs_hash(&s1) == rs_hash_n(first.data(), first.size()));
+	REQUIRE(rs_hash_seed(&s1, 88) == rs_hash_seed(&s2, 88));
+	REQUIRE(rs_hash_seed(&s1, 88) != rs_hash(&s1));
+
+	rs_free(&s1);
+	rs_free(&s2);
+}
+
+TEST_CASE("hash stack with garbage")
+{
+	const std::string first{ "Roads?" };
+
+	rapidstring s;
+	rs_init_w(&s, "Roads? Where we're going");
+
+	/* Characters past the null terminator must not be hashed. */
+	rs_resize(&s, first.size());
+
+	REQUIRE(rs_hash(&s) == rs_hash_n(first.data(), first.size()));
+
+	rs_free(&s);
+}
+
+TEST_CASE("hash lengths")
+{
+	const std::string first{ "If you put your mind to it, you can "
+				 "accomplish anything. " };
+	std::string second;
+	std::set<std::uint64_t> hashes;
+
+	while (second.size() < 3000)
+		second += first;
+
+	for (std::size_t i = 0; i <= second.size(); i++) {
+		rapidstring s;
+		rs_init_w_n(&s, second.data(), i);
+
+		const auto hash = rs_hash_n(second.data(), i);
+
+		REQUIRE(rs_hash(&s) == hash);
+		REQUIRE(rs_hash_seed(&s, 1985) ==
+			rs_hash_seed_n(second.data(), i, 1985));
+		REQUIRE(hashes.insert(hash).second);
+
+		rs_free(&s);
+	}
+}
+
+TEST_CASE("hash values")
+{
+	const std::string first{ "1.21 gigawatts!" };
+	std::string second;
+
+	while (second.size() < 1500)
+		second += first;
+
+	/* The hash must not depend on whether vectors are used. */
+	REQUIRE(rs_hash_n("", 0) == UINT64_C(0x66BE235091205228));
+	REQUIRE(rs_hash_n(first.data(), first.size()) ==
+		UINT64_C(0xE4153595FB5800BD));
+	REQUIRE(rs_hash_seed_n(first.data(), first.size(), 1955) ==
+		UINT64_C(0xDCFE447915ABC838));
+	REQUIRE(rs_hash_n(second.data(), second.size()) ==
+		UINT64_C(0x3A6BD0876257D690));
+	REQUIRE(rs_hash_seed_n(second.data(), 100, 2015) ==
+		UINT64_C(0x26F5C88E321013B5));
+}
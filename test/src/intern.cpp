@@ -0,0 +1,94 @@
+#include "utility.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/* Theme: Jurassic Park. */
+
+TEST_CASE("intern")
+{
+	const std::string first{ "Life, uh, finds a way." };
+	const std::string second{ "Clever girl." };
+
+	rs_intern_table t;
+	rs_intern_init(&t);
+
+	rapidstring s;
+	rs_init_w(&s, first.data());
+
+	const auto a = rs_intern(&t, first.data());
+	const auto b = rs_intern(&t, second.data());
+
+	REQUIRE(a != b);
+	REQUIRE(rs_intern_size(&t) == 2);
+	REQUIRE(rs_intern_rs(&t, &s) == a);
+	REQUIRE(rs_intern_n(&t, second.data(), second.size()) == b);
+	REQUIRE(rs_intern_size(&t) == 2);
+	REQUIRE(rs_intern_data(&t, a) == first);
+	REQUIRE(rs_intern_len(&t, a) == first.size());
+	REQUIRE(rs_intern_data(&t, b) == second);
+	REQUIRE(rs_intern_find_n(&t, "Clever", 6) == RS_INTERN_NONE);
+	REQUIRE(rs_intern_find_n(&t, second.data(), second.size()) == b);
+
+	rs_free(&s);
+	rs_intern_free(&t);
+}
+
+TEST_CASE("intern empty")
+{
+	rs_intern_table t;
+	rs_intern_init(&t);
+
+	REQUIRE(rs_intern_find_n(&t, "", 0) == RS_INTERN_NONE);
+
+	const auto a = rs_intern(&t, "");
+
+	REQUIRE(rs_intern_n(&t, "Hold onto your butts.", 0) == a);
+	REQUIRE(rs_intern_len(&t, a) == 0);
+	REQUIRE(*rs_intern_data(&t, a) == '\0');
+
+	rs_intern_free(&t);
+}
+
+TEST_CASE("intern many")
+{
+	const std::string first{ "Welcome to Jurassic Park. " };
+
+	rs_intern_table t;
+	rs_intern_init(&t);
+
+	std::vector<std::string> strings;
+	std::vector<const char *> buffers;
+
+	for (std::size_t i = 0; i < 5000; i++) {
+		std::string str = std::to_string(i);
+
+		/* Include strings larger than a chunk. */
+		if (i % 1000 == 0)
+			while (str.size() < RS_INTERN_CHUNK)
+				str += first;
+
+		const auto id = rs_intern_n(&t, str.data(), str.size());
+
+		REQUIRE(id == i);
+		strings.push_back(str);
+		buffers.push_back(rs_intern_data(&t, id));
+	}
+
+	REQUIRE(rs_intern_size(&t) == strings.size());
+
+	for (std::uint32_t i = 0; i < strings.size(); i++) {
+		const auto &str = strings[i];
+
+		/* Buffers must not move while the table grows. */
+		REQUIRE(rs_intern_data(&t, i) == buffers[i]);
+		REQUIRE(rs_intern_data(&t, i) == str);
+		REQUIRE(std::strlen(rs_intern_data(&t, i)) == str.size());
+		REQUIRE(rs_intern_n(&t, str.data(), str.size()) == i);
+	}
+
+	REQUIRE(rs_intern_size(&t) == strings.size());
+
+	rs_intern_free(&t);
+}
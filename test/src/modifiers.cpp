@@ -56,6 +56,86 @@ TEST_CASE("resize stack to heap")
 	rs_free(&s);
 }
 
+TEST_CASE("resize stack full")
+{
+	std::string first{ "Hodor" };
+
+	rapidstring s;
+	rs_init_w(&s, first.data());
+
+	rs_resize_w(&s, RS_STACK_CAPACITY, 'a');
+	first.resize(RS_STACK_CAPACITY, 'a');
+
+	REQUIRE(rs_is_stack(&s));
+	REQUIRE(rs_data_c(&s)[RS_STACK_CAPACITY] == '\0');
+	VALIDATE_RS(&s, first);
+
+	rs_free(&s);
+}
+
+TEST_CASE("resize heap shrink and grow")
+{
+	std::string first{
+		"The night is dark and full of terrors, but the fire burns "
+		"them all away."
+	};
+
+	rapidstring s;
+	rs_init_w(&s, first.data());
+
+	rs_resize(&s, 9);
+	first.resize(9);
+
+	REQUIRE(rs_is_heap(&s));
+	VALIDATE_RS(&s, first);
+
+	rs_resize_w(&s, 300, 'b');
+	first.resize(300, 'b');
+
+	REQUIRE(rs_cap(&s) >= 300);
+	VALIDATE_RS(&s, first);
+
+	rs_free(&s);
+}
+
+TEST_CASE("resize stack every length")
+{
+	std::string first;
+
+	rapidstring s;
+	rs_init(&s);
+
+	for (std::size_t i = 0; i <= RS_STACK_CAPACITY; i++) {
+		rs_resize_w(&s, i, 'x');
+		first.resize(i, 'x');
+
+		REQUIRE(rs_is_stack(&s));
+		REQUIRE(rs_len(&s) == i);
+		VALIDATE_RS(&s, first);
+	}
+
+	rs_free(&s);
+}
+
+TEST_CASE("resize full stack to heap")
+{
+	std::string first(RS_STACK_CAPACITY, 'w');
+	const std::string second{ " is coming" };
+
+	rapidstring s;
+	rs_init_w_n(&s, first.data(), first.size());
+
+	REQUIRE(rs_is_stack(&s));
+
+	rs_cat_n(&s, second.data(), second.size());
+	first += second;
+
+	REQUIRE(rs_is_heap(&s));
+	VALIDATE_RS(&s, first);
+
+	rs_free(&s);
+}
+
 TEST_CASE("steal")
 {
 	constexpr std::size_t size{ 100 };
@@ -117,6 +197,240 @@ TEST_CASE("erase")
 		rs_heap_erase);
 }
 
+static std::size_t replace_all(std::string &str, const std::string &needle,
+			       const std::string &replacement)
+{
+	std::size_t count = 0;
+	std::size_t pos = 0;
+
+	while ((pos = str.find(needle, pos)) != std::string::npos) {
+		str.replace(pos, needle.size(), replacement);
+		pos += replacement.size();
+		count++;
+	}
+
+	return count;
+}
+
+static void test_replace_all(const std::string &first,
+			     const std::string &needle,
+			     const std::string &replacement)
+{
+	std::string cmp{ first };
+	const std::size_t count = replace_all(cmp, needle, replacement);
+
+	rapidstring s;
+	rs_init_w_n(&s, first.data(), first.size());
+
+	REQUIRE(rs_replace_all_n(&s, needle.data(), needle.size(),
+				 replacement.data(),
+				 replacement.size()) == count);
+	VALIDATE_RS(&s, cmp);
+
+	rs_free(&s);
+}
+
+TEST_CASE("replace all")
+{
+	const std::string first{ "The night is dark and full of terrors." };
+	const std::string second{ "A Lannister always pays his debts." };
+
+	test_replace_all(first, "dark", "dim");
+	test_replace_all(first, "dark", "dreadfully dark");
+	test_replace_all(first, " ", "");
+	test_replace_all(first, "o", "00");
+	test_replace_all(first, "winter", "summer");
+	test_replace_all(second, "a", "4");
+	test_replace_all(second, "s", "$$");
+	test_replace_all(second, second, "");
+	test_replace_all("aaaaa", "aa", "b");
+	test_replace_all("aaaaa", "aa", "bbb");
+	test_replace_all("", "x", "y");
+
+	std::string large;
+
+	for (int i = 0; i < 50; i++)
+		large += first;
+
+	test_replace_all(large, "terrors", "{terrors}");
+	test_replace_all(large, "of", "");
+}
+
+TEST_CASE("replace all in place")
+{
+	const std::string first{ "Chaos isn't a pit. Chaos is a ladder." };
+
+	rapidstring s;
+	rs_init_w(&s, first.data());
+
+	const char *const buffer{ rs_data(&s) };
+
+	REQUIRE(rs_replace_all(&s, "Chaos", "War") == 2);
+	VALIDATE_RS(&s, std::string{ "War isn't a pit. War is a ladder." });
+	REQUIRE(rs_data(&s) == buffer);
+
+	REQUIRE(rs_replace_all(&s, "a", "") == 5);
+	VALIDATE_RS(&s, std::string{ "Wr isn't  pit. Wr is  ldder." });
+	REQUIRE(rs_data(&s) == buffer);
+
+	rs_free(&s);
+}
+
+TEST_CASE("replace all shared")
+{
+	const std::string first{ "When you play the game of thrones, you win "
+				 "or you die." };
+
+	rapidstring s1;
+	rs_init_w(&s1, first.data());
+	rs_freeze(&s1);
+
+	rapidstring s2;
+	rs_init_w_rs(&s2, &s1);
+
+	REQUIRE(rs_replace_all_v(&s2, rs_view_n("you", 3),
+				 rs_view_n("we", 2)) == 3);
+
+	VALIDATE_RS(&s1, first);
+	VALIDATE_RS(&s2, std::string{ "When we play the game of thrones, we "
+				      "win or we die." });
+	REQUIRE(rs_shared_refs(&s1) == 1);
+
+	rs_free(&s1);
+	rs_free(&s2);
+}
+
+static void test_replace_range(const std::string &first, std::size_t index,
+			       std::size_t n, const std::string &input)
+{
+	std::string cmp{ first };
+	cmp.replace(index, n, input);
+
+	rapidstring s;
+	rs_init_w_n(&s, first.data(), first.size());
+
+	rs_replace_range_n(&s, index, n, input.data(), input.size());
+	VALIDATE_RS(&s, cmp);
+
+	rs_free(&s);
+}
+
+TEST_CASE("replace range")
+{
+	const std::string first{ "Hold the door." };
+	const std::string second{ "The man who passes the sentence should "
+				  "swing the sword." };
+
+	test_replace_range(first, 5, 3, "the gate");
+	test_replace_range(first, 5, 4, "");
+	test_replace_range(first, 0, first.size(), "Hodor");
+	test_replace_range(first, first.size(), 0, " Hodor.");
+	test_replace_range(first, 0, 0, second);
+	test_replace_range(first, 9, 4, second);
+	test_replace_range(second, 4, 3, "woman");
+	test_replace_range(second, 0, 4, "");
+	test_replace_range(second, 20, 10, first);
+	test_replace_range("", 0, 0, "");
+	test_replace_range("", 0, 0, second);
+}
+
+TEST_CASE("insert")
+{
+	std::string cmp{ "You know nothing." };
+
+	rapidstring s;
+	rs_init_w(&s, cmp.data());
+
+	rs_insert(&s, 8, " whatsoever, absolutely");
+	cmp.insert(8, " whatsoever, absolutely");
+	VALIDATE_RS(&s, cmp);
+	REQUIRE(rs_is_heap(&s));
+
+	const char *const buffer{ rs_data(&s) };
+
+	rs_insert_n(&s, 0, "Jon Snow, ", 10);
+	cmp.insert(0, "Jon Snow, ");
+	VALIDATE_RS(&s, cmp);
+	REQUIRE(rs_data(&s) == buffer);
+
+	rapidstring input;
+	rs_init_w(&input, " at all");
+
+	rs_insert_rs(&s, rs_len(&s) - 1, &input);
+	cmp.insert(cmp.size() - 1, " at all");
+	VALIDATE_RS(&s, cmp);
+
+	rs_insert_v(&s, 0, rs_view_n("Ygritte: ", 9));
+	cmp.insert(0, "Ygritte: ");
+	VALIDATE_RS(&s, cmp);
+
+	rs_replace_range_v(&s, 0, 7, rs_view_n("Her", 3));
+	cmp.replace(0, 7, "Her");
+	VALIDATE_RS(&s, cmp);
+
+	rs_replace_range(&s, 0, 3, "She");
+	cmp.replace(0, 3, "She");
+	VALIDATE_RS(&s, cmp);
+
+	rs_free(&input);
+	rs_free(&s);
+}
+
+TEST_CASE("replace range shared")
+{
+	const std::string first{ "The North remembers." };
+
+	rapidstring s1;
+	rs_init_w(&s1, first.data());
+	rs_reserve(&s1, 64);
+	rs_freeze(&s1);
+
+	rapidstring s2;
+	rs_init_w_rs(&s2, &s1);
+
+	rs_replace_range(&s2, 4, 5, "Wall");
+
+	VALIDATE_RS(&s1, first);
+	VALIDATE_RS(&s2, std::string{ "The Wall remembers." });
+	REQUIRE(rs_shared_refs(&s1) == 1);
+	REQUIRE(!rs_is_shared(&s2));
+
+	rs_free(&s1);
+	rs_free(&s2);
+}
+
+TEST_CASE("replace range at end")
+{
+	const std::string first{ "Hold the door" };
+	const std::string second{ "gate, hold the gate, hold the gate!" };
+	const std::string third{ "Hold the gate, hold the gate, hold the "
+				 "gate!" };
+
+	rapidstring s;
+	rs_init_w(&s, first.data());
+
+	/* The stack string overflows and nothing follows the range. */
+	rs_replace_range_n(&s, 9, 4, second.data(), second.size());
+
+	VALIDATE_RS(&s, third);
+
+	rapidstring shared;
+	rs_init_w_rs(&shared, &s);
+	rs_freeze(&shared);
+
+	rapidstring copy;
+	rs_init_w_rs(&copy, &shared);
+
+	rs_replace_range_n(&copy, 9, third.size() - 9, "door", 4);
+
+	VALIDATE_RS(&copy, first);
+	VALIDATE_RS(&shared, third);
+
+	rs_free(&copy);
+	rs_free(&shared);
+	rs_free(&s);
+}
+
 TEST_CASE("clear")
 {
 	const std::string first{ "GOT" };
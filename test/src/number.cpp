@@ -0,0 +1,373 @@
+#include "utility.hpp"
+#include <clocale>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+
+/* Theme: The Matrix. */
+
+static std::string format_double(double n)
+{
+	rapidstring s;
+	rs_init(&s);
+
+	rs_cat_double(&s, n);
+
+	const std::string result{ rs_data(&s), rs_len(&s) };
+	rs_free(&s);
+
+	return result;
+}
+
+TEST_CASE("Unsigned integer formatting")
+{
+	const std::uint64_t values[]{
+		0,    1,    9,     10,    99,      100,
+		999,  1000, 9999,  10000, 10101,   1999999,
+		4294967296,
+		std::numeric_limits<std::uint64_t>::max()
+	};
+
+	for (const auto n : values) {
+		rapidstring s;
+		rs_init(&s);
+
+		rs_cat_u64(&s, n);
+
+		VALIDATE_RS(&s, std::to_string(n));
+
+		rs_free(&s);
+	}
+}
+
+TEST_CASE("Signed integer formatting")
+{
+	const std::int64_t values[]{ 0,
+				     -1,
+				     42,
+				     -1999,
+				     std::numeric_limits<std::int64_t>::max(),
+				     std::numeric_limits<std::int64_t>::min() };
+
+	for (const auto n : values) {
+		rapidstring s;
+		rs_init(&s);
+
+		rs_cat_i64(&s, n);
+
+		VALIDATE_RS(&s, std::to_string(n));
+
+		rs_free(&s);
+	}
+}
+
+TEST_CASE("Random integer formatting")
+{
+	std::mt19937_64 gen{ 1999 };
+	std::string expected{ "There is no spoon: " };
+
+	rapidstring s;
+	rs_init_w(&s, expected.data());
+
+	for (int i = 0; i < 1000; i++) {
+		/* Shifted to cover every number of digits. */
+		const auto n = gen() >> (i % 64);
+		const auto m = static_cast<std::int64_t>(gen()) >> (i % 64);
+
+		rs_cat_u64(&s, n);
+		rs_cat_i64(&s, m);
+		expected += std::to_string(n) + std::to_string(m);
+	}
+
+	VALIDATE_RS(&s, expected);
+
+	rs_free(&s);
+}
+
+TEST_CASE("Hexadecimal formatting")
+{
+	const std::string first{ "Wake up, Neo" };
+
+	rapidstring s{};
+	rs_init_w(&s, first.data());
+
+	rs_cat_hex(&s, 0);
+	rs_cat_hex(&s, 0xC0FFEE);
+	rs_cat_hex_upper(&s, 0xDEADBEEF);
+	rs_cat_hex(&s, std::numeric_limits<std::uint64_t>::max());
+
+	VALIDATE_RS(&s, first + "0c0ffeeDEADBEEFffffffffffffffff");
+
+	rs_free(&s);
+}
+
+TEST_CASE("Double formatting")
+{
+	REQUIRE(format_double(0.0) == "0");
+	REQUIRE(format_double(-0.0) == "-0");
+	REQUIRE(format_double(1.0) == "1");
+	REQUIRE(format_double(-2.5) == "-2.5");
+	REQUIRE(format_double(0.1) == "0.1");
+	REQUIRE(format_double(0.3) == "0.3");
+	REQUIRE(format_double(123.456) == "123.456");
+	REQUIRE(format_double(1999.0) == "1999");
+	REQUIRE(format_double(1e20) == "100000000000000000000");
+	REQUIRE(format_double(1e21) == "1e+21");
+	REQUIRE(format_double(0.000001) == "0.000001");
+	REQUIRE(format_double(0.0000012) == "0.0000012");
+	REQUIRE(format_double(1e-7) == "1e-7");
+	REQUIRE(format_double(-1.5e-7) == "-1.5e-7");
+	REQUIRE(format_double(1.5e300) == "1.5e+300");
+	REQUIRE(format_double(5e-324) == "5e-324");
+	REQUIRE(format_double(std::numeric_limits<double>::max()) ==
+		"1.7976931348623157e+308");
+	REQUIRE(format_double(std::numeric_limits<double>::min()) ==
+		"2.2250738585072014e-308");
+	REQUIRE(format_double(std::numeric_limits<double>::infinity()) ==
+		"inf");
+	REQUIRE(format_double(-std::numeric_limits<double>::infinity()) ==
+		"-inf");
+	REQUIRE(format_double(std::numeric_limits<double>::quiet_NaN()) ==
+		"nan");
+}
+
+TEST_CASE("Double round trip")
+{
+	std::mt19937_64 gen{ 1999 };
+
+	for (int i = 0; i < 100000; i++) {
+		std::uint64_t bits = gen();
+		double n;
+
+		/* Half of the values are drawn with a bounded exponent. */
+		if (i % 2 == 0)
+			bits = (bits & 0x800FFFFFFFFFFFFF) |
+			       ((0x3FF - 40 + (bits >> 52) % 80) << 52);
+
+		std::memcpy(&n, &bits, sizeof(n));
+
+		if (n != n || n == n + n)
+			continue;
+
+		const auto str = format_double(n);
+
+		REQUIRE(str.size() <= RS_DTOA_MAX);
+		REQUIRE(std::strtod(str.data(), nullptr) == n);
+	}
+}
+
+TEST_CASE("Heap number formatting")
+{
+	const std::string first{ "What is real? How do you define real?" };
+
+	rapidstring s;
+	rs_init_w(&s, first.data());
+
+	rs_cat_double(&s, 0.5);
+	rs_cat_i64(&s, -101);
+
+	VALIDATE_RS(&s, first + "0.5-101");
+
+	rs_free(&s);
+}
+
+TEST_CASE("Unsigned integer parsing")
+{
+	std::uint64_t n{ 7 };
+
+	REQUIRE(rs_to_u64_n("0", 1, &n) == 1);
+	REQUIRE(n == 0);
+	REQUIRE(rs_to_u64_n("1999 followers", 14, &n) == 4);
+	REQUIRE(n == 1999);
+	REQUIRE(rs_to_u64_n("12345678901234567", 17, &n) == 17);
+	REQUIRE(n == 12345678901234567);
+	REQUIRE(rs_to_u64_n("000000000000000000000042", 24, &n) == 24);
+	REQUIRE(n == 42);
+	REQUIRE(rs_to_u64_n("18446744073709551615", 20, &n) == 20);
+	REQUIRE(n == std::numeric_limits<std::uint64_t>::max());
+
+	/* The length is respected even without a null terminator. */
+	REQUIRE(rs_to_u64_n("12345678901234567", 9, &n) == 9);
+	REQUIRE(n == 123456789);
+
+	n = 7;
+
+	REQUIRE(rs_to_u64_n("18446744073709551616", 20, &n) == 0);
+	REQUIRE(rs_to_u64_n("100000000000000000000", 21, &n) == 0);
+	REQUIRE(rs_to_u64_n("-1", 2, &n) == 0);
+	REQUIRE(rs_to_u64_n("Neo", 3, &n) == 0);
+	REQUIRE(rs_to_u64_n("", 0, &n) == 0);
+	REQUIRE(n == 7);
+}
+
+TEST_CASE("Signed integer parsing")
+{
+	std::int64_t n{ 7 };
+
+	REQUIRE(rs_to_i64_n("-101", 4, &n) == 4);
+	REQUIRE(n == -101);
+	REQUIRE(rs_to_i64_n("+101", 4, &n) == 4);
+	REQUIRE(n == 101);
+	REQUIRE(rs_to_i64_n("-0", 2, &n) == 2);
+	REQUIRE(n == 0);
+	REQUIRE(rs_to_i64_n("9223372036854775807", 19, &n) == 19);
+	REQUIRE(n == std::numeric_limits<std::int64_t>::max());
+	REQUIRE(rs_to_i64_n("-9223372036854775808", 20, &n) == 20);
+	REQUIRE(n == std::numeric_limits<std::int64_t>::min());
+
+	n = 7;
+
+	REQUIRE(rs_to_i64_n("9223372036854775808", 19, &n) == 0);
+	REQUIRE(rs_to_i64_n("-9223372036854775809", 20, &n) == 0);
+	REQUIRE(rs_to_i64_n("-", 1, &n) == 0);
+	REQUIRE(rs_to_i64_n("--1", 3, &n) == 0);
+	REQUIRE(n == 7);
+}
+
+TEST_CASE("Random integer parsing")
+{
+	std::mt19937_64 gen{ 1999 };
+
+	for (int i = 0; i < 10000; i++) {
+		const auto u = gen() >> (i % 64);
+		const auto s = static_cast<std::int64_t>(gen()) >> (i % 64);
+		const auto u_str = std::to_string(u);
+		const auto s_str = std::to_string(s);
+		std::uint64_t u_out;
+		std::int64_t s_out;
+
+		REQUIRE(rs_to_u64_n(u_str.data(), u_str.size(), &u_out) ==
+			u_str.size());
+		REQUIRE(u_out == u);
+		REQUIRE(rs_to_i64_n(s_str.data(), s_str.size(), &s_out) ==
+			s_str.size());
+		REQUIRE(s_out == s);
+	}
+}
+
+TEST_CASE("Double parsing")
+{
+	double n{ 7 };
+
+	REQUIRE(rs_to_double_n("0", 1, &n) == 1);
+	REQUIRE(n == 0);
+	REQUIRE(rs_to_double_n("-0.0", 4, &n) == 4);
+	REQUIRE((n == 0 && std::signbit(n)));
+	REQUIRE(rs_to_double_n("0.1", 3, &n) == 3);
+	REQUIRE(n == 0.1);
+	REQUIRE(rs_to_double_n(".5", 2, &n) == 2);
+	REQUIRE(n == 0.5);
+	REQUIRE(rs_to_double_n("5.", 2, &n) == 2);
+	REQUIRE(n == 5);
+	REQUIRE(rs_to_double_n("-123.456e2,", 11, &n) == 10);
+	REQUIRE(n == -12345.6);
+	REQUIRE(rs_to_double_n("1E-7", 4, &n) == 4);
+	REQUIRE(n == 1e-7);
+	REQUIRE(rs_to_double_n("2e", 2, &n) == 1);
+	REQUIRE(n == 2);
+	REQUIRE(rs_to_double_n("3e+x", 4, &n) == 1);
+	REQUIRE(n == 3);
+	REQUIRE(rs_to_double_n("0.000000000000000000000000001", 29, &n) ==
+		29);
+	REQUIRE(n == 1e-27);
+	REQUIRE(rs_to_double_n("1.7976931348623157e+308", 23, &n) == 23);
+	REQUIRE(n == std::numeric_limits<double>::max());
+	REQUIRE(rs_to_double_n("5e-324", 6, &n) == 6);
+	REQUIRE(n == std::numeric_limits<double>::denorm_min());
+	REQUIRE(rs_to_double_n("1e400", 5, &n) == 5);
+	REQUIRE(n == std::numeric_limits<double>::infinity());
+	REQUIRE(rs_to_double_n("-inf", 4, &n) == 4);
+	REQUIRE(n == -std::numeric_limits<double>::infinity());
+	REQUIRE(rs_to_double_n("nan", 3, &n) == 3);
+	REQUIRE(n != n);
+	REQUIRE(rs_to_double_n("3.14159265358979323846264338327950288", 37,
+			       &n) == 37);
+	REQUIRE(n == 3.14159265358979323846264338327950288);
+
+	/* The length is respected even without a null terminator. */
+	REQUIRE(rs_to_double_n("1.25", 3, &n) == 3);
+	REQUIRE(n == 1.2);
+
+	n = 7;
+
+	REQUIRE(rs_to_double_n("", 0, &n) == 0);
+	REQUIRE(rs_to_double_n(".", 1, &n) == 0);
+	REQUIRE(rs_to_double_n("-.e1", 4, &n) == 0);
+	REQUIRE(rs_to_double_n("e1", 2, &n) == 0);
+	REQUIRE(rs_to_double_n("Trinity", 7, &n) == 0);
+	REQUIRE(n == 7);
+}
+
+TEST_CASE("Double parsing locale")
+{
+	/* Locales whose decimal point is a comma, or several bytes long. */
+	const char *const locales[]{ "C", "de_DE.UTF-8", "fr_FR.UTF-8",
+				     "ps_AF.UTF-8" };
+
+	for (const char *locale : locales) {
+		if (std::setlocale(LC_NUMERIC, locale) == nullptr)
+			continue;
+
+		double n{ 0 };
+
+		REQUIRE(rs_to_double_n("3.14159265358979323846264338327950288",
+				       37, &n) == 37);
+		REQUIRE(n == 3.14159265358979323846264338327950288);
+		REQUIRE(rs_to_double_n("-2.5e-310", 9, &n) == 9);
+		REQUIRE(n == -2.5e-310);
+	}
+
+	std::setlocale(LC_NUMERIC, "C");
+}
+
+TEST_CASE("Double parsing round trip")
+{
+	std::mt19937_64 gen{ 1999 };
+
+	for (int i = 0; i < 100000; i++) {
+		std::uint64_t bits = gen();
+		double n;
+		double out;
+
+		/* Half of the values are drawn with a bounded exponent. */
+		if (i % 2 == 0)
+			bits = (bits & 0x800FFFFFFFFFFFFF) |
+			       ((0x3FF - 40 + (bits >> 52) % 80) << 52);
+
+		std::memcpy(&n, &bits, sizeof(n));
+
+		if (n != n)
+			continue;
+
+		const auto str = format_double(n);
+
+		REQUIRE(rs_to_double_n(str.data(), str.size(), &out) ==
+			str.size());
+		REQUIRE(std::memcmp(&out, &n, sizeof(n)) == 0);
+	}
+}
+
+TEST_CASE("String number parsing")
+{
+	const std::string first{ "-273.15" };
+
+	rapidstring s;
+	rs_init_w(&s, first.data());
+
+	double d;
+	std::int64_t i;
+	std::uint64_t u;
+
+	REQUIRE(rs_to_double(&s, &d) == first.size());
+	REQUIRE(d == -273.15);
+	REQUIRE(rs_to_i64(&s, &i) == 4);
+	REQUIRE(i == -273);
+	REQUIRE(rs_to_u64(&s, &u) == 0);
+	REQUIRE(rs_to_u64_v(rs_substr_view(&s, 1, 3), &u) == 3);
+	REQUIRE(u == 273);
+
+	rs_free(&s);
+}
@@ -0,0 +1,134 @@
+#define RS_PARALLEL
+#include "utility.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/* Theme: The Office. */
+
+static void test_parallel_sort(const std::vector<std::string> &input,
+			       unsigned int threads)
+{
+	std::vector<std::string> cmp{ input };
+	std::sort(cmp.begin(), cmp.end());
+
+	std::vector<rapidstring> strings(input.size());
+
+	for (std::size_t i = 0; i < input.size(); i++)
+		rs_init_w_n(&strings[i], input[i].data(), input[i].size());
+
+	rs_parallel_sort(strings.data(), strings.size(), threads);
+
+	/* VALIDATE_RS() stops at the null characters of some strings. */
+	for (std::size_t i = 0; i < input.size(); i++) {
+		const std::string str(rs_data_c(&strings[i]),
+				      rs_len(&strings[i]));
+
+		REQUIRE(str == cmp[i]);
+		rs_free(&strings[i]);
+	}
+}
+
+static std::string random_string(const std::string &prefix, std::size_t len,
+				 int chars)
+{
+	std::string s{ prefix };
+
+	for (std::size_t i = 0; i < len; i++)
+		s += static_cast<char>('a' + std::rand() % chars);
+
+	return s;
+}
+
+TEST_CASE("parallel sort small")
+{
+	const std::vector<std::string> input{ "That's what she said.",
+					      "Bears. Beets. Battlestar "
+					      "Galactica.",
+					      "", "I declare bankruptcy!" };
+
+	test_parallel_sort({}, 4);
+	test_parallel_sort(input, 4);
+	test_parallel_sort(input, 0);
+}
+
+TEST_CASE("parallel sort random")
+{
+	std::vector<std::string> input;
+
+	std::srand(1);
+
+	for (std::size_t i = 0; i < RS_PARALLEL_MIN * 2; i++)
+		input.push_back(random_string("", std::rand() % 40, 26));
+
+	test_parallel_sort(input, 1);
+	test_parallel_sort(input, 2);
+	test_parallel_sort(input, 7);
+}
+
+TEST_CASE("parallel sort skewed")
+{
+	std::vector<std::string> input;
+
+	std::srand(2);
+
+	/* Nearly every key shares a prefix longer than the sort keys. */
+	for (std::size_t i = 0; i < RS_PARALLEL_MIN * 2; i++) {
+		if (i % 50 == 0)
+			input.push_back(random_string("", 10, 26));
+		else
+			input.push_back(random_string("Dunder Mifflin, ",
+						      std::rand() % 20, 4));
+	}
+
+	test_parallel_sort(input, 4);
+}
+
+TEST_CASE("parallel sort duplicates")
+{
+	std::vector<std::string> input;
+
+	std::srand(3);
+
+	/* Few distinct strings, some with null characters. */
+	for (std::size_t i = 0; i < RS_PARALLEL_MIN + 123; i++) {
+		std::string s{ random_string("Scranton", std::rand() % 3, 3) };
+
+		if (i % 3 == 0)
+			s += std::string("\0Stamford", 9);
+
+		input.push_back(s);
+	}
+
+	test_parallel_sort(input, 3);
+	test_parallel_sort(std::vector<std::string>(RS_PARALLEL_MIN,
+						    "Michael Scott Paper "
+						    "Company"),
+			   5);
+}
+
+TEST_CASE("parallel sort patterns")
+{
+	const std::size_t n = RS_PARALLEL_MIN * 2;
+	std::vector<std::string> sorted;
+	std::vector<std::string> organ;
+
+	/* A single bucket is split by the thread that pops it. */
+	for (std::size_t i = 0; i < n; i++) {
+		const auto k = i < n / 2 ? i : n - i;
+
+		sorted.push_back("Dwight Schrute " + std::to_string(n + i));
+		organ.push_back("Dwight Schrute " + std::to_string(n + k));
+	}
+
+	test_parallel_sort(sorted, 4);
+	test_parallel_sort(organ, 4);
+
+	std::reverse(sorted.begin(), sorted.end());
+	test_parallel_sort(sorted, 4);
+
+	std::reverse(organ.begin(), organ.end());
+	test_parallel_sort(organ, 4);
+}
@@ -0,0 +1,132 @@
+#define RS_POOL
+#include "utility.hpp"
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+/* Theme: The Matrix. */
+
+TEST_CASE("pool recycling")
+{
+	rs_pool_flush();
+
+	void *p = RS_MALLOC(100);
+	RS_FREE(p);
+
+	REQUIRE(RS_MALLOC(90) == p);
+
+	RS_FREE(p);
+	rs_pool_flush();
+}
+
+TEST_CASE("pool reallocation")
+{
+	char *p = static_cast<char *>(RS_MALLOC(40));
+	p[0] = 'N';
+	p[39] = 'o';
+
+	REQUIRE(RS_REALLOC(p, 41) == p);
+
+	char *q = static_cast<char *>(RS_REALLOC(p, 1000));
+
+	REQUIRE(q[0] == 'N');
+	REQUIRE(q[39] == 'o');
+
+	q = static_cast<char *>(RS_REALLOC(q, std::size_t{ 1 } << 22));
+
+	REQUIRE(q[0] == 'N');
+	REQUIRE(q[39] == 'o');
+
+	RS_FREE(q);
+	rs_pool_flush();
+}
+
+TEST_CASE("pool size classes")
+{
+	constexpr std::size_t min{ std::size_t{ 1 } << RS_POOL_MIN_SHIFT };
+	constexpr std::size_t max{ std::size_t{ 1 } << RS_POOL_MAX_SHIFT };
+
+	REQUIRE(rs_pool_class(1) == 0);
+	REQUIRE(rs_pool_class(min + 1) == 0);
+	REQUIRE(rs_pool_class(min + 2) == 1);
+	REQUIRE(rs_pool_class(min * 2 + 1) == 1);
+	REQUIRE(rs_pool_class(min * 2 + 2) == 2);
+	REQUIRE(rs_pool_class(max + 1) == RS_POOL_CLASSES - 1);
+	REQUIRE(rs_pool_class(max + 2) == RS_POOL_CLASSES);
+
+	/* A power of two capacity and its terminator fill a class. */
+	void *p = RS_REALLOC(NULL, 256 + 1);
+	REQUIRE(RS_REALLOC(p, 256 + 1) == p);
+
+	RS_FREE(p);
+	rs_pool_flush();
+}
+
+TEST_CASE("pool strings")
+{
+	const std::string first{ "There is no spoon." };
+	const std::string second{ "Welcome to the desert of the real." };
+
+	rapidstring s;
+	rs_init_w(&s, first.data());
+
+	for (int i = 0; i < 100; i++)
+		rs_cat(&s, second.data());
+
+	std::string cmp{ first };
+
+	for (int i = 0; i < 100; i++)
+		cmp += second;
+
+	VALIDATE_RS(&s, cmp);
+
+	rs_free(&s);
+	rs_pool_flush();
+}
+
+TEST_CASE("pool cross thread free")
+{
+	const std::string first{ "Free your mind. You have to let it all go." };
+
+	rapidstring s;
+	rs_init_w(&s, first.data());
+
+	void *buffer = s.heap.buffer;
+
+	std::thread t{ [&s] { rs_free(&s); } };
+	t.join();
+
+	/* The buffer is handed back to this thread. */
+	rapidstring s2;
+	rs_init_w(&s2, first.data());
+
+	REQUIRE(s2.heap.buffer == buffer);
+	VALIDATE_RS(&s2, first);
+
+	rs_free(&s2);
+	rs_pool_flush();
+}
+
+TEST_CASE("pool depot limit")
+{
+	constexpr std::size_t count{ RS_POOL_DEPOT + 10 };
+	std::vector<void *> buffers;
+
+	rs_pool_flush();
+
+	for (std::size_t i = 0; i < count; i++)
+		buffers.push_back(RS_MALLOC(100));
+
+	std::thread t{ [&buffers] {
+		for (void *p : buffers)
+			RS_FREE(p);
+	} };
+	t.join();
+
+	/* Only the first buffers are handed back, the others are freed. */
+	REQUIRE(rs_pool_depot_count[rs_pool_class(100)] == RS_POOL_DEPOT);
+
+	rs_pool_flush();
+
+	REQUIRE(rs_pool_depot_count[rs_pool_class(100)] == 0);
+}
@@ -0,0 +1,185 @@
+#include "utility.hpp"
+#include <cstddef>
+#include <cstdlib>
+
+/* Theme: Pirates of the Caribbean. */
+
+static std::size_t validate_node(const rs_rope_node *t)
+{
+	if (t->height == 1) {
+		REQUIRE(t->len == rs_len(&t->u.leaf));
+		REQUIRE(t->len <= RS_ROPE_LEAF);
+
+		return 1;
+	}
+
+	const auto l = validate_node(t->u.node.left);
+	const auto r = validate_node(t->u.node.right);
+
+	/* Both subtrees must be balanced. */
+	REQUIRE((l > r ? l - r : r - l) <= 1);
+	REQUIRE(t->height == (l > r ? l : r) + 1);
+	REQUIRE(t->len == t->u.node.left->len + t->u.node.right->len);
+
+	return t->height;
+}
+
+#define VALIDATE_ROPE(r, cmp)                               \
+	do {                                                \
+		const std::string rope_str = cmp;           \
+		rapidstring flat;                           \
+		rs_init(&flat);                             \
+		rs_rope_flatten(r, &flat);                  \
+		REQUIRE(rs_rope_len(r) == rope_str.size()); \
+		VALIDATE_RS(&flat, rope_str);               \
+		if ((r)->root != NULL)                      \
+			validate_node((r)->root);           \
+		rs_free(&flat);                             \
+	} while (0)
+
+TEST_CASE("rope concatenation")
+{
+	const std::string first{ "Why is the rum always gone? " };
+
+	rs_rope r;
+	rs_rope_init(&r);
+
+	VALIDATE_ROPE(&r, std::string{});
+
+	std::string cmp;
+
+	for (int i = 0; i < 1000; i++) {
+		rs_rope_cat(&r, first.data());
+		cmp += first;
+	}
+
+	VALIDATE_ROPE(&r, cmp);
+	REQUIRE(rs_rope_at(&r, 29) == cmp[29]);
+
+	const std::string second(5000, 'x');
+
+	rapidstring s;
+	rs_init_w(&s, second.data());
+	rs_rope_cat_rs(&r, &s);
+	cmp += second;
+
+	VALIDATE_ROPE(&r, cmp);
+
+	rs_free(&s);
+	rs_rope_free(&r);
+}
+
+TEST_CASE("rope insertion and erasure")
+{
+	const std::string first{ "This is the day you will always remember as "
+				 "the day you almost caught Captain Jack "
+				 "Sparrow!" };
+
+	rs_rope r;
+	rs_rope_init(&r);
+
+	std::string cmp;
+	std::srand(1);
+
+	for (int i = 0; i < 2000; i++) {
+		const auto index = std::rand() % (cmp.size() + 1);
+		const auto n = static_cast<std::size_t>(std::rand()) %
+			       first.size();
+
+		if (std::rand() % 3 != 0 || cmp.empty()) {
+			rs_rope_insert_n(&r, index, first.data(), n);
+			cmp.insert(index, first, 0, n);
+		} else {
+			const auto erased = n < cmp.size() - index ?
+						    n :
+						    cmp.size() - index;
+
+			rs_rope_erase(&r, index, erased);
+			cmp.erase(index, erased);
+		}
+
+		REQUIRE(rs_rope_len(&r) == cmp.size());
+	}
+
+	VALIDATE_ROPE(&r, cmp);
+
+	for (std::size_t i = 0; i < cmp.size(); i += 97)
+		REQUIRE(rs_rope_at(&r, i) == cmp[i]);
+
+	rs_rope_free(&r);
+}
+
+static std::size_t count_leaves(const rs_rope_node *t)
+{
+	if (t->height == 1)
+		return 1;
+
+	return count_leaves(t->u.node.left) + count_leaves(t->u.node.right);
+}
+
+TEST_CASE("rope small insertions")
+{
+	const std::string first{ "Savvy?" };
+
+	rs_rope r;
+	rs_rope_init(&r);
+
+	std::string cmp;
+	std::srand(2);
+
+	for (int i = 0; i < 20000; i++) {
+		const auto index = std::rand() % (cmp.size() + 1);
+		const auto c = first[static_cast<std::size_t>(i) % first.size()];
+
+		rs_rope_insert_n(&r, index, &c, 1);
+		cmp.insert(index, 1, c);
+	}
+
+	VALIDATE_ROPE(&r, cmp);
+
+	/*
+	 * Leaves are only added once the leaf holding the index is full, so
+	 * they stay about half full instead of holding a character each.
+	 */
+	REQUIRE(count_leaves(r.root) <= 3 * (cmp.size() / RS_ROPE_LEAF + 1));
+
+	rs_rope_free(&r);
+}
+
+TEST_CASE("rope split")
+{
+	std::string cmp;
+
+	for (int i = 0; i < 3000; i++)
+		cmp += "Savvy? ";
+
+	rs_rope r1;
+	rs_rope r2;
+	rs_rope_init(&r1);
+	rs_rope_cat_n(&r1, cmp.data(), cmp.size());
+
+	for (std::size_t i = 0; i <= cmp.size(); i += 1237) {
+		rs_rope_split(&r1, i, &r2);
+
+		VALIDATE_ROPE(&r1, cmp.substr(0, i));
+		VALIDATE_ROPE(&r2, cmp.substr(i));
+
+		rs_rope_cat_rope(&r1, &r2);
+
+		REQUIRE(r2.root == nullptr);
+		VALIDATE_ROPE(&r1, cmp);
+	}
+
+	rapidstring s;
+	rs_init(&s);
+	rs_rope_substr(&r1, 1000, 5000, &s);
+
+	VALIDATE_RS(&s, cmp.substr(1000, 5000));
+
+	rs_rope_substr(&r1, cmp.size() - 3, 5000, &s);
+
+	VALIDATE_RS(&s, cmp.substr(cmp.size() - 3));
+
+	rs_free(&s);
+	rs_rope_free(&r1);
+}
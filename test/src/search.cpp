@@ -0,0 +1,103 @@
+#include "utility.hpp"
+#include <cstddef>
+
+/* Theme: Sherlock Holmes. */
+
+static std::size_t std_count(const std::string &s, const std::string &needle)
+{
+	std::size_t count{ 0 };
+
+	for (auto i = s.find(needle); i != std::string::npos;
+	     i = s.find(needle, i + needle.size()))
+		count++;
+
+	return count;
+}
+
+static void validate_search(const std::string &first,
+			    const std::string &needle)
+{
+	rapidstring s;
+	rs_init_w_n(&s, first.data(), first.size());
+
+	REQUIRE(rs_find_n(&s, needle.data(), needle.size()) ==
+		first.find(needle));
+	REQUIRE(rs_rfind_n(&s, needle.data(), needle.size()) ==
+		first.rfind(needle));
+
+	if (!needle.empty()) {
+		REQUIRE(rs_count_n(&s, needle.data(), needle.size()) ==
+			std_count(first, needle));
+		REQUIRE(rs_find_char(&s, needle[0]) == first.find(needle[0]));
+		REQUIRE(rs_rfind_char(&s, needle[0]) == first.rfind(needle[0]));
+		REQUIRE(rs_count_char(&s, needle[0]) ==
+			std_count(first, needle.substr(0, 1)));
+	}
+
+	rs_free(&s);
+}
+
+TEST_CASE("find stack")
+{
+	const std::string first{ "Elementary, my dear Watson." };
+
+	rapidstring s;
+	rs_init_w(&s, first.data());
+
+	REQUIRE(rs_find(&s, "my dear") == first.find("my dear"));
+	REQUIRE(rs_find(&s, "Watson.") == first.find("Watson."));
+	REQUIRE(rs_find(&s, "Moriarty") == RS_NPOS);
+	REQUIRE(rs_find(&s, "") == 0);
+	REQUIRE(rs_rfind(&s, "a") == first.rfind('a'));
+	REQUIRE(rs_find_char(&s, 'W') == first.find('W'));
+	REQUIRE(rs_find_char(&s, 'z') == RS_NPOS);
+	REQUIRE(rs_count(&s, "e") == 3);
+
+	rs_free(&s);
+}
+
+TEST_CASE("find heap")
+{
+	const std::string first{
+		"When you have eliminated the impossible, whatever remains, "
+		"however improbable, must be the truth."
+	};
+
+	rapidstring s, needle;
+	rs_init_w(&s, first.data());
+	rs_init_w(&needle, "improbable");
+
+	REQUIRE(rs_find_rs(&s, &needle) == first.find("improbable"));
+	REQUIRE(rs_rfind_rs(&s, &needle) == first.rfind("improbable"));
+	REQUIRE(rs_find(&s, "truth.") == first.find("truth."));
+	REQUIRE(rs_rfind(&s, "im") == first.rfind("im"));
+	REQUIRE(rs_rfind(&s, "") == first.size());
+	REQUIRE(rs_count(&s, "ever") == 2);
+	REQUIRE(rs_count_char(&s, 'e') == std_count(first, "e"));
+
+	rs_free(&needle);
+	rs_free(&s);
+}
+
+TEST_CASE("find every position")
+{
+	const std::string alphabet{ "abcab" };
+	std::string first;
+	unsigned int seed{ 42 };
+
+	for (int len = 0; len < 100; len++) {
+		for (int i = 0; i < 8; i++) {
+			std::string needle;
+
+			for (int j = 0; j < i; j++) {
+				seed = seed * 1103515245 + 12345;
+				needle += alphabet[(seed >> 16) % 5];
+			}
+
+			validate_search(first, needle);
+		}
+
+		seed = seed * 1103515245 + 12345;
+		first += alphabet[(seed >> 16) % 5];
+	}
+}
@@ -0,0 +1,220 @@
+/*
+ * Modifying a frozen string must never touch its shared buffer, including in
+ * release builds where no assertion catches it.
+ */
+#ifndef NDEBUG
+#define NDEBUG
+#endif
+
+#include "utility.hpp"
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+/* Theme: Star Trek. */
+
+TEST_CASE("freeze")
+{
+	const std::string first{ "Space: the final frontier. These are the "
+				 "voyages of the starship Enterprise." };
+
+	rapidstring s1;
+	rapidstring s2;
+	rapidstring s3;
+	rs_init_w(&s1, first.data());
+	rs_freeze(&s1);
+
+	REQUIRE(rs_is_shared(&s1));
+	REQUIRE(rs_shared_refs(&s1) == 1);
+	VALIDATE_RS(&s1, first);
+
+	rs_init_w_rs(&s2, &s1);
+	rs_init(&s3);
+	rs_cpy_rs(&s3, &s2);
+
+	REQUIRE(rs_shared_refs(&s1) == 3);
+	REQUIRE(rs_data_c(&s2) == rs_data_c(&s1));
+	REQUIRE(rs_data_c(&s3) == rs_data_c(&s1));
+	VALIDATE_RS(&s3, first);
+
+	rs_free(&s1);
+
+	REQUIRE(rs_shared_refs(&s2) == 2);
+	VALIDATE_RS(&s2, first);
+
+	rs_cpy_rs(&s2, &s2);
+
+	REQUIRE(rs_shared_refs(&s2) == 2);
+
+	rs_free(&s2);
+	rs_free(&s3);
+}
+
+TEST_CASE("freeze stack")
+{
+	const std::string first{ "Make it so." };
+
+	rapidstring s;
+	rs_init_w(&s, first.data());
+	rs_freeze(&s);
+
+	REQUIRE(!rs_is_shared(&s));
+	REQUIRE(rs_shared_refs(&s) == 1);
+	VALIDATE_RS(&s, first);
+
+	rs_free(&s);
+}
+
+TEST_CASE("thaw")
+{
+	const std::string first{ "Live long and prosper, said the Vulcan." };
+	const std::string second{ "Resistance is futile." };
+
+	rapidstring s1;
+	rapidstring s2;
+	rs_init_w(&s1, first.data());
+	rs_freeze(&s1);
+	rs_init_w_rs(&s2, &s1);
+	rs_thaw(&s2);
+
+	REQUIRE(!rs_is_shared(&s2));
+	REQUIRE(rs_shared_refs(&s1) == 1);
+	REQUIRE(rs_data_c(&s2) != rs_data_c(&s1));
+
+	rs_cat(&s2, second.data());
+
+	VALIDATE_RS(&s1, first);
+	VALIDATE_RS(&s2, first + second);
+
+	/* Overwriting a frozen string releases it. */
+	rs_cpy_rs(&s2, &s1);
+	rs_cpy(&s1, second.data());
+
+	REQUIRE(!rs_is_shared(&s1));
+	REQUIRE(rs_shared_refs(&s2) == 1);
+	VALIDATE_RS(&s1, second);
+	VALIDATE_RS(&s2, first);
+
+	rs_free(&s1);
+	rs_free(&s2);
+}
+
+TEST_CASE("modify frozen")
+{
+	const std::string first{ "Make it so. Engage. Tea, Earl Grey, hot. "
+				 "There are four lights!" };
+	const std::string second{ " Resistance is futile." };
+
+	rapidstring s;
+	rs_init_w(&s, first.data());
+	rs_freeze(&s);
+
+	for (int i = 0; i < 7; i++) {
+		rapidstring copy;
+		rs_init_w_rs(&copy, &s);
+		std::string cmp{ first };
+
+		REQUIRE(rs_shared_refs(&s) == 2);
+
+		switch (i) {
+		case 0:
+			rs_cat(&copy, second.data());
+			cmp += second;
+			break;
+		case 1:
+			rs_cat_n(&copy, "", 0);
+			break;
+		case 2:
+			rs_reserve(&copy, 1000);
+			break;
+		case 3:
+			rs_resize(&copy, 5);
+			cmp.resize(5);
+			break;
+		case 4:
+			rs_resize_w(&copy, 100, '!');
+			cmp.resize(100, '!');
+			break;
+		case 5:
+			rs_erase(&copy, 0, 12);
+			cmp.erase(0, 12);
+			break;
+		default:
+			rs_clear(&copy);
+			cmp.clear();
+			break;
+		}
+
+		REQUIRE(!rs_is_shared(&copy));
+		REQUIRE(rs_shared_refs(&s) == 1);
+		VALIDATE_RS(&copy, cmp);
+		VALIDATE_RS(&s, first);
+
+		rs_free(&copy);
+	}
+
+	rs_free(&s);
+}
+
+TEST_CASE("freeze allocator")
+{
+	const std::string first{ "Highly illogical, captain. Fascinating." };
+
+	counter c{};
+	const rs_allocator a{ count_alloc, nullptr, count_free, &c };
+
+	rapidstring s1;
+	rapidstring s2;
+	rs_init_w_alloc(&s1, &a);
+	rs_cpy(&s1, first.data());
+	rs_freeze(&s1);
+	rs_init_w_rs(&s2, &s1);
+
+	REQUIRE(rs_get_alloc(&s2) == &a);
+	REQUIRE(c.allocs - c.deallocs == 1);
+
+	rs_thaw(&s1);
+
+	REQUIRE(rs_get_alloc(&s1) == &a);
+	REQUIRE(c.allocs - c.deallocs == 2);
+	VALIDATE_RS(&s1, first);
+
+	rs_free(&s1);
+	rs_free(&s2);
+
+	REQUIRE(c.allocs - c.deallocs == 0);
+}
+
+TEST_CASE("freeze threads")
+{
+	const std::string first{ "Beam me up, Scotty. There's no intelligent "
+				 "life down here." };
+
+	rapidstring s;
+	rs_init_w(&s, first.data());
+	rs_freeze(&s);
+
+	std::vector<std::thread> threads;
+	std::vector<std::size_t> lengths(8);
+
+	for (std::size_t i = 0; i < lengths.size(); i++) {
+		threads.emplace_back([&s, &lengths, i] {
+			for (int j = 0; j < 10000; j++) {
+				rapidstring copy;
+				rs_init_w_rs(&copy, &s);
+				lengths[i] = rs_len(&copy);
+				rs_free(&copy);
+			}
+		});
+	}
+
+	for (auto &t : threads)
+		t.join();
+
+	for (auto len : lengths)
+		REQUIRE(len == first.size());
+
+	REQUIRE(rs_shared_refs(&s) == 1);
+
+	rs_free(&s);
+}
@@ -0,0 +1,150 @@
+#include "utility.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/* Theme: Friends. */
+
+static void test_sort(const std::vector<std::string> &input)
+{
+	std::vector<std::string> cmp{ input };
+	std::sort(cmp.begin(), cmp.end());
+
+	std::vector<rapidstring> strings(input.size());
+
+	for (std::size_t i = 0; i < input.size(); i++)
+		rs_init_w_n(&strings[i], input[i].data(), input[i].size());
+
+	rs_sort(strings.data(), strings.size());
+
+	/* VALIDATE_RS() stops at the null characters of some strings. */
+	for (std::size_t i = 0; i < input.size(); i++) {
+		const std::string str(rs_data_c(&strings[i]),
+				      rs_len(&strings[i]));
+
+		REQUIRE(str == cmp[i]);
+		rs_free(&strings[i]);
+	}
+}
+
+TEST_CASE("sort small")
+{
+	test_sort({});
+	test_sort({ "We were on a break!" });
+	test_sort({ "Pivot!", "Pivot!", "PIVOT!" });
+	test_sort({ "How you doin'?", "", "Could I BE", "Could I",
+		    "Could I BE any more sorted?", "" });
+	test_sort({ std::string("a\0b", 3), std::string("a\0", 2), "a",
+		    std::string("a\0\0", 3), "\xFF", "\x7F" });
+}
+
+TEST_CASE("sort prefixes")
+{
+	const std::string first{ "Smelly cat, smelly cat, what are they "
+				 "feeding you?" };
+	std::vector<std::string> input;
+
+	/* Every prefix, twice, with a few characters changed past depths. */
+	for (std::size_t i = 0; i <= first.size(); i++) {
+		input.push_back(first.substr(0, i));
+		input.push_back(first.substr(0, i));
+
+		std::string changed{ first };
+		changed[i % first.size()] = '~';
+		input.push_back(changed);
+	}
+
+	std::reverse(input.begin(), input.end());
+	test_sort(input);
+}
+
+TEST_CASE("sort random")
+{
+	std::vector<std::string> input;
+
+	std::srand(1);
+
+	for (int i = 0; i < 5000; i++) {
+		const auto len = static_cast<std::size_t>(std::rand()) % 40;
+		std::string str(len, 'a');
+
+		/* A small alphabet creates long common prefixes. */
+		for (auto &c : str)
+			c = static_cast<char>("\0ab\xE9"[std::rand() % 4]);
+
+		input.push_back(str);
+	}
+
+	test_sort(input);
+
+	std::sort(input.begin(), input.end());
+	test_sort(input);
+
+	std::reverse(input.begin(), input.end());
+	test_sort(input);
+}
+
+TEST_CASE("sort patterns")
+{
+	const std::size_t n = 20000;
+	std::vector<std::string> sorted;
+	std::vector<std::string> organ;
+	std::vector<std::string> equal(n, "The One Where Everybody Finds Out");
+
+	/* Numbers with a shared prefix, so the keys are deepened. */
+	for (std::size_t i = 0; i < n; i++) {
+		const auto k = i < n / 2 ? i : n - i;
+
+		sorted.push_back("Central Perk " + std::to_string(n + i));
+		organ.push_back("Central Perk " + std::to_string(n + k));
+	}
+
+	test_sort(sorted);
+	test_sort(organ);
+	test_sort(equal);
+
+	std::reverse(sorted.begin(), sorted.end());
+	test_sort(sorted);
+
+	std::reverse(organ.begin(), organ.end());
+	test_sort(organ);
+}
+
+TEST_CASE("sort heap")
+{
+	std::vector<std::string> input;
+
+	std::srand(2);
+
+	/* Long common prefixes are compared past the keys. */
+	for (int i = 0; i < 1000; i++) {
+		std::string str{ "Joey doesn't share food!" };
+
+		str.resize(static_cast<std::size_t>(std::rand()) % 30,
+			   "\0ab"[std::rand() % 3]);
+		input.push_back(str);
+	}
+
+	std::vector<std::string> cmp{ input };
+	std::sort(cmp.begin(), cmp.end());
+
+	std::vector<rapidstring> strings(input.size());
+	std::vector<rs_sort_entry> e(input.size());
+
+	for (std::size_t i = 0; i < input.size(); i++)
+		rs_init_w_n(&strings[i], input[i].data(), input[i].size());
+
+	rs_sort_fill(strings.data(), e.data(), 0, e.size());
+	rs_sort_heap(e.data(), e.size(), 0);
+	rs_sort_permute(strings.data(), e.data(), e.size());
+
+	for (std::size_t i = 0; i < input.size(); i++) {
+		const std::string str(rs_data_c(&strings[i]),
+				      rs_len(&strings[i]));
+
+		REQUIRE(str == cmp[i]);
+		rs_free(&strings[i]);
+	}
+}
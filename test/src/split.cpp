@@ -0,0 +1,180 @@
+#include "utility.hpp"
+#include <string>
+#include <vector>
+
+/* Theme: Indiana Jones. */
+
+static std::vector<std::string> collect(rs_split_iter *it)
+{
+	std::vector<std::string> fields;
+	rs_view field;
+
+	while (rs_split_next(it, &field))
+		fields.emplace_back(field.data, field.size);
+
+	return fields;
+}
+
+TEST_CASE("Character split")
+{
+	const std::string first{ "snakes,why,,did it have to be snakes," };
+
+	rapidstring s;
+	rs_init_w(&s, first.data());
+
+	rs_split_iter it;
+	rs_split_init_char(&it, &s, ',');
+
+	const std::vector<std::string> expected{ "snakes", "why", "",
+						 "did it have to be snakes",
+						 "" };
+	REQUIRE(collect(&it) == expected);
+
+	rs_view field;
+	REQUIRE(!rs_split_next(&it, &field));
+
+	rs_free(&s);
+}
+
+TEST_CASE("Split without copies")
+{
+	std::string first{ "It's not the years, honey, it's the mileage." };
+
+	for (int i = 0; i < 4; i++)
+		first += first;
+
+	rapidstring s;
+	rs_init_w_n(&s, first.data(), first.size());
+
+	rs_split_iter it;
+	rs_split_init_char(&it, &s, ' ');
+
+	std::vector<std::string> expected;
+	std::size_t start = 0;
+	std::size_t pos;
+
+	while ((pos = first.find(' ', start)) != std::string::npos) {
+		expected.push_back(first.substr(start, pos - start));
+		start = pos + 1;
+	}
+
+	expected.push_back(first.substr(start));
+
+	rs_view field;
+	std::size_t i = 0;
+
+	while (rs_split_next(&it, &field)) {
+		REQUIRE(field.data >= rs_data_c(&s));
+		REQUIRE(field.data + field.size <= rs_data_c(&s) + rs_len(&s));
+		REQUIRE(std::string(field.data, field.size) == expected[i++]);
+	}
+
+	REQUIRE(i == expected.size());
+
+	rs_free(&s);
+}
+
+TEST_CASE("Empty split")
+{
+	rapidstring s;
+	rs_init(&s);
+
+	rs_split_iter it;
+	rs_split_init_char(&it, &s, ',');
+
+	REQUIRE(collect(&it) == std::vector<std::string>{ "" });
+
+	rs_split_init_char(&it, &s, ',');
+	rs_split_skip_empty(&it);
+
+	REQUIRE(collect(&it).empty());
+
+	rs_free(&s);
+}
+
+TEST_CASE("Character set split")
+{
+	std::string first{ "X never, ever\tmarks the spot.\n" };
+
+	for (int i = 0; i < 3; i++)
+		first += first;
+
+	rapidstring s;
+	rs_init_w(&s, first.data());
+
+	rs_split_iter it;
+	rs_split_init_any(&it, &s, " ,\t\n");
+	rs_split_skip_empty(&it);
+
+	std::vector<std::string> expected;
+
+	for (int i = 0; i < 8; i++) {
+		expected.push_back("X");
+		expected.push_back("never");
+		expected.push_back("ever");
+		expected.push_back("marks");
+		expected.push_back("the");
+		expected.push_back("spot.");
+	}
+
+	REQUIRE(collect(&it) == expected);
+
+	rs_free(&s);
+}
+
+TEST_CASE("Separator split")
+{
+	const std::string first{ "Fortune<=>glory<=><=>kid<=" };
+
+	rapidstring s;
+	rs_init_w(&s, first.data());
+
+	rs_split_iter it;
+	rs_split_init(&it, &s, "<=>");
+
+	const std::vector<std::string> expected{ "Fortune", "glory", "",
+						 "kid<=" };
+	REQUIRE(collect(&it) == expected);
+
+	rs_free(&s);
+}
+
+TEST_CASE("Limited split")
+{
+	const std::string first{ "key=value=with=equals" };
+
+	rapidstring s;
+	rs_init_w(&s, first.data());
+
+	rs_split_iter it;
+	rs_split_init_char(&it, &s, '=');
+	rs_split_limit(&it, 2);
+
+	const std::vector<std::string> expected{ "key", "value=with=equals" };
+	REQUIRE(collect(&it) == expected);
+
+	rs_split_init_any(&it, &s, "=");
+	rs_split_limit(&it, 1);
+
+	REQUIRE(collect(&it) == std::vector<std::string>{ first });
+
+	rs_free(&s);
+}
+
+TEST_CASE("Limited split skipping empty fields")
+{
+	const std::string first{ "  Trust   me " };
+
+	rapidstring s;
+	rs_init_w(&s, first.data());
+
+	rs_split_iter it;
+	rs_split_init_char(&it, &s, ' ');
+	rs_split_skip_empty(&it);
+	rs_split_limit(&it, 2);
+
+	const std::vector<std::string> expected{ "Trust", "  me " };
+	REQUIRE(collect(&it) == expected);
+
+	rs_free(&s);
+}
@@ -0,0 +1,136 @@
+#include "utility.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/* Theme: The Simpsons. */
+
+static void validate_table(const rs_table *t,
+			   const std::vector<std::string> &cmp)
+{
+	REQUIRE(rs_table_size(t) == cmp.size());
+
+	const auto offsets = rs_table_offsets(t);
+	const auto data = rs_table_data(t);
+	std::size_t end = 0;
+
+	for (std::size_t i = 0; i < cmp.size(); i++) {
+		const rs_view v = rs_table_at(t, i);
+
+		REQUIRE(std::string(v.data, v.size) == cmp[i]);
+		REQUIRE(v.data == data + end);
+		end += cmp[i].size();
+	}
+
+	/* The offsets must match the layout of Arrow binary arrays. */
+	for (std::size_t i = 0, begin = 0; i <= cmp.size(); i++) {
+		const auto offset =
+			rs_table_is_large(t) ?
+				static_cast<std::size_t>(
+					static_cast<const std::int64_t *>(
+						offsets)[i]) :
+				static_cast<std::size_t>(
+					static_cast<const std::int32_t *>(
+						offsets)[i]);
+
+		REQUIRE(offset == begin);
+
+		if (i < cmp.size())
+			begin += cmp[i].size();
+	}
+
+	REQUIRE(rs_table_bytes(t) == end);
+}
+
+TEST_CASE("table push")
+{
+	const std::string first{ "D'oh!" };
+	const std::string second{ "Me fail English? That's unpossible." };
+
+	rs_table t;
+	rs_table_init(&t);
+	validate_table(&t, {});
+	REQUIRE(!rs_table_is_large(&t));
+
+	rapidstring s;
+	rs_init_w(&s, second.data());
+
+	rs_table_push(&t, first.data());
+	rs_table_push_n(&t, "", 0);
+	rs_table_push_rs(&t, &s);
+	rs_table_push_v(&t, rs_view_n("Excellent", 9));
+	validate_table(&t, { first, "", second, "Excellent" });
+
+	std::vector<std::string> cmp;
+
+	for (int i = 0; i < 1000; i++) {
+		cmp.push_back(std::to_string(i) + first);
+		rs_table_push(&t, cmp.back().data());
+	}
+
+	cmp.insert(cmp.begin(), { first, "", second, "Excellent" });
+	validate_table(&t, cmp);
+
+	rs_table_clear(&t);
+	validate_table(&t, {});
+	rs_table_push(&t, first.data());
+	validate_table(&t, { first });
+
+	rs_free(&s);
+	rs_table_free(&t);
+}
+
+TEST_CASE("table reserve")
+{
+	rs_table t;
+	rs_table_init(&t);
+
+	rs_table_reserve(&t, 100, 1400);
+	REQUIRE(t.capacity == 100);
+	REQUIRE(t.data_capacity == 1400);
+	validate_table(&t, {});
+
+	const auto data = rs_table_data(&t);
+	std::vector<std::string> cmp;
+
+	for (int i = 0; i < 100; i++) {
+		cmp.push_back("Mmm... donuts.");
+		rs_table_push(&t, "Mmm... donuts.");
+	}
+
+	validate_table(&t, cmp);
+	REQUIRE(rs_table_data(&t) == data);
+
+	rs_table_free(&t);
+}
+
+TEST_CASE("table large offsets")
+{
+	const std::vector<std::string> cmp{ "Eat my shorts.", "", "Ay, caramba!" };
+
+	rs_table t1;
+	rs_table_init_large(&t1);
+	REQUIRE(rs_table_is_large(&t1));
+
+	for (const auto &str : cmp)
+		rs_table_push_n(&t1, str.data(), str.size());
+
+	validate_table(&t1, cmp);
+
+	rs_table t2;
+	rs_table_init(&t2);
+
+	for (const auto &str : cmp)
+		rs_table_push_n(&t2, str.data(), str.size());
+
+	rs_table_widen(&t2);
+	REQUIRE(rs_table_is_large(&t2));
+	validate_table(&t2, cmp);
+
+	rs_table_push(&t2, "Cowabunga!");
+	validate_table(&t2, { cmp[0], cmp[1], cmp[2], "Cowabunga!" });
+
+	rs_table_free(&t1);
+	rs_table_free(&t2);
+}
@@ -0,0 +1,185 @@
+#include "utility.hpp"
+#include <cstddef>
+
+/* Theme: Toy Story. */
+
+static std::string trim(const std::string &str, const std::string &set)
+{
+	const auto first = str.find_first_not_of(set);
+
+	if (first == std::string::npos)
+		return std::string{};
+
+	return str.substr(first, str.find_last_not_of(set) - first + 1);
+}
+
+TEST_CASE("trim stack")
+{
+	const std::string first{ " \t To infinity and beyond!\r\n" };
+
+	rapidstring s;
+	rs_init_w(&s, first.data());
+
+	rs_rtrim(&s, RS_WHITESPACE);
+	VALIDATE_RS(&s, std::string{ " \t To infinity and beyond!" });
+
+	rs_ltrim(&s, RS_WHITESPACE);
+	VALIDATE_RS(&s, std::string{ "To infinity and beyond!" });
+
+	rs_trim(&s, "T!");
+	VALIDATE_RS(&s, std::string{ "o infinity and beyond" });
+
+	rs_trim(&s, "");
+	VALIDATE_RS(&s, std::string{ "o infinity and beyond" });
+
+	rs_trim(&s, "abdefinoty ");
+	VALIDATE_RS(&s, std::string{});
+
+	rs_free(&s);
+}
+
+TEST_CASE("trim heap")
+{
+	const std::string first{
+		"\n\n   There's a snake in my boot! Reach for the sky!   \n"
+	};
+
+	rapidstring s;
+	rs_init_w(&s, first.data());
+
+	const auto *data = rs_data_c(&s);
+
+	rs_trim(&s, RS_WHITESPACE);
+	VALIDATE_RS(&s, trim(first, RS_WHITESPACE));
+
+	/* The characters were not moved. */
+	REQUIRE(rs_data_c(&s) == data + 5);
+
+	rs_ltrim(&s, "Theres' ");
+	VALIDATE_RS(&s, std::string{ "a snake in my boot! Reach for the sky!" });
+
+	rs_cat(&s, " You are a toy!");
+	VALIDATE_RS(&s, std::string{ "a snake in my boot! Reach for the sky! "
+				     "You are a toy!" });
+
+	rs_free(&s);
+}
+
+TEST_CASE("trim lengths")
+{
+	const std::string set{ " .-" };
+
+	for (std::size_t i = 0; i < 100; i++) {
+		for (std::size_t j = 0; j < 100; j += 7) {
+			const auto first = std::string(i, '.') + "Woody" +
+					   std::string(j, '-') + "Buzz" +
+					   std::string(i + j, ' ');
+
+			rapidstring s;
+			rs_init_w_n(&s, first.data(), first.size());
+
+			rs_trim_n(&s, set.data(), set.size());
+			VALIDATE_RS(&s, trim(first, set));
+
+			const auto v = rs_view_trim_n(
+				rs_view_n(first.data(), first.size()),
+				set.data(), set.size());
+
+			REQUIRE(std::string(v.data, v.size) == trim(first, set));
+
+			rs_free(&s);
+		}
+	}
+}
+
+TEST_CASE("left trim offsets")
+{
+	std::string first;
+
+	for (std::size_t i = 0; i < 1000; i++)
+		first.push_back(static_cast<char>('a' + i % 26));
+
+	rapidstring s;
+	rs_init_w_n(&s, first.data(), first.size());
+
+	/* Offsets needing one, two and three groups of seven bits. */
+	const std::size_t steps[]{ 1, 126, 127, 128, 900 };
+	std::string expected = first;
+
+	for (const auto step : steps) {
+		for (std::size_t i = 0; i < step && !expected.empty(); i++) {
+			rs_ltrim_n(&s, expected.data(), 1);
+			expected.erase(0, 1);
+
+			VALIDATE_RS(&s, expected);
+		}
+	}
+
+	rs_shrink_to_fit(&s);
+	VALIDATE_RS(&s, expected);
+
+	/* Copies reuse the characters dropped by the left trims. */
+	rs_cpy_n(&s, first.data(), first.size());
+	rs_ltrim(&s, "a");
+	VALIDATE_RS(&s, first.substr(1));
+
+	rs_cpy_n(&s, first.data(), first.size());
+	VALIDATE_RS(&s, first);
+
+	rs_free(&s);
+}
+
+TEST_CASE("left trim allocator")
+{
+	const std::string first{ "   Buzz Lightyear to Star Command.   " };
+	counter c{};
+	const rs_allocator a{ count_alloc, count_realloc, count_free, &c };
+
+	for (std::size_t i = 0; i < 4; i++) {
+		rapidstring s;
+		rs_init_w_cap_alloc(&s, 100, &a);
+		rs_cpy(&s, first.data());
+
+		rs_trim(&s, RS_WHITESPACE);
+		VALIDATE_RS(&s, trim(first, RS_WHITESPACE));
+		REQUIRE(rs_get_alloc(&s) == &a);
+
+		/* Growing, shrinking, freezing or simply freeing the string. */
+		if (i == 1) {
+			rs_reserve(&s, 1000);
+			VALIDATE_RS(&s, trim(first, RS_WHITESPACE));
+		} else if (i == 2) {
+			rs_shrink_to_fit(&s);
+			VALIDATE_RS(&s, trim(first, RS_WHITESPACE));
+		} else if (i == 3) {
+			rs_freeze(&s);
+			VALIDATE_RS(&s, trim(first, RS_WHITESPACE));
+			REQUIRE(rs_get_alloc(&s) == &a);
+		}
+
+		rs_free(&s);
+		REQUIRE(c.bytes == 0);
+	}
+}
+
+TEST_CASE("trim shared")
+{
+	const std::string first{ "  You've got a friend in me  " };
+
+	rapidstring s1;
+	rapidstring s2;
+	rs_init_w(&s1, first.data());
+	rs_freeze(&s1);
+	rs_init_w_rs(&s2, &s1);
+
+	rs_trim(&s2, RS_WHITESPACE);
+
+	VALIDATE_RS(&s1, first);
+	VALIDATE_RS(&s2, trim(first, RS_WHITESPACE));
+
+	rs_ltrim(&s1, " Y");
+	VALIDATE_RS(&s1, first.substr(3));
+
+	rs_free(&s1);
+	rs_free(&s2);
+}
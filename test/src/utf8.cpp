@@ -0,0 +1,214 @@
+#include "utility.hpp"
+#include <cstddef>
+
+/* Theme: Doctor Who. */
+
+/* Byte at a time reference of RFC 3629. */
+static bool valid(const std::string &str)
+{
+	const auto *p = reinterpret_cast<const unsigned char *>(str.data());
+	std::size_t i = 0;
+
+	while (i < str.size()) {
+		const auto c = p[i];
+		std::size_t n;
+		unsigned char low = 0x80;
+		unsigned char high = 0xBF;
+
+		if (c < 0x80) {
+			i++;
+			continue;
+		} else if (c >= 0xC2 && c <= 0xDF) {
+			n = 1;
+		} else if (c >= 0xE0 && c <= 0xEF) {
+			n = 2;
+			low = c == 0xE0 ? 0xA0 : low;
+			high = c == 0xED ? 0x9F : high;
+		} else if (c >= 0xF0 && c <= 0xF4) {
+			n = 3;
+			low = c == 0xF0 ? 0x90 : low;
+			high = c == 0xF4 ? 0x8F : high;
+		} else {
+			return false;
+		}
+
+		if (str.size() - i <= n || p[i + 1] < low || p[i + 1] > high)
+			return false;
+
+		for (std::size_t j = 2; j <= n; j++)
+			if ((p[i + j] & 0xC0) != 0x80)
+				return false;
+
+		i += n + 1;
+	}
+
+	return true;
+}
+
+static std::size_t code_points(const std::string &str)
+{
+	std::size_t count = 0;
+
+	for (const auto c : str)
+		count += (static_cast<unsigned char>(c) & 0xC0) != 0x80;
+
+	return count;
+}
+
+static bool ascii(const std::string &str)
+{
+	for (const auto c : str)
+		if (static_cast<unsigned char>(c) >= 0x80)
+			return false;
+
+	return true;
+}
+
+static void validate_utf8(const std::string &str)
+{
+	rapidstring s;
+	rs_init_w_n(&s, str.data(), str.size());
+
+	REQUIRE(rs_utf8_valid_n(str.data(), str.size()) == valid(str));
+	REQUIRE(rs_utf8_valid(&s) == valid(str));
+	REQUIRE(rs_utf8_validate(&s) == valid(str));
+	REQUIRE(rs_utf8_valid(&s) == valid(str));
+	REQUIRE(rs_utf8_len(&s) == code_points(str));
+	REQUIRE(rs_utf8_len_n(str.data(), str.size()) == code_points(str));
+	REQUIRE(rs_is_ascii(&s) == ascii(str));
+	REQUIRE(rs_is_ascii_n(str.data(), str.size()) == ascii(str));
+
+	rs_free(&s);
+}
+
+TEST_CASE("UTF-8 valid")
+{
+	const std::string first{ "Allons-y! Geronimo! \xE2\x80\x94 Fantastic!" };
+	const std::string second{ "Ex\xC3\xA9terminate \xF0\x9F\x91\xBD" };
+
+	rapidstring s;
+	rs_init_w(&s, first.data());
+
+	REQUIRE(rs_utf8_valid(&s));
+	REQUIRE(rs_utf8_len(&s) == first.size() - 2);
+	REQUIRE(!rs_is_ascii(&s));
+
+	rs_cpy(&s, second.data());
+
+	REQUIRE(rs_utf8_valid(&s));
+	REQUIRE(rs_utf8_len(&s) == 14);
+	REQUIRE(rs_utf8_valid_v(rs_view_rs(&s)));
+
+	rs_cpy(&s, "Bow ties are cool.");
+
+	REQUIRE(rs_utf8_valid(&s));
+	REQUIRE(rs_is_ascii(&s));
+
+	rs_free(&s);
+}
+
+TEST_CASE("UTF-8 invalid")
+{
+	const char *const invalid[]{
+		"\x80",		/* Lone continuation. */
+		"\xC0\x80",	/* Overlong null. */
+		"\xC1\xBF",	/* Overlong ASCII. */
+		"\xE0\x9F\xBF", /* Overlong three characters. */
+		"\xED\xA0\x80", /* Surrogate. */
+		"\xF0\x8F\xBF\xBF", /* Overlong four characters. */
+		"\xF4\x90\x80\x80", /* Past U+10FFFF. */
+		"\xF5\x80\x80\x80", /* Invalid lead. */
+		"\xFF",		/* Invalid lead. */
+		"\xE2\x82",	/* Cut sequence. */
+		"\xC3",		/* Cut sequence. */
+		"\xC3\xA9\xA9", /* Extra continuation. */
+	};
+
+	for (const auto *input : invalid) {
+		const std::string str{ input };
+
+		REQUIRE(!valid(str));
+		REQUIRE(!rs_utf8_valid_n(str.data(), str.size()));
+
+		/* At every offset, within stack and heap strings. */
+		for (std::size_t i = 0; i < 150; i++) {
+			validate_utf8(std::string(i, 'T') + str);
+			validate_utf8(std::string(i, 'T') + str +
+				      std::string(70, 'D'));
+		}
+	}
+}
+
+TEST_CASE("UTF-8 sequences")
+{
+	/* Every pair of characters, after a run of ASCII. */
+	for (std::size_t i = 0; i < 256; i++) {
+		for (std::size_t j = 0; j < 256; j++) {
+			std::string str(61, 'W');
+			str.push_back(static_cast<char>(i));
+			str.push_back(static_cast<char>(j));
+
+			REQUIRE(rs_utf8_valid_n(str.data(), str.size()) ==
+				valid(str));
+
+			str.append(3, static_cast<char>(0xBF));
+			str.append(64, 'H');
+
+			REQUIRE(rs_utf8_valid_n(str.data(), str.size()) ==
+				valid(str));
+		}
+	}
+}
+
+TEST_CASE("UTF-8 lengths")
+{
+	const std::string pieces[]{ "Tardis", "\xC3\xA9", "\xE2\x80\x94",
+				    "\xF0\x9F\x91\xBD", "\xE2\x80", "\xBF" };
+	std::string str;
+
+	for (std::size_t i = 0; i < 300; i++) {
+		str += pieces[(i * 7) % 6];
+		validate_utf8(str);
+	}
+}
+
+TEST_CASE("UTF-8 empty")
+{
+	REQUIRE(rs_utf8_valid_n(NULL, 0));
+	REQUIRE(rs_utf8_len_n(NULL, 0) == 0);
+	REQUIRE(rs_is_ascii_n(NULL, 0));
+}
+
+TEST_CASE("UTF-8 cached")
+{
+	const std::string first{
+		"The angels have the phone box \xE2\x80\x94 don't blink."
+	};
+
+	rapidstring s;
+	rs_init_w(&s, first.data());
+
+	REQUIRE(rs_utf8_valid(&s));
+	REQUIRE(rs_utf8_validate(&s));
+	REQUIRE(rs_utf8_valid(&s));
+
+	rs_cat(&s, "\xE2");
+	REQUIRE(!rs_utf8_validate(&s));
+
+	rs_cat(&s, "\x80\x94");
+	REQUIRE(rs_utf8_validate(&s));
+
+	rs_data(&s)[0] = '\xFF';
+	rs_utf8_forget(&s);
+	REQUIRE(!rs_utf8_valid(&s));
+	REQUIRE(!rs_utf8_validate(&s));
+
+	rs_data(&s)[0] = 'T';
+	rs_utf8_forget(&s);
+	REQUIRE(rs_utf8_validate(&s));
+
+	rs_erase(&s, first.find('\xE2'), 1);
+	REQUIRE(!rs_utf8_valid(&s));
+
+	rs_free(&s);
+}
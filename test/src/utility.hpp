@@ -3,6 +3,8 @@
 
 #include "rapidstring.h"
 #include <catch.hpp>
+#include <cstddef>
+#include <cstdlib>
 #include <string>
 
 #define VALIDATE_RS(s, cmp)                                      \
@@ -18,4 +20,39 @@
 			REQUIRE(rs_cap(s) == RS_STACK_CAPACITY); \
 	} while (0)
 
+/* Allocation counts of an rs_allocator built from the functions below. */
+struct counter {
+	std::size_t allocs;
+	std::size_t reallocs;
+	std::size_t deallocs;
+	std::size_t bytes;
+};
+
+inline void *count_alloc(void *ctx, std::size_t n)
+{
+	auto c = static_cast<counter *>(ctx);
+	c->allocs++;
+	c->bytes += n;
+
+	return std::malloc(n);
+}
+
+inline void *count_realloc(void *ctx, void *p, std::size_t old_n, std::size_t n)
+{
+	auto c = static_cast<counter *>(ctx);
+	c->reallocs++;
+	c->bytes += n - old_n;
+
+	return std::realloc(p, n);
+}
+
+inline void count_free(void *ctx, void *p, std::size_t n)
+{
+	auto c = static_cast<counter *>(ctx);
+	c->deallocs++;
+	c->bytes -= n;
+
+	std::free(p);
+}
+
 #endif /* !UTILITY_HPP_ECB97D42D011D625 */
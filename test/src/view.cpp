@@ -0,0 +1,93 @@
+#include "utility.hpp"
+#include <cstddef>
+
+/* Theme: The Godfather. */
+
+static std::string to_string(rs_view v)
+{
+	return std::string(v.data, v.size);
+}
+
+TEST_CASE("view")
+{
+	const std::string first{ "I'm gonna make him an offer he can't refuse." };
+	const std::string second{ "Leave the gun." };
+
+	rapidstring s1;
+	rapidstring s2;
+	rs_init_w(&s1, first.data());
+	rs_init_w(&s2, second.data());
+
+	REQUIRE(to_string(rs_view_rs(&s1)) == first);
+	REQUIRE(to_string(rs_view_rs(&s2)) == second);
+	REQUIRE(rs_view_rs(&s1).data == rs_data_c(&s1));
+	REQUIRE(rs_view_rs(&s2).data == rs_data_c(&s2));
+	REQUIRE(to_string(rs_view_n(first.data(), 3)) == "I'm");
+
+	rs_free(&s1);
+	rs_free(&s2);
+}
+
+TEST_CASE("substring view")
+{
+	const std::string first{ "Keep your friends close, but your enemies "
+				 "closer." };
+
+	rapidstring s;
+	rs_init_w(&s, first.data());
+
+	for (std::size_t i = 0; i <= first.size(); i++) {
+		REQUIRE(to_string(rs_substr_view(&s, i, 6)) ==
+			first.substr(i, 6));
+		REQUIRE(to_string(rs_substr_view(&s, i, RS_NPOS)) ==
+			first.substr(i));
+	}
+
+	const auto v = rs_substr_view(&s, 5, 12);
+
+	REQUIRE(to_string(rs_view_substr(v, 5, 3)) == first.substr(10, 3));
+	REQUIRE(to_string(rs_view_substr(v, 12, 3)).empty());
+
+	rs_free(&s);
+}
+
+TEST_CASE("view functions")
+{
+	const std::string first{ "A man who doesn't spend time with his "
+				 "family can never be a real man." };
+
+	rapidstring s1;
+	rapidstring s2;
+	rs_init_w(&s1, first.data());
+
+	const auto v = rs_substr_view(&s1, 2, 3);
+
+	rs_init_w_v(&s2, v);
+	VALIDATE_RS(&s2, std::string{ "man" });
+
+	rs_cat_v(&s2, rs_substr_view(&s1, 5, 4));
+	VALIDATE_RS(&s2, std::string{ "man who" });
+
+	rs_cpy_v(&s2, rs_substr_view(&s1, 38, RS_NPOS));
+	VALIDATE_RS(&s2, first.substr(38));
+
+	REQUIRE(rs_find_v(&s1, v) == 2);
+	REQUIRE(rs_rfind_v(&s1, v) == first.rfind("man"));
+	REQUIRE(rs_count_v(&s1, v) == 2);
+	REQUIRE(rs_cmp_v(&s2, rs_view_rs(&s2)) == 0);
+	REQUIRE(rs_cmp_v(&s2, v) < 0);
+	REQUIRE(rs_eq_v(&s2, rs_substr_view(&s1, 38, RS_NPOS)));
+	REQUIRE(!rs_eq_v(&s2, v));
+	REQUIRE(rs_starts_with_v(&s1, rs_view_n("A man", 5)));
+	REQUIRE(rs_ends_with_v(&s1, rs_substr_view(&s2, 20, RS_NPOS)));
+	REQUIRE(rs_hash_v(v) == rs_hash_n("man", 3));
+
+	rs_intern_table t;
+	rs_intern_init(&t);
+
+	REQUIRE(rs_intern_v(&t, v) == rs_intern(&t, "man"));
+
+	rs_intern_free(&t);
+	rs_free(&s1);
+	rs_free(&s2);
+}